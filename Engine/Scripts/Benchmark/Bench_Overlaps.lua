@@ -0,0 +1,88 @@
+-- Spawns increasing numbers of overlapping Box3D / Sphere3D nodes and logs
+-- the average "Collisions" frame stat for each count. Attach to any node in
+-- an otherwise empty scene and press play.
+
+Bench_Overlaps = {}
+
+function Bench_Overlaps:Create()
+
+    self.counts = { 250, 500, 1000, 2000, 4000, 8000 }
+    self.stageDuration = 4.0
+    self.warmupDuration = 1.0
+    self.density = 0.5
+
+end
+
+function Bench_Overlaps:Start()
+
+    Math.SeedRand(1337)
+    self:GetWorld():SetGravity(Vec(0, 0, 0))
+    self.stage = 0
+    self:BeginStage(1)
+
+end
+
+function Bench_Overlaps:BeginStage(stage)
+
+    if (self.container) then
+        self.container:DestroyDeferred()
+        self.container = nil
+    end
+
+    self.stage = stage
+    self.stageTime = 0.0
+    self.statTotal = 0.0
+    self.statFrames = 0
+
+    local count = self.counts[stage]
+    if (not count) then
+        Log.Debug("Bench_Overlaps: Finished")
+        return
+    end
+
+    self.container = Node.Construct("Node")
+    self:AddChild(self.container)
+
+    -- Scale the spawn volume with the count so the overlaps per node stay roughly constant.
+    local halfSize = ((count / self.density) ^ (1.0 / 3.0)) * 0.5
+    local minPos = Vec(-halfSize, -halfSize, -halfSize)
+    local maxPos = Vec(halfSize, halfSize, halfSize)
+
+    for i = 1, count do
+        local className = (i % 2 == 0) and "Box3D" or "Sphere3D"
+        local prim = Node.Construct(className)
+        prim:EnablePhysics(true)
+        prim:EnableCollision(false)
+        prim:EnableOverlaps(true)
+        prim:SetLinearDamping(0.0)
+        prim:SetPosition(Math.RandRangeVec(minPos, maxPos))
+        self.container:AddChild(prim)
+
+        -- Keep the bodies moving slowly so they never go to sleep and overlaps begin/end.
+        prim:SetLinearVelocity(Math.RandRangeVec(Vec(-0.5, -0.5, -0.5), Vec(0.5, 0.5, 0.5)))
+    end
+
+end
+
+function Bench_Overlaps:Tick(deltaTime)
+
+    local count = self.counts[self.stage]
+    if (not count) then
+        return
+    end
+
+    self.stageTime = self.stageTime + deltaTime
+
+    if (self.stageTime >= self.warmupDuration) then
+        local time = Engine.GetFrameStat("Collisions")
+        self.statTotal = self.statTotal + time
+        self.statFrames = self.statFrames + 1
+    end
+
+    if (self.stageTime >= self.stageDuration) then
+        local avg = (self.statFrames > 0) and (self.statTotal / self.statFrames) or 0.0
+        Log.Debug(string.format("Bench_Overlaps: N = %d, Collisions = %.3f ms", count, avg))
+        self:BeginStage(self.stage + 1)
+    end
+
+end
@@ -0,0 +1,64 @@
+-- Measures signal emission throughput (emits per second) with no listeners,
+-- one listener and several listeners. Attach to any node and press play.
+-- Run it on two builds to compare before/after numbers.
+
+Bench_Signals = {}
+
+function Bench_Signals:Create()
+
+    self.numEmits = 200000
+    self.listenerCounts = { 0, 1, 4 }
+    self.numReceived = 0
+
+end
+
+function Bench_Signals:Start()
+
+    for i = 1, #self.listenerCounts do
+        self:RunStage(self.listenerCounts[i])
+    end
+
+    Log.Debug("Bench_Signals: Finished")
+
+end
+
+function Bench_Signals:OnBenchSignal(value)
+
+    self.numReceived = self.numReceived + 1
+
+end
+
+function Bench_Signals:RunStage(numListeners)
+
+    local emitter = Node.Construct("Node")
+    self:AddChild(emitter)
+
+    local listeners = {}
+    for i = 1, numListeners do
+        local listener = Node.Construct("Node")
+        self:AddChild(listener)
+        emitter:ConnectSignal("BenchSignal", listener, function(node, value) self:OnBenchSignal(value) end)
+        listeners[i] = listener
+    end
+
+    self.numReceived = 0
+
+    local startTime = os.clock()
+
+    for i = 1, self.numEmits do
+        emitter:EmitSignal("BenchSignal", i)
+    end
+
+    local elapsed = os.clock() - startTime
+    local emitsPerSec = (elapsed > 0.0) and (self.numEmits / elapsed) or 0.0
+
+    Log.Debug(string.format("Bench_Signals: Listeners = %d, Emits = %d, Received = %d, %.3f ms, %.0f emits/sec",
+        numListeners, self.numEmits, self.numReceived, elapsed * 1000.0, emitsPerSec))
+
+    for i = 1, #listeners do
+        listeners[i]:Destroy()
+    end
+
+    emitter:Destroy()
+
+end
@@ -269,8 +269,13 @@ void ActionManager::BuildData(Platform platform, bool embedded)
 
     // (3) Generate .cpp / .h files (empty if not embedded) using the .oct files in the Packaged folder.
     // (4) Create and save an asset registry file with simple list of asset paths into Packaged folder.
+    // (5) Pack the cooked assets into a single archive that gets memory mapped at runtime. Only done for
+    //     platforms that can map files, the others would have to hold the whole archive in memory.
     std::unordered_map<std::string, AssetStub*>& assetMap = AssetManager::Get()->GetAssetMap();
     FILE* registryFile = nullptr;
+    bool useArchive = !embedded &&
+        (platform == Platform::Windows || platform == Platform::Linux || platform == Platform::Android);
+    std::vector<std::pair<std::string, std::string> > archiveFiles;
 
     std::string registryFileName = packagedDir + projectName + "/AssetRegistry.txt";
     registryFile = fopen(registryFileName.c_str(), "w");
@@ -296,6 +301,11 @@ void ActionManager::BuildData(Platform platform, bool embedded)
             }
 
             fprintf(registryFile, "%s,%s\n", regType, regPath.c_str());
+
+            if (useArchive)
+            {
+                archiveFiles.push_back({ regPath, packagedDir + regPath });
+            }
         }
     }
 
@@ -305,6 +315,16 @@ void ActionManager::BuildData(Platform platform, bool embedded)
         registryFile = nullptr;
     }
 
+    if (useArchive)
+    {
+        // The loose .oct files are still packaged so UseAssetArchive=0 can be used to compare against them.
+        std::string archiveFileName = packagedDir + projectName + "/" + ASSET_ARCHIVE_FILE_NAME;
+        if (!AssetArchive::Write(archiveFileName.c_str(), archiveFiles))
+        {
+            LogError("Failed to write asset archive: %s", archiveFileName.c_str());
+        }
+    }
+
     // Create a Generated folder inside the project folder if it doesn't exist
     if (!DoesDirExist((projectDir + "Generated").c_str()))
     {
@@ -2831,7 +2851,7 @@ void ActionManager::ResaveAllAssets()
     }
 
     // Refsweep afterwards to 
-    AssetManager::Get()->RefSweep();
+    AssetManager::Get()->RefSweep(true);
 }
 
 void ActionManager::DeleteAsset(AssetStub* stub)
@@ -71,7 +71,11 @@ Asset::Asset()
 
 Asset::~Asset()
 {
-
+    // mSweepQueued is guarded by the sweep lock, so let the manager check it.
+    if (AssetManager::Get() != nullptr)
+    {
+        AssetManager::Get()->RemoveSweepCandidate(this);
+    }
 }
 
 void Asset::Create()
@@ -163,13 +167,19 @@ void Asset::IncrementRefCount()
     //    Load();
     //}
 
-    mRefCount++;
+    mRefCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void Asset::DecrementRefCount()
 {
-    mRefCount--;
-    OCT_ASSERT(mRefCount >= 0 || AssetManager::Get()->IsPurging());
+    // Only the thread that drops the count to zero queues the asset.
+    int32_t refCount = mRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    OCT_ASSERT(refCount >= 0 || AssetManager::Get()->IsPurging());
+
+    if (refCount == 0 && AssetManager::Get() != nullptr)
+    {
+        AssetManager::Get()->QueueSweepCandidate(this);
+    }
 }
 
 void Asset::LoadFile(const char* path, AsyncLoadRequest* request)
@@ -179,7 +189,13 @@ void Asset::LoadFile(const char* path, AsyncLoadRequest* request)
 
     Stream stream;
     stream.SetAsyncRequest(request);
-    stream.ReadFile(path, true);
+
+    // Packaged builds read straight out of the mapped asset archive when there is one.
+    if (!AssetManager::Get()->GetArchivedAssetData(path, stream))
+    {
+        stream.ReadFile(path, true);
+    }
+
     LoadStream(stream, GetPlatform());
 
     // Only "finish" the load if not async.
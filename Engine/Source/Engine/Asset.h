@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <atomic>
 
 class Stream;
 class Property;
@@ -32,9 +33,15 @@ class AssetDir;
 #define ASSET_VERSION_SCENE_SUBSCENE_INSTANCE_COLORS 11
 #define ASSET_VERSION_UUID_SUPPORT 12
 #define ASSET_VERSION_UUID_WITH_NAME_FALLBACK 13
-#define ASSET_VERSION_CURRENT 13
+#define ASSET_VERSION_ALIGNED_BULK_DATA 14
+#define ASSET_VERSION_SKELETAL_MESH_BAKE_RATE 15
+#define ASSET_VERSION_CURRENT 15
 // ----------------------------------------------------
 
+// Large contiguous blobs (vertices, indices, pixels) start at a multiple of this
+// offset in the asset stream, so they can be copied (or mapped) with natural alignment.
+#define ASSET_BULK_DATA_ALIGNMENT 16
+
 #define DECLARE_ASSET(Base, Parent) DECLARE_FACTORY(Base, Asset); DECLARE_OBJECT(Base, Parent);
 #define DEFINE_ASSET(Base) DEFINE_FACTORY(Base, Asset); DEFINE_OBJECT(Base);
 
@@ -156,7 +163,14 @@ protected:
     bool mTransient = false;
 
     std::string mName = "Asset";
-    int32_t mRefCount = 0;
+    // Atomic because loader threads assign AssetRefs to shared dependencies concurrently.
+    std::atomic<int32_t> mRefCount { 0 };
+
+    // Bookkeeping for the AssetManager's sweep queue.
+    friend class AssetManager;
+    bool mSweepQueued = false;
+    uint64_t mSweepSlot = 0;
+    float mUnreferencedTime = 0.0f;
 
 #if EDITOR
 public:
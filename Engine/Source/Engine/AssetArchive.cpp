@@ -0,0 +1,324 @@
+#include "AssetArchive.h"
+#include "Asset.h"
+#include "Stream.h"
+#include "Utilities.h"
+#include "Log.h"
+
+#include "System/System.h"
+
+static const uint32_t kArchiveHeaderSize = sizeof(uint32_t) * 5;
+
+static uint32_t GetNumSlots(uint32_t numEntries)
+{
+    // Keep the tables at most half full so probe chains stay short.
+    uint32_t numSlots = 1;
+    while (numSlots < numEntries * 2)
+    {
+        numSlots <<= 1;
+    }
+
+    return numSlots;
+}
+
+AssetArchive::~AssetArchive()
+{
+    Close();
+}
+
+bool AssetArchive::Open(const char* path, bool isAsset)
+{
+    Close();
+
+    if (!SYS_MapFile(path, isAsset, mFile))
+    {
+        return false;
+    }
+
+    Stream stream;
+    stream.SetExternalData(mFile.mData, mFile.mSize);
+
+    bool valid = (mFile.mSize >= kArchiveHeaderSize);
+    uint32_t magic = valid ? stream.ReadUint32() : 0;
+    uint32_t version = valid ? stream.ReadUint32() : 0;
+
+    if (magic != ASSET_ARCHIVE_MAGIC_NUMBER ||
+        version != ASSET_ARCHIVE_VERSION)
+    {
+        LogError("Invalid asset archive: %s", path);
+        Close();
+        return false;
+    }
+
+    uint32_t numEntries = stream.ReadUint32();
+    uint32_t numSlots = stream.ReadUint32();
+    uint32_t tocOffset = stream.ReadUint32();
+
+    if (tocOffset > mFile.mSize ||
+        numSlots != GetNumSlots(numEntries))
+    {
+        LogError("Corrupt asset archive table of contents: %s", path);
+        Close();
+        return false;
+    }
+
+    stream.SetPos(tocOffset);
+
+    // A truncated or corrupt archive must not send reads past the end of the mapping.
+    auto hasBytes = [&](uint64_t numBytes) -> bool
+    {
+        return (uint64_t(stream.GetPos()) + numBytes <= uint64_t(mFile.mSize));
+    };
+
+    const uint32_t kEntryFixedSize = sizeof(uint64_t) + sizeof(uint32_t) * 4;
+    bool tocValid = true;
+
+    mEntries.resize(numEntries);
+    for (uint32_t i = 0; i < numEntries && tocValid; ++i)
+    {
+        AssetArchiveEntry& entry = mEntries[i];
+
+        if (!hasBytes(kEntryFixedSize))
+        {
+            tocValid = false;
+            break;
+        }
+
+        entry.mUuid = stream.ReadUint64();
+        entry.mType = stream.ReadUint32();
+        entry.mOffset = stream.ReadUint32();
+        entry.mSize = stream.ReadUint32();
+
+        // The string length was included in kEntryFixedSize, peek it before reading.
+        uint32_t pathPos = stream.GetPos();
+        uint32_t pathLength = stream.ReadUint32();
+        stream.SetPos(pathPos);
+
+        // Asset data sits between the header and the table of contents.
+        tocValid = hasBytes(uint64_t(pathLength) + sizeof(uint32_t)) &&
+            entry.mOffset >= kArchiveHeaderSize &&
+            uint64_t(entry.mOffset) + uint64_t(entry.mSize) <= uint64_t(tocOffset);
+
+        if (tocValid)
+        {
+            stream.ReadString(entry.mPath);
+        }
+    }
+
+    tocValid = tocValid && hasBytes(uint64_t(numSlots) * sizeof(uint32_t) * 2);
+
+    if (!tocValid)
+    {
+        LogError("Corrupt asset archive entry: %s", path);
+        Close();
+        return false;
+    }
+
+    mPathSlots.resize(numSlots);
+    mUuidSlots.resize(numSlots);
+
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        mPathSlots[i] = stream.ReadUint32();
+    }
+
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        mUuidSlots[i] = stream.ReadUint32();
+    }
+
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        if ((mPathSlots[i] != kEmptySlot && mPathSlots[i] >= numEntries) ||
+            (mUuidSlots[i] != kEmptySlot && mUuidSlots[i] >= numEntries))
+        {
+            LogError("Corrupt asset archive hash slots: %s", path);
+            Close();
+            return false;
+        }
+    }
+
+    LogDebug("Opened asset archive %s (%d assets, %d bytes)", path, numEntries, mFile.mSize);
+
+    return true;
+}
+
+void AssetArchive::Close()
+{
+    if (mFile.mData != nullptr)
+    {
+        SYS_UnmapFile(mFile);
+    }
+
+    mEntries.clear();
+    mPathSlots.clear();
+    mUuidSlots.clear();
+}
+
+bool AssetArchive::IsOpen() const
+{
+    return (mFile.mData != nullptr);
+}
+
+const AssetArchiveEntry* AssetArchive::FindEntry(const std::string& path) const
+{
+    if (mPathSlots.size() == 0)
+        return nullptr;
+
+    uint32_t mask = uint32_t(mPathSlots.size()) - 1;
+    uint32_t slot = OctHashString(path.c_str()) & mask;
+
+    while (mPathSlots[slot] != kEmptySlot)
+    {
+        const AssetArchiveEntry& entry = mEntries[mPathSlots[slot]];
+        if (entry.mPath == path)
+        {
+            return &entry;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+const AssetArchiveEntry* AssetArchive::FindEntry(uint64_t uuid) const
+{
+    if (mUuidSlots.size() == 0 || uuid == 0)
+        return nullptr;
+
+    uint32_t mask = uint32_t(mUuidSlots.size()) - 1;
+    uint32_t slot = HashUuid(uuid) & mask;
+
+    while (mUuidSlots[slot] != kEmptySlot)
+    {
+        const AssetArchiveEntry& entry = mEntries[mUuidSlots[slot]];
+        if (entry.mUuid == uuid)
+        {
+            return &entry;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+const std::vector<AssetArchiveEntry>& AssetArchive::GetEntries() const
+{
+    return mEntries;
+}
+
+void AssetArchive::GetEntryData(const AssetArchiveEntry& entry, Stream& stream) const
+{
+    OCT_ASSERT(entry.mOffset + entry.mSize <= mFile.mSize);
+    stream.SetExternalData(mFile.mData + entry.mOffset, entry.mSize);
+}
+
+uint32_t AssetArchive::HashUuid(uint64_t uuid)
+{
+    uuid ^= uuid >> 33;
+    uuid *= 0xff51afd7ed558ccdull;
+    uuid ^= uuid >> 33;
+    return uint32_t(uuid);
+}
+
+#if EDITOR
+bool AssetArchive::Write(const char* archivePath, const std::vector<std::pair<std::string, std::string> >& files)
+{
+    uint32_t numEntries = uint32_t(files.size());
+    uint32_t numSlots = GetNumSlots(numEntries);
+
+    std::vector<AssetArchiveEntry> entries;
+    entries.reserve(numEntries);
+
+    Stream stream;
+    stream.WriteUint32(ASSET_ARCHIVE_MAGIC_NUMBER);
+    stream.WriteUint32(ASSET_ARCHIVE_VERSION);
+    stream.WriteUint32(numEntries);
+    stream.WriteUint32(numSlots);
+    stream.WriteUint32(0); // Table of contents offset, patched below.
+
+    // (1) Asset data, each one aligned so its own bulk data alignment still holds inside the archive.
+    for (uint32_t i = 0; i < numEntries; ++i)
+    {
+        Stream fileStream;
+        if (!fileStream.ReadFile(files[i].second.c_str(), false))
+        {
+            LogError("Asset archive could not read %s", files[i].second.c_str());
+            return false;
+        }
+
+        AssetHeader header = Asset::ReadHeader(fileStream);
+
+        stream.AlignWrite(ASSET_BULK_DATA_ALIGNMENT);
+
+        AssetArchiveEntry entry;
+        entry.mPath = files[i].first;
+        entry.mUuid = header.mUuid;
+        entry.mType = uint32_t(header.mType);
+        entry.mOffset = stream.GetPos();
+        entry.mSize = fileStream.GetSize();
+        entries.push_back(entry);
+
+        stream.WriteBytes((const uint8_t*)fileStream.GetData(), fileStream.GetSize());
+    }
+
+    // (2) Table of contents and the two hash tables.
+    std::vector<uint32_t> pathSlots(numSlots, kEmptySlot);
+    std::vector<uint32_t> uuidSlots(numSlots, kEmptySlot);
+    uint32_t mask = numSlots - 1;
+
+    for (uint32_t i = 0; i < numEntries; ++i)
+    {
+        uint32_t slot = OctHashString(entries[i].mPath.c_str()) & mask;
+        while (pathSlots[slot] != kEmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        pathSlots[slot] = i;
+
+        // Legacy assets without a UUID can only be found by path.
+        if (entries[i].mUuid != 0)
+        {
+            slot = HashUuid(entries[i].mUuid) & mask;
+            while (uuidSlots[slot] != kEmptySlot)
+            {
+                slot = (slot + 1) & mask;
+            }
+            uuidSlots[slot] = i;
+        }
+    }
+
+    uint32_t tocOffset = stream.GetPos();
+
+    for (uint32_t i = 0; i < numEntries; ++i)
+    {
+        stream.WriteUint64(entries[i].mUuid);
+        stream.WriteUint32(entries[i].mType);
+        stream.WriteUint32(entries[i].mOffset);
+        stream.WriteUint32(entries[i].mSize);
+        stream.WriteString(entries[i].mPath);
+    }
+
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        stream.WriteUint32(pathSlots[i]);
+    }
+
+    for (uint32_t i = 0; i < numSlots; ++i)
+    {
+        stream.WriteUint32(uuidSlots[i]);
+    }
+
+    stream.SetPos(kArchiveHeaderSize - sizeof(uint32_t));
+    stream.WriteUint32(tocOffset);
+
+    bool success = stream.WriteFile(archivePath);
+    if (success)
+    {
+        LogDebug("Asset archive written: %s (%d assets, %d bytes)", archivePath, numEntries, stream.GetSize());
+    }
+
+    return success;
+}
+#endif
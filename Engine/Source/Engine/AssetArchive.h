@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "System/SystemTypes.h"
+
+class Stream;
+
+#define ASSET_ARCHIVE_MAGIC_NUMBER 0x4f435041 // "OCPA"
+#define ASSET_ARCHIVE_VERSION 1
+#define ASSET_ARCHIVE_FILE_NAME "AssetArchive.pak"
+
+struct AssetArchiveEntry
+{
+    std::string mPath;
+    uint64_t mUuid = 0;
+    uint32_t mType = 0;
+    uint32_t mOffset = 0;
+    uint32_t mSize = 0;
+};
+
+// Every cooked .oct file of a packaged project stored back to back in a single file.
+// The file is memory mapped when opened and asset streams read straight out of the
+// mapping, so loading an archived asset needs no file open, read or heap copy.
+//
+// Layout: a header of 5 uint32s (magic, version, entry count, slot count, table of contents
+// offset), then the asset data with each asset starting on an ASSET_BULK_DATA_ALIGNMENT
+// boundary. The table of contents follows the data: every entry with its path string inline,
+// then the path hash slots and the uuid hash slots. The hash slots are open addressed tables
+// of entry indices, built at cook time.
+class AssetArchive
+{
+public:
+
+    ~AssetArchive();
+
+    bool Open(const char* path, bool isAsset);
+    void Close();
+    bool IsOpen() const;
+
+    const AssetArchiveEntry* FindEntry(const std::string& path) const;
+    const AssetArchiveEntry* FindEntry(uint64_t uuid) const;
+    const std::vector<AssetArchiveEntry>& GetEntries() const;
+
+    // Points the stream at the entry's bytes inside the mapping. The stream must not outlive the archive.
+    void GetEntryData(const AssetArchiveEntry& entry, Stream& stream) const;
+
+#if EDITOR
+    // Packs the given files into a new archive. Each pair is (archive path, source file on disk).
+    static bool Write(const char* archivePath, const std::vector<std::pair<std::string, std::string> >& files);
+#endif
+
+protected:
+
+    static const uint32_t kEmptySlot = 0xffffffff;
+
+    static uint32_t HashUuid(uint64_t uuid);
+
+    MappedFile mFile;
+    std::vector<AssetArchiveEntry> mEntries;
+    std::vector<uint32_t> mPathSlots;
+    std::vector<uint32_t> mUuidSlots;
+};
@@ -31,9 +31,14 @@
 #endif
 
 #define ASYNC_REQUEUE_LIMIT 30
+#define MAX_ASYNC_LOAD_THREADS 8
 
 AssetManager* AssetManager::sInstance = nullptr;
 
+// Set on async load threads. Async loads requested from a loader thread are dependencies
+// of the asset being loaded, so they jump to the front of the queue.
+static thread_local bool sAsyncLoadThread = false;
+
 Asset* FetchAsset(const std::string& name)
 {
     return AssetManager::Get()->GetAsset(name);
@@ -111,30 +116,44 @@ AssetManager::~AssetManager()
 {
     Purge(true);
 
-    SYS_LockMutex(mMutex);
-    // Flag that we are destructing so that the async load thread can exit.
-    mDestructing = true;
-    SYS_UnlockMutex(mMutex);
+    {
+        // Flag that we are destructing so that the async load threads can exit.
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        mDestructing = true;
+    }
 
-    SYS_JoinThread(mAsyncLoadThread);
-    SYS_DestroyThread(mAsyncLoadThread);
-    mAsyncLoadThread = nullptr;
+    mLoadCondition.notify_all();
 
-    SYS_DestroyMutex(mMutex);
-    mMutex = nullptr;
+    for (uint32_t i = 0; i < mAsyncLoadThreads.size(); ++i)
+    {
+        SYS_JoinThread(mAsyncLoadThreads[i]);
+        SYS_DestroyThread(mAsyncLoadThreads[i]);
+    }
+
+    mAsyncLoadThreads.clear();
 }
 
 void AssetManager::Initialize()
 {
     mRootDirectory = new AssetDir("Root", "", nullptr);
 
-    mMutex = SYS_CreateMutex();
-    mAsyncLoadThread = SYS_CreateThread(AsyncLoadThreadFunc, this);
+    int32_t numThreads = glm::clamp(GetEngineConfig()->mAsyncLoadThreads, 1, MAX_ASYNC_LOAD_THREADS);
+
+#if !(PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_ANDROID)
+    // Consoles read from a single slow device, so more threads would only add contention.
+    numThreads = 1;
+#endif
+
+    for (int32_t i = 0; i < numThreads; ++i)
+    {
+        mAsyncLoadThreads.push_back(SYS_CreateThread(AsyncLoadThreadFunc, this));
+    }
 }
 
 void AssetManager::Update(float deltaTime)
 {
     UpdateEndLoadQueue();
+    UpdateSweepQueue(false);
 }
 
 AssetStub* AssetManager::RegisterAsset(const std::string& filename, TypeId type, AssetDir* directory, EmbeddedFile* embeddedAsset, bool engineAsset, uint64_t uuid)
@@ -464,6 +483,37 @@ void AssetManager::DiscoverAssetRegistry(const char* registryPath)
     }
 }
 
+bool AssetManager::DiscoverAssetArchive(const char* archivePath)
+{
+    SCOPED_STAT("DiscoverAssetArchive");
+
+    if (!mArchive.Open(archivePath, true))
+    {
+        return false;
+    }
+
+    // The table of contents already has the type and UUID of every asset, so no asset headers need to be read.
+    const std::vector<AssetArchiveEntry>& entries = mArchive.GetEntries();
+    for (uint32_t i = 0; i < entries.size(); ++i)
+    {
+        RegisterAsset(entries[i].mPath, TypeId(entries[i].mType), mRootDirectory, nullptr, false, entries[i].mUuid);
+    }
+
+    return true;
+}
+
+bool AssetManager::GetArchivedAssetData(const std::string& path, Stream& outStream) const
+{
+    const AssetArchiveEntry* entry = mArchive.FindEntry(path);
+
+    if (entry != nullptr)
+    {
+        mArchive.GetEntryData(*entry, outStream);
+    }
+
+    return (entry != nullptr);
+}
+
 void AssetManager::DiscoverEmbeddedAssets(EmbeddedFile* assets, uint32_t numAssets)
 {
     SCOPED_STAT("DiscoverEmbeddedAssets");
@@ -493,6 +543,7 @@ void AssetManager::Purge(bool purgeEngineAssets)
     // Destroy all assets in the map and empty the map.
     // Caller needs to ensure that no assets are being referenced.
 
+    ClearSweepQueue();
     mPurging = true;
 
     if (purgeEngineAssets)
@@ -606,17 +657,14 @@ bool AssetManager::PurgeAsset(const char* name)
     return purged;
 }
 
-void AssetManager::RefSweep()
+void AssetManager::RefSweep(bool immediate)
 {
-    // Iterate several times until no assets are unloaded.
-    uint32_t iter = 0;
-    uint32_t numAssetsUnloaded = 0;
-    uint32_t totalAssetsUnloaded = 0;
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
 
-    while (iter == 0 || (iter < 10 && numAssetsUnloaded != 0))
     {
-        totalAssetsUnloaded += numAssetsUnloaded;
-        numAssetsUnloaded = 0;
+        std::lock_guard<std::mutex> sweepLock(mSweepMutex);
+
+        float now = GetEngineState()->mRealElapsedTime;
 
         for (auto it = mAssetMap.begin(); it != mAssetMap.end(); ++it)
         {
@@ -626,33 +674,265 @@ void AssetManager::RefSweep()
                 continue;
 #endif
 
-            if (it->second->mAsset != nullptr &&
-                it->second->mAsset->IsLoaded() &&
-                it->second->mAsset->GetRefCount() == 0)
+            Asset* asset = it->second->mAsset;
+
+            if (asset != nullptr &&
+                asset->IsLoaded() &&
+                asset->GetRefCount() == 0)
+            {
+                asset->mUnreferencedTime = now;
+
+                if (!asset->mSweepQueued)
+                {
+                    PushSweepCandidate(asset);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < mTransientAssets.size(); ++i)
+        {
+            Asset* asset = mTransientAssets[i];
+
+            if (asset->GetRefCount() == 0)
+            {
+                asset->mUnreferencedTime = now;
+
+                if (!asset->mSweepQueued)
+                {
+                    PushSweepCandidate(asset);
+                }
+            }
+        }
+
+        // Everything queued so far (including assets that were already waiting) skips the grace period.
+        mForcedSweepEnd = mSweepQueueBase + mSweepQueue.size();
+
+        LogDebug("%d assets queued for sweeping", int32_t(mSweepQueue.size()));
+    }
+
+    if (immediate)
+    {
+        UpdateSweepQueue(true);
+    }
+}
+
+void AssetManager::QueueSweepCandidate(Asset* asset)
+{
+    if (mPurging || mDestructing)
+        return;
+
+    // Only the sweep lock is taken here. Refs are released on loader threads and while the
+    // AssetRef mutex is held, so taking mMutex here could deadlock with a loader thread.
+    std::lock_guard<std::mutex> lock(mSweepMutex);
+
+    if (!mFullSweep)
+    {
+#if EDITOR
+        // Editor panels hold onto raw asset pointers, so only sweep when asked to.
+        return;
+#else
+        if (!GetEngineConfig()->mAssetAutoSweep)
+            return;
+#endif
+    }
+
+    // If it's already queued, the new time moves it to the back when the sweep reaches it.
+    asset->mUnreferencedTime = GetEngineState()->mRealElapsedTime;
+
+    if (!asset->mSweepQueued)
+    {
+        PushSweepCandidate(asset);
+    }
+}
+
+void AssetManager::RemoveSweepCandidate(Asset* asset)
+{
+    std::lock_guard<std::mutex> lock(mSweepMutex);
+
+    if (asset->mSweepQueued)
+    {
+        // Leave a null entry behind. It's skipped when it reaches the front of the queue.
+        SweepCandidate& candidate = mSweepQueue[size_t(asset->mSweepSlot - mSweepQueueBase)];
+        OCT_ASSERT(candidate.mAsset == asset);
+        candidate.mAsset = nullptr;
+        asset->mSweepQueued = false;
+    }
+}
+
+void AssetManager::ClearSweepQueue()
+{
+    std::lock_guard<std::mutex> lock(mSweepMutex);
+
+    for (uint32_t i = 0; i < mSweepQueue.size(); ++i)
+    {
+        if (mSweepQueue[i].mAsset != nullptr)
+        {
+            mSweepQueue[i].mAsset->mSweepQueued = false;
+        }
+    }
+
+    mSweepQueueBase += mSweepQueue.size();
+    mForcedSweepEnd = mSweepQueueBase;
+    mSweepQueue.clear();
+}
+
+void AssetManager::PushSweepCandidate(Asset* asset)
+{
+    asset->mSweepQueued = true;
+    asset->mSweepSlot = mSweepQueueBase + mSweepQueue.size();
+
+    SweepCandidate candidate;
+    candidate.mAsset = asset;
+    candidate.mTime = asset->mUnreferencedTime;
+    mSweepQueue.push_back(candidate);
+}
+
+void AssetManager::UpdateSweepQueue(bool ignoreBudget)
+{
+    {
+        std::lock_guard<std::mutex> sweepLock(mSweepMutex);
+
+        if (mSweepQueue.size() == 0)
+            return;
+    }
+
+    // Loader threads take refs on loaded assets through FetchAssetRef(), which looks up the asset
+    // and assigns the ref while holding mMutex. Holding it here keeps each ref count check valid
+    // until the asset is unloaded, so the sweep doesn't have to wait for pending loads to finish.
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    const EngineConfig* config = GetEngineConfig();
+    float now = GetEngineState()->mRealElapsedTime;
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+    uint64_t budgetUs = uint64_t(glm::max(config->mAssetSweepBudgetMs, 0.0f) * 1000.0f);
+    uint32_t numAssetsUnloaded = 0;
+
+    while (true)
+    {
+        Asset* asset = nullptr;
+        bool forced = false;
+
+        {
+            // Unloading releases refs, which queues more candidates, so the sweep lock is only
+            // held while picking the next asset.
+            std::lock_guard<std::mutex> sweepLock(mSweepMutex);
+
+            while (mSweepQueue.size() > 0)
+            {
+                SweepCandidate candidate = mSweepQueue.front();
+                forced = (mSweepQueueBase < mForcedSweepEnd);
+
+                if (candidate.mAsset == nullptr)
+                {
+                    // The asset was deleted while it was queued.
+                    mSweepQueue.pop_front();
+                    mSweepQueueBase++;
+                    continue;
+                }
+
+                if (candidate.mAsset->GetRefCount() > 0 || !candidate.mAsset->IsLoaded())
+                {
+                    // Used again (or still loading). It gets queued again when its refs are released.
+                    mSweepQueue.pop_front();
+                    mSweepQueueBase++;
+                    candidate.mAsset->mSweepQueued = false;
+                    continue;
+                }
+
+                if (!forced)
+                {
+                    if (candidate.mAsset->mUnreferencedTime > candidate.mTime)
+                    {
+                        // Released again after it was queued, so move it to its place in the LRU order.
+                        mSweepQueue.pop_front();
+                        mSweepQueueBase++;
+                        PushSweepCandidate(candidate.mAsset);
+                        continue;
+                    }
+
+                    // Everything behind this one was released more recently.
+                    if (now - candidate.mTime < config->mAssetSweepGraceTime)
+                        break;
+                }
+
+                // Always make some progress, even if one unload blows the budget.
+                if (!ignoreBudget &&
+                    numAssetsUnloaded > 0 &&
+                    SYS_GetTimeMicroseconds() - startTime >= budgetUs)
+                {
+                    break;
+                }
+
+                mSweepQueue.pop_front();
+                mSweepQueueBase++;
+                candidate.mAsset->mSweepQueued = false;
+                asset = candidate.mAsset;
+                break;
+            }
+
+            // Unloading can drop the last ref on the assets it used. Queue those too, and if this was
+            // part of a RefSweep(), sweep them without waiting for the grace period either.
+            mFullSweep = (asset != nullptr && forced);
+        }
+
+        if (asset == nullptr)
+            break;
+
+        if (UnloadSweptAsset(asset))
+        {
+            ++numAssetsUnloaded;
+        }
+
+        {
+            std::lock_guard<std::mutex> sweepLock(mSweepMutex);
+            mFullSweep = false;
+
+            if (forced)
             {
-                it->second->mAsset->Destroy();
-                delete it->second->mAsset;
-                it->second->mAsset = nullptr;
-                ++numAssetsUnloaded;
+                mForcedSweepEnd = mSweepQueueBase + mSweepQueue.size();
             }
         }
+    }
+}
 
-        for (int32_t i = int32_t(mTransientAssets.size()) - 1; i >= 0; --i)
+bool AssetManager::UnloadSweptAsset(Asset* asset)
+{
+    if (asset->IsTransient())
+    {
+        for (uint32_t i = 0; i < mTransientAssets.size(); ++i)
         {
-            if (mTransientAssets[i]->GetRefCount() == 0)
+            if (mTransientAssets[i] == asset)
             {
-                mTransientAssets[i]->Destroy();
-                delete mTransientAssets[i];
+                mTransientAssets[i] = mTransientAssets.back();
+                mTransientAssets.pop_back();
 
-                mTransientAssets.erase(mTransientAssets.begin() + i);
+                asset->Destroy();
+                delete asset;
+                return true;
             }
         }
 
-        iter++;
+        return false;
     }
 
-    totalAssetsUnloaded += numAssetsUnloaded;
-    LogDebug("%d assets swept", totalAssetsUnloaded);
+    AssetStub* stub = GetAssetStubByUuid(asset->GetUuid());
+    if (stub == nullptr || stub->mAsset != asset)
+    {
+        stub = GetAssetStub(asset->GetName());
+    }
+
+    if (stub == nullptr || stub->mAsset != asset)
+        return false;
+
+#if EDITOR
+    if (stub->mEngineAsset)
+        return false;
+#endif
+
+    asset->Destroy();
+    delete asset;
+    stub->mAsset = nullptr;
+    return true;
 }
 
 void AssetManager::LoadAll()
@@ -939,6 +1219,34 @@ Asset* AssetManager::GetAssetByUuid(uint64_t uuid)
     return (stub != nullptr) ? stub->mAsset : nullptr;
 }
 
+bool AssetManager::FetchAssetRef(const std::string& name, AssetRef& outRef)
+{
+    // The sweep holds mMutex from its ref count check until the asset is unloaded,
+    // so the lookup and the ref have to be taken together under it.
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    Asset* asset = GetAsset(name);
+    if (asset != nullptr)
+    {
+        outRef = asset;
+    }
+
+    return (asset != nullptr);
+}
+
+bool AssetManager::FetchAssetRefByUuid(uint64_t uuid, AssetRef& outRef)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    Asset* asset = GetAssetByUuid(uuid);
+    if (asset != nullptr)
+    {
+        outRef = asset;
+    }
+
+    return (asset != nullptr);
+}
+
 Asset* AssetManager::LoadAssetByUuid(uint64_t uuid)
 {
     AssetStub* stub = GetAssetStubByUuid(uuid);
@@ -951,7 +1259,7 @@ Asset* AssetManager::LoadAssetByUuid(uint64_t uuid)
 
 void AssetManager::AsyncLoadAssetByUuid(uint64_t uuid, AssetRef* targetRef)
 {
-    SCOPED_LOCK(mMutex);
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
 
     AssetStub* stub = GetAssetStubByUuid(uuid);
     if (stub == nullptr)
@@ -1020,7 +1328,7 @@ Asset* AssetManager::LoadAssetByPath(const std::string& path)
 
 void AssetManager::AsyncLoadAsset(const std::string& name, AssetRef* targetRef)
 {
-    SCOPED_LOCK(mMutex);
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
     // (1) Check to see if an asset stub exists at all, if not, then log an error and return.
     AssetStub* stub = GetAssetStub(name);
     if (stub == nullptr)
@@ -1046,36 +1354,44 @@ void AssetManager::AsyncLoadAsset(const std::string& name, AssetRef* targetRef)
         return;
     }
 
-    // (3) Check to see if an AsyncLoadRequest is already in flight (in begin/end queues) and if so, add this ref to the list.
-    for (uint32_t i = 0; i < mBeginLoadQueue.size(); ++i)
+    // (3) Check to see if an AsyncLoadRequest is already in flight and if so, add this ref to the list.
+    auto pendingIt = mPendingLoads.find(name);
+    if (pendingIt != mPendingLoads.end())
     {
-        if (mBeginLoadQueue[i]->mName == name)
-        {
-            if (targetRef != nullptr)
-            {
-                targetRef->SetLoadRequest(mBeginLoadQueue[i]);
-            }
+        AsyncLoadRequest* request = pendingIt->second;
 
-            return;
+        if (targetRef != nullptr)
+        {
+            targetRef->SetLoadRequest(request);
         }
-    }
 
-    for (uint32_t i = 0; i < mEndLoadQueue.size(); ++i)
-    {
-        if (mEndLoadQueue[i]->mName == name)
+        // Another asset depends on this one, so move it up if it hasn't been picked up by a loader yet.
+        if (sAsyncLoadThread && !request->mLoadStarted)
         {
-            if (targetRef != nullptr)
+            auto queueIt = std::find(mBeginLoadQueue.begin(), mBeginLoadQueue.end(), request);
+            if (queueIt != mBeginLoadQueue.end())
             {
-                targetRef->SetLoadRequest(mEndLoadQueue[i]);
+                mBeginLoadQueue.erase(queueIt);
+                mBeginLoadQueue.push_front(request);
             }
-
-            return;
         }
+
+        return;
     }
-    
-    // (4) Otherwise, malloc and enqueue a new AsyncLoadRequest to the BeginLoadQueue
+
+    // (4) Otherwise, malloc and enqueue a new AsyncLoadRequest to the BeginLoadQueue.
+    // Dependencies go to the front so that the assets waiting on them can finish sooner.
     AsyncLoadRequest* newRequest = new AsyncLoadRequest();
-    mBeginLoadQueue.push_back(newRequest);
+    mPendingLoads.insert({ name, newRequest });
+
+    if (sAsyncLoadThread)
+    {
+        mBeginLoadQueue.push_front(newRequest);
+    }
+    else
+    {
+        mBeginLoadQueue.push_back(newRequest);
+    }
 
     // (5) Set the data on the request, including the targetRef.
     newRequest->mName = name;
@@ -1088,6 +1404,8 @@ void AssetManager::AsyncLoadAsset(const std::string& name, AssetRef* targetRef)
         // (6) Set the request pointer on the AssetRef.
         targetRef->SetLoadRequest(newRequest);
     }
+
+    mLoadCondition.notify_one();
 }
 
 void AssetManager::SaveAsset(const std::string& name)
@@ -1633,162 +1951,188 @@ std::vector<AssetStub*> AssetManager::GatherDirtyAssets()
 ThreadFuncRet AssetManager::AsyncLoadThreadFunc(void* in)
 {
     AssetManager& am = *((AssetManager*)in);
-    bool exit = false;
+    sAsyncLoadThread = true;
+
+    GetProfiler()->SetThreadName("Async Load");
 
-    while (!exit)
+    while (true)
     {
         AsyncLoadRequest* request = nullptr;
 
-        // Pop off the next request from the queue.
-        SYS_LockMutex(am.mMutex);
-        bool exit = am.mDestructing;
-        if (am.mBeginLoadQueue.size() > 0)
+        // Sleep until there is a request to load (or we are shutting down).
         {
+            std::unique_lock<std::recursive_mutex> lock(am.mMutex);
+            am.mLoadCondition.wait(lock, [&am]() { return am.mDestructing || am.mBeginLoadQueue.size() > 0; });
+
+            if (am.mDestructing)
+            {
+                break;
+            }
+
             request = am.mBeginLoadQueue.front();
             am.mBeginLoadQueue.pop_front();
+            request->mLoadStarted = true;
         }
-        SYS_UnlockMutex(am.mMutex);
 
-        if (exit)
+        // We have a request, so we need to
+        // (1) Create the Asset type
+        Asset* newAsset = Asset::CreateInstance(request->mType);
+        OCT_ASSERT(newAsset);
+
+        // (2) Load the file into a stream
+        // (3) Call asset->LoadStream()
+        // The call to Asset::Create() is made on the main thread, that's why we queue it up on the EndLoadQueue
+        if (request->mEmbeddedData != nullptr)
         {
-            break;
+            newAsset->LoadEmbedded(request->mEmbeddedData, request);
         }
-
-        if (request != nullptr)
+        else
         {
-            // We have a request, so we need to
-            // (1) Create the Asset type
-            Asset* newAsset = Asset::CreateInstance(request->mType);
-            OCT_ASSERT(newAsset);
-
-            // (2) Load the file into a stream
-            // (3) Call asset->LoadStream()
-            // The call to Asset::Create() is made on the main thread, that's why we queue it up on the EndLoadQueue
-            if (request->mEmbeddedData != nullptr)
-            {
-                newAsset->LoadEmbedded(request->mEmbeddedData, request);
-            }
-            else
-            {
-                newAsset->LoadFile(request->mPath.c_str(), request);
-            }
+            newAsset->LoadFile(request->mPath.c_str(), request);
+        }
 
-            request->mAsset = newAsset;
+        request->mAsset = newAsset;
 
-            // (4) Add the request to the EndLoadQueue
-            {
-                SCOPED_LOCK(am.mMutex);
-                am.mEndLoadQueue.push_back(request);
-            }
-        }
-        else
+        // (4) Add the request to the EndLoadQueue
         {
-            // If nothing to process then sleep, for a bit so we don't was cpu cycles checking.
-            SYS_Sleep(2);
+            std::lock_guard<std::recursive_mutex> lock(am.mMutex);
+            am.mEndLoadQueue.push_back(request);
         }
     }
 
     THREAD_RETURN();
 }
 
-void AssetManager::UpdateEndLoadQueue()
+bool AssetManager::AreDependenciesLoaded(const AsyncLoadRequest* request) const
 {
-    SCOPED_LOCK(mMutex);
+    for (uint32_t i = 0; i < request->mDependentAssets.size(); ++i)
+    {
+        if (request->mDependentAssets[i]->mAsset == nullptr)
+        {
+            return false;
+        }
+    }
 
-    const uint32_t maxIterations = 3;
-    uint32_t numIterations = 0;
+    return true;
+}
 
-    bool handled = false;
+void AssetManager::FinishAsyncLoad(AsyncLoadRequest* loadRequest)
+{
+    AssetStub* stub = GetAssetStub(loadRequest->mName);
 
-    do
     {
-        handled = false;
-        AsyncLoadRequest* loadRequest = (mEndLoadQueue.size() > 0) ? mEndLoadQueue.front() : nullptr;
+        // Lock the AssetRefLock while we update asset members
+        SCOPED_LOCK(GetAssetRefMutex());
 
-        if (mEndLoadQueue.size() > 0)
+        Asset* loadedAsset = nullptr;
+
+        if (stub == nullptr)
         {
-            mEndLoadQueue.pop_front();
+            LogError("Cannot find asset for async load request");
         }
-
-        if (loadRequest != nullptr)
+        else if (stub->mAsset != nullptr)
         {
-            numIterations++;
+            LogWarning("AsyncLoadRequest not finished because the asset has already been loaded");
+            loadedAsset = stub->mAsset;
+        }
+        else
+        {
+            LogDebug("Finished Async Loading: %s", loadRequest->mName.c_str());
 
-            // Check load dependencies before finish the load
-            bool allDependenciesLoaded = true;
+            // Finish the load on the main thread and assign the stub's mAsset so that it is officially "Loaded"
+            OCT_ASSERT(loadRequest->mAsset != nullptr);
+            loadRequest->mAsset->Create();
+            stub->mAsset = loadRequest->mAsset;
+            loadedAsset = loadRequest->mAsset;
+        }
 
-            for (uint32_t i = 0; i < loadRequest->mDependentAssets.size(); ++i)
+        // Now assign the asset to all of the refs that had requested the load
+        for (int32_t i = int32_t(loadRequest->mTargetRefs.size()) - 1; loadedAsset != nullptr && i >= 0; --i)
+        {
+            if (loadRequest->mTargetRefs[i] != nullptr)
             {
-                if (loadRequest->mDependentAssets[i]->mAsset == nullptr)
-                {
-                    allDependenciesLoaded = false;
-                    break;
-                }
+                // The load request of the target ref should match this load request but...
+                // We need to make sure we handle the case where an AssetRef is assigned twice to an async load
+                // before the first one finishes. Might mean Canceling the request if one already exists in AsyncLoadAsset()
+                OCT_ASSERT(loadRequest->mTargetRefs[i]->GetLoadRequest() == nullptr ||
+                    loadRequest->mTargetRefs[i]->GetLoadRequest() == loadRequest);
+
+                // This will clear the existing load request (and also remove the entry from loadRequest->mTargetRefs
+                (*loadRequest->mTargetRefs[i]) = loadedAsset;
             }
+        }
+    }
 
-            if (allDependenciesLoaded)
-            {
-                handled = true;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        mPendingLoads.erase(loadRequest->mName);
+    }
 
-                AssetStub* stub = GetAssetStub(loadRequest->mName);
+    delete loadRequest;
+}
 
-                // Lock the AssetRefLock while we update asset members
-                SCOPED_LOCK(GetAssetRefMutex());
+void AssetManager::UpdateEndLoadQueue()
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(mMutex);
+        mFinalizeQueue.insert(mFinalizeQueue.end(), mEndLoadQueue.begin(), mEndLoadQueue.end());
+        mEndLoadQueue.clear();
+    }
 
-                if (stub == nullptr)
-                {
-                    LogError("Cannot find asset for async load request");
-                }
-                else if (stub->mAsset != nullptr)
-                {
-                    LogWarning("AsyncLoadRequest not finished because the asset has already been loaded");
-                }
-                else
-                {
-                    LogDebug("Finished Async Loading: %s", loadRequest->mName.c_str());
+    if (mFinalizeQueue.size() == 0)
+        return;
 
-                    // Finish the load on the main thread and assign the stub's mAsset so that it is officially "Loaded"
-                    OCT_ASSERT(loadRequest->mAsset != nullptr);
-                    loadRequest->mAsset->Create();
-                    stub->mAsset = loadRequest->mAsset;
+    SCOPED_FRAME_STAT("AsyncLoad");
 
-                    // Now assign the asset to all of the refs that had requested the load
-                    for (int32_t i = int32_t(loadRequest->mTargetRefs.size()) - 1; i >= 0; --i)
-                    {
-                        if (loadRequest->mTargetRefs[i] != nullptr)
-                        {
-                            // The load request of the target ref should match this load request but...
-                            // We need to make sure we handle the case where an AssetRef is assigned twice to an async load
-                            // before the first one finishes. Might mean Canceling the request if one already exists in AsyncLoadAsset()
-                            OCT_ASSERT(loadRequest->mTargetRefs[i]->GetLoadRequest() == nullptr ||
-                                loadRequest->mTargetRefs[i]->GetLoadRequest() == loadRequest);
-
-                            // This will clear the existing load request (and also remove the entry from loadRequest->mTargetRefs
-                            (*loadRequest->mTargetRefs[i]) = loadRequest->mAsset;
-                        }
-                    }
-                }
+    // Always finish at least one load per frame, then keep going until the budget is spent.
+    const uint64_t budgetUs = uint64_t(glm::max(GetEngineConfig()->mAsyncLoadBudgetMs, 0.0f) * 1000.0f);
+    const uint64_t startTime = SYS_GetTimeMicroseconds();
+    bool outOfTime = false;
+    bool progress = true;
+
+    // Finishing a load can unblock the loads that depend on it, so keep making passes until nothing changes.
+    while (progress && !outOfTime)
+    {
+        progress = false;
+
+        for (uint32_t i = 0; i < mFinalizeQueue.size(); )
+        {
+            AsyncLoadRequest* loadRequest = mFinalizeQueue[i];
+
+            if (!AreDependenciesLoaded(loadRequest))
+            {
+                ++i;
+                continue;
+            }
+
+            mFinalizeQueue.erase(mFinalizeQueue.begin() + i);
+            FinishAsyncLoad(loadRequest);
+            progress = true;
 
-                delete loadRequest;
-                loadRequest = nullptr;
+            if (SYS_GetTimeMicroseconds() - startTime >= budgetUs)
+            {
+                outOfTime = true;
+                break;
             }
-            else
+        }
+    }
+
+    if (!outOfTime)
+    {
+        // Everything left is waiting on dependencies that are still loading.
+        // If that goes on for too long, there's probably a dependency cycle.
+        for (uint32_t i = 0; i < mFinalizeQueue.size(); ++i)
+        {
+            AsyncLoadRequest* loadRequest = mFinalizeQueue[i];
+            loadRequest->mRequeueCount++;
+
+            if (loadRequest->mRequeueCount == ASYNC_REQUEUE_LIMIT)
             {
-                // Still waiting on some dependent assets, so push this on the back of the queue
-                // This might happen several times before the dependent assests make their way to the front
-                // of the mEndLoadQueue.
-                LogWarning("Async load for %s is still waiting on dependencies", loadRequest->mName.c_str());
-                mEndLoadQueue.push_back(loadRequest);
-                loadRequest->mRequeueCount++;
-
-                if (loadRequest->mRequeueCount >= ASYNC_REQUEUE_LIMIT)
-                {
-                    LogWarning("Exceeded requeue limit for %s, possible cyclical dependency. Forcing load.", loadRequest->mName.c_str());
-                    LoadAsset(loadRequest->mName);
-                }
+                LogWarning("Async load for %s is still waiting on dependencies, possible cyclical dependency. Forcing load.", loadRequest->mName.c_str());
+                LoadAsset(loadRequest->mName);
             }
         }
-    } while (handled && numIterations < maxIterations);
+    }
 }
 
 #if EDITOR
@@ -2,6 +2,7 @@
 
 #include "Asset.h"
 #include "AssetRef.h"
+#include "AssetArchive.h"
 #include "Log.h"
 
 #include "System/System.h"
@@ -9,6 +10,8 @@
 #include <string>
 #include <deque>
 #include <unordered_map>
+#include <mutex>
+#include <condition_variable>
 
 class Asset;
 class AssetDir;
@@ -25,7 +28,8 @@ struct AsyncLoadRequest
     const EmbeddedFile* mEmbeddedData = nullptr;
     TypeId mType = INVALID_TYPE_ID;
     Asset* mAsset = nullptr;
-    int32_t mRequeueCount = 0;
+    int32_t mRequeueCount = 0; // Frames spent waiting on dependencies after loading
+    bool mLoadStarted = false;
 };
 
 // Name-based lookup (backward compatible)
@@ -86,14 +90,26 @@ public:
     void DiscoverDirectory(AssetDir* directory, bool engineDir);
     void Discover(const char* directoryName, const char* directoryPath);
     void DiscoverAssetRegistry(const char* registryPath);
+    bool DiscoverAssetArchive(const char* archivePath);
     void DiscoverEmbeddedAssets(struct EmbeddedFile* assets, uint32_t numAssets);
     void Purge(bool purgeEngineAssets);
     bool PurgeAsset(const char* name);
-    void RefSweep();
+    // Queues every unreferenced asset for unloading without waiting for the grace period.
+    // They are unloaded over the next frames within the sweep budget. If immediate, they are
+    // all unloaded now instead (e.g. for editor actions that need the memory back right away).
+    void RefSweep(bool immediate = false);
+
+    // Called when an asset's ref count drops to zero. With AssetAutoSweep, queued assets are
+    // unloaded a few at a time in Update() once they have gone unreferenced for the grace period.
+    void QueueSweepCandidate(Asset* asset);
+    void RemoveSweepCandidate(Asset* asset);
     void LoadAll();
 
     void RegisterTransientAsset(Asset* asset);
 
+    // Points the stream at the asset's bytes in the mapped archive. Returns false if the asset isn't archived.
+    bool GetArchivedAssetData(const std::string& path, Stream& outStream) const;
+
     Asset* ImportEngineAsset(TypeId assetType, AssetDir* dir, const std::string& filename, ImportOptions* options = nullptr);
     void ImportEngineAssets();
 
@@ -108,6 +124,11 @@ public:
     // UUID-based lookup (primary)
     AssetStub* GetAssetStubByUuid(uint64_t uuid);
     Asset* GetAssetByUuid(uint64_t uuid);
+
+    // Assigns the asset to outRef if it's loaded. The lookup and the ref are taken under one lock
+    // so the sweep can't unload the asset in between. Use these to take refs on loader threads.
+    bool FetchAssetRef(const std::string& name, AssetRef& outRef);
+    bool FetchAssetRefByUuid(uint64_t uuid, AssetRef& outRef);
     Asset* LoadAssetByUuid(uint64_t uuid);
     void AsyncLoadAssetByUuid(uint64_t uuid, AssetRef* targetRef);
 
@@ -153,18 +174,39 @@ protected:
     AssetManager();
 
     void UpdateEndLoadQueue();
+    bool AreDependenciesLoaded(const AsyncLoadRequest* request) const;
+    void FinishAsyncLoad(AsyncLoadRequest* request);
+    void UpdateSweepQueue(bool ignoreBudget);
+    void ClearSweepQueue();
+    void PushSweepCandidate(Asset* asset);
+    bool UnloadSweptAsset(Asset* asset);
+
+    struct SweepCandidate
+    {
+        Asset* mAsset = nullptr;
+        float mTime = 0.0f;
+    };
 
     std::unordered_map<std::string, AssetStub*> mAssetMap;      // Name-based lookup (first wins)
     std::unordered_map<std::string, AssetStub*> mAssetPathMap;  // Path-based lookup (e.g., "Models/SM_Plane")
     std::unordered_map<uint64_t, AssetStub*> mUuidMap;          // UUID-based lookup (primary)
     std::vector<Asset*> mTransientAssets;
+    AssetArchive mArchive; // Read-only once opened, so loader threads can use it without locking.
     AssetDir* mRootDirectory = nullptr;
     bool mPurging = false;
+    bool mFullSweep = false;
+    std::deque<SweepCandidate> mSweepQueue; // Ordered by when the asset became unreferenced. Removed assets leave a null entry.
+    uint64_t mSweepQueueBase = 0; // Slot number of the front of the queue. Assets remember their slot to find their entry.
+    uint64_t mForcedSweepEnd = 0; // Slots before this were queued by RefSweep() and skip the grace period.
+    std::mutex mSweepMutex; // Guards the sweep queue. Never held while taking mMutex or the AssetRef mutex.
     bool mDestructing = false;
     std::deque<AsyncLoadRequest*> mBeginLoadQueue;
     std::deque<AsyncLoadRequest*> mEndLoadQueue;
-    ThreadObject* mAsyncLoadThread = {};
-    MutexObject* mMutex = {};
+    std::vector<AsyncLoadRequest*> mFinalizeQueue; // Main thread only. Loaded requests waiting for Create().
+    std::unordered_map<std::string, AsyncLoadRequest*> mPendingLoads; // Every request that hasn't been finished yet
+    std::vector<ThreadObject*> mAsyncLoadThreads;
+    std::recursive_mutex mMutex;
+    std::condition_variable_any mLoadCondition;
 
 #if EDITOR
 public:
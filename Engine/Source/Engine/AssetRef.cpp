@@ -9,6 +9,7 @@
 #include "Assets/SoundWave.h"
 
 #include "Nodes/3D/StaticMesh3d.h"
+#include "Nodes/3D/SkeletalMesh3d.h"
 
 #include "AssetManager.h"
 
@@ -72,23 +73,40 @@ void AssetRef::ReplaceReferencesToAsset(Asset* oldAsset, Asset* newAsset)
 
 
         // Hacky special case...
-        if ((oldAsset && oldAsset->GetType() == StaticMesh::GetStaticType()) ||
-            (newAsset && newAsset->GetType() == StaticMesh::GetStaticType()))
+        bool staticMesh = ((oldAsset && oldAsset->GetType() == StaticMesh::GetStaticType()) ||
+            (newAsset && newAsset->GetType() == StaticMesh::GetStaticType()));
+        bool skeletalMesh = ((oldAsset && oldAsset->GetType() == SkeletalMesh::GetStaticType()) ||
+            (newAsset && newAsset->GetType() == SkeletalMesh::GetStaticType()));
+
+        if (staticMesh || skeletalMesh)
         {
             // If we are replacing refs to a static mesh, we need to update any StaticMesh3D that may be using their
-            // triangle collision data.
+            // triangle collision data. The refs were swapped without going through SetStaticMesh()/SetSkeletalMesh(),
+            // so the bounds of the nodes now using the new mesh are stale too.
             for (auto& editScene : GetEditorState()->mEditScenes)
             {
                 if (editScene.mRootNode == nullptr)
                     continue;
 
-                editScene.mRootNode->Traverse([](Node* node) -> bool
+                editScene.mRootNode->Traverse([staticMesh, newAsset](Node* node) -> bool
                 {
                     StaticMesh3D* mesh3d = node->As<StaticMesh3D>();
-                    if (mesh3d)
+                    SkeletalMesh3D* skMesh3d = node->As<SkeletalMesh3D>();
+
+                    if (mesh3d && staticMesh)
                     {
                         mesh3d->RecreateCollisionShape();
+
+                        if (mesh3d->GetStaticMesh() == newAsset)
+                        {
+                            mesh3d->MarkBoundsDirty();
+                        }
                     }
+                    else if (skMesh3d && skMesh3d->GetSkeletalMesh() == newAsset)
+                    {
+                        skMesh3d->MarkBoundsDirty();
+                    }
+
                     return true;
                 });
             }
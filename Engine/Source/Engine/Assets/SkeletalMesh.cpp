@@ -21,7 +21,41 @@ DEFINE_ASSET(SkeletalMesh);
 
 bool SkeletalMesh::HandlePropChange(Datum* datum, uint32_t index, const void* newValue)
 {
-    return HandleAssetPropChange(datum, index, newValue);
+    Property* prop = static_cast<Property*>(datum);
+    OCT_ASSERT(prop != nullptr);
+    SkeletalMesh* mesh = static_cast<SkeletalMesh*>(prop->mOwner);
+    bool success = HandleAssetPropChange(datum, index, newValue);
+
+    if (prop->mName == "Bake Sample Rate")
+    {
+        mesh->SetBakeSampleRate(*(float*)newValue);
+        success = true;
+    }
+
+    return success;
+}
+
+// Finds the key pair surrounding time. Bake sample times only ever increase,
+// so the index just walks forward from where the previous sample left off.
+template<typename KeyType>
+static float FindBakeKeys(const std::vector<KeyType>& keys, float time, uint32_t& index)
+{
+    while (index + 2 < keys.size() &&
+           time >= keys[index + 1].mTime)
+    {
+        ++index;
+    }
+
+    float factor = 0.0f;
+
+    if (index + 1 < keys.size())
+    {
+        float deltaTime = keys[index + 1].mTime - keys[index].mTime;
+        factor = (deltaTime > 0.0f) ? ((time - keys[index].mTime) / deltaTime) : 0.0f;
+        factor = glm::clamp(factor, 0.0f, 1.0f);
+    }
+
+    return factor;
 }
 
 SkeletalMesh::SkeletalMesh() :
@@ -167,6 +201,11 @@ void SkeletalMesh::LoadStream(Stream& stream, Platform platform)
     mBounds.mCenter = stream.ReadVec3();
     mBounds.mRadius = stream.ReadFloat();
     mBoundsScale = stream.ReadFloat();
+
+    if (mVersion >= ASSET_VERSION_SKELETAL_MESH_BAKE_RATE)
+    {
+        mBakeSampleRate = stream.ReadFloat();
+    }
 }
 
 void SkeletalMesh::SaveStream(Stream& stream, Platform platform)
@@ -274,6 +313,7 @@ void SkeletalMesh::SaveStream(Stream& stream, Platform platform)
     stream.WriteVec3(mBounds.mCenter);
     stream.WriteFloat(mBounds.mRadius);
     stream.WriteFloat(mBoundsScale);
+    stream.WriteFloat(mBakeSampleRate);
 #endif
 }
 
@@ -286,6 +326,8 @@ void SkeletalMesh::Create()
     GFX_CreateSkeletalMeshResource(this, mNumVertices, mVertices.data(), mNumIndices, mIndices.data());
 
     InitBindPose();
+    BakeAnimations();
+    InitSkinningStreams();
 }
 
 void SkeletalMesh::Destroy()
@@ -363,6 +405,7 @@ void SkeletalMesh::GatherProperties(std::vector<Property>& outProps)
     outProps.push_back(Property(DatumType::Asset, "Material", this, &mMaterial, 1, HandlePropChange, int32_t(Material::GetStaticType())));
     outProps.push_back(Property(DatumType::Asset, "Animation Lookup", this, &mAnimationLookupMesh, 1, HandlePropChange, int32_t(SkeletalMesh::GetStaticType())));
     outProps.push_back(Property(DatumType::Float, "Bounds Scale", this, &mBoundsScale, 1, HandlePropChange));
+    outProps.push_back(Property(DatumType::Float, "Bake Sample Rate", this, &mBakeSampleRate, 1, HandlePropChange));
 
     // TODO: Do we want default animations?
     //outProps.push_back(Property(DatumType::String, "Default Animation", this, &mDefaultAnimation));
@@ -485,6 +528,16 @@ const std::vector<VertexSkinned>& SkeletalMesh::GetVertices() const
     return mVertices;
 }
 
+const std::vector<glm::vec4>& SkeletalMesh::GetSkinningPositions() const
+{
+    return mSkinningPositions;
+}
+
+const std::vector<glm::vec4>& SkeletalMesh::GetSkinningNormals() const
+{
+    return mSkinningNormals;
+}
+
 void SkeletalMesh::FinalizeBoneTransforms(std::vector<glm::mat4>& inoutTransforms)
 {
     // Iterate through each bone and if it has a parent bone, concatenate 
@@ -547,6 +600,22 @@ void SkeletalMesh::SetAnimationLookupMesh(SkeletalMesh* lookupMesh)
     mAnimationLookupMesh = lookupMesh;
 }
 
+float SkeletalMesh::GetBakeSampleRate() const
+{
+    return mBakeSampleRate;
+}
+
+void SkeletalMesh::SetBakeSampleRate(float sampleRate)
+{
+    sampleRate = glm::max(sampleRate, 0.0f);
+
+    if (mBakeSampleRate != sampleRate)
+    {
+        mBakeSampleRate = sampleRate;
+        BakeAnimations();
+    }
+}
+
 void SkeletalMesh::InitBindPose()
 {
     mBindPoseMatrices.clear();
@@ -578,6 +647,92 @@ void SkeletalMesh::InitBindPose()
 #endif
 }
 
+void SkeletalMesh::BakeAnimations()
+{
+    // Resample every channel at (at least) mBakeSampleRate samples per second. Baked animations can be sampled
+    // in constant time, which matters for long clips with dense keys, at the cost of extra memory.
+    for (uint32_t animIndex = 0; animIndex < mAnimations.size(); ++animIndex)
+    {
+        Animation& animation = mAnimations[animIndex];
+        bool bake = (mBakeSampleRate > 0.0f &&
+            animation.mTicksPerSecond > 0.0f &&
+            animation.mDuration > 0.0f);
+
+        // Round the sample rate up so that a whole number of uniform intervals spans the duration
+        // and the last sample lands exactly on it.
+        uint32_t numIntervals = bake ? glm::max(uint32_t(glm::ceil(animation.mDuration * mBakeSampleRate / animation.mTicksPerSecond)), 1u) : 0;
+        uint32_t numSamples = bake ? (numIntervals + 1) : 0;
+        animation.mBakedInterval = bake ? (animation.mDuration / float(numIntervals)) : 0.0f;
+
+        for (uint32_t chanIndex = 0; chanIndex < animation.mChannels.size(); ++chanIndex)
+        {
+            Channel& channel = animation.mChannels[chanIndex];
+            bool validKeys = (channel.mPositionKeys.size() > 0 &&
+                channel.mRotationKeys.size() > 0 &&
+                channel.mScaleKeys.size() > 0);
+
+            uint32_t numChannelSamples = validKeys ? numSamples : 0;
+            channel.mBakedPositions.resize(numChannelSamples);
+            channel.mBakedRotations.resize(numChannelSamples);
+            channel.mBakedScales.resize(numChannelSamples);
+            channel.mBakedPositions.shrink_to_fit();
+            channel.mBakedRotations.shrink_to_fit();
+            channel.mBakedScales.shrink_to_fit();
+
+            uint32_t posIndex = 0;
+            uint32_t rotIndex = 0;
+            uint32_t scaleIndex = 0;
+
+            for (uint32_t i = 0; i < numChannelSamples; ++i)
+            {
+                float time = i * animation.mBakedInterval;
+
+                float posFactor = FindBakeKeys(channel.mPositionKeys, time, posIndex);
+                float rotFactor = FindBakeKeys(channel.mRotationKeys, time, rotIndex);
+                float scaleFactor = FindBakeKeys(channel.mScaleKeys, time, scaleIndex);
+
+                uint32_t nextPos = glm::min<uint32_t>(posIndex + 1, uint32_t(channel.mPositionKeys.size() - 1));
+                uint32_t nextRot = glm::min<uint32_t>(rotIndex + 1, uint32_t(channel.mRotationKeys.size() - 1));
+                uint32_t nextScale = glm::min<uint32_t>(scaleIndex + 1, uint32_t(channel.mScaleKeys.size() - 1));
+
+                channel.mBakedPositions[i] = glm::mix(channel.mPositionKeys[posIndex].mValue, channel.mPositionKeys[nextPos].mValue, posFactor);
+                channel.mBakedRotations[i] = glm::normalize(glm::slerp(channel.mRotationKeys[rotIndex].mValue, channel.mRotationKeys[nextRot].mValue, rotFactor));
+                channel.mBakedScales[i] = glm::mix(channel.mScaleKeys[scaleIndex].mValue, channel.mScaleKeys[nextScale].mValue, scaleFactor);
+            }
+        }
+    }
+}
+
+void SkeletalMesh::InitSkinningStreams()
+{
+    // The SSE skinning kernel reads positions and normals from these arrays, one SIMD load each.
+    // Meshes that fit in the GPU bone palette are skinned on the GPU and never touch them, and
+    // the scalar kernel reads the interleaved vertices directly.
+#if SIMD_SSE
+    bool cpuSkinned = (mBones.size() > MAX_GPU_BONES);
+#else
+    bool cpuSkinned = false;
+#endif
+
+    if (!cpuSkinned)
+    {
+        mSkinningPositions.clear();
+        mSkinningNormals.clear();
+        mSkinningPositions.shrink_to_fit();
+        mSkinningNormals.shrink_to_fit();
+        return;
+    }
+
+    mSkinningPositions.resize(mVertices.size());
+    mSkinningNormals.resize(mVertices.size());
+
+    for (uint32_t i = 0; i < mVertices.size(); ++i)
+    {
+        mSkinningPositions[i] = glm::vec4(mVertices[i].mPosition, 1.0f);
+        mSkinningNormals[i] = glm::vec4(mVertices[i].mNormal, 0.0f);
+    }
+}
+
 void SkeletalMesh::ComputeBounds()
 {
     if (mNumVertices == 0)
@@ -938,6 +1093,7 @@ void SkeletalMesh::SetupAnimations(const aiScene& scene)
     }
 
     InitBindPose();
+    BakeAnimations();
 }
 
 void SkeletalMesh::SetupResource(const aiMesh& meshData,
@@ -71,6 +71,12 @@ struct Channel
     std::vector<PositionKey> mPositionKeys;
     std::vector<RotationKey> mRotationKeys;
     std::vector<ScaleKey> mScaleKeys;
+
+    // Keys resampled at a fixed interval so they can be indexed directly.
+    // Only filled when the owning mesh has a bake sample rate.
+    std::vector<glm::vec3> mBakedPositions;
+    std::vector<glm::quat> mBakedRotations;
+    std::vector<glm::vec3> mBakedScales;
 };
 
 struct Animation
@@ -80,6 +86,7 @@ struct Animation
     float mTicksPerSecond = 0.0f;
     std::vector<Channel> mChannels;
     std::vector<AnimEventTrack> mEventTracks;
+    float mBakedInterval = 0.0f; // In ticks, 0 if the animation is not baked.
 };
 
 class SkeletalMesh : public Asset
@@ -127,6 +134,8 @@ public:
     float GetAnimationDuration(const char* name);
 
     const std::vector<VertexSkinned>& GetVertices() const;
+    const std::vector<glm::vec4>& GetSkinningPositions() const;
+    const std::vector<glm::vec4>& GetSkinningNormals() const;
 
     void FinalizeBoneTransforms(std::vector<glm::mat4>& inoutTransforms);
 
@@ -139,12 +148,17 @@ public:
     SkeletalMesh* GetAnimationLookupMesh();
     void SetAnimationLookupMesh(SkeletalMesh* lookupMesh);
 
+    float GetBakeSampleRate() const;
+    void SetBakeSampleRate(float sampleRate);
+
     static bool HandlePropChange(Datum* datum, uint32_t index, const void* newValue);
 
 private:
 
     void InitBindPose();
     void ComputeBounds();
+    void BakeAnimations();
+    void InitSkinningStreams();
 
     MaterialRef mMaterial;
     SkeletalMeshRef mAnimationLookupMesh;
@@ -155,6 +169,8 @@ private:
     std::vector<Bone> mBones;
     std::vector<Animation> mAnimations;
     std::vector<VertexSkinned> mVertices;
+    std::vector<glm::vec4> mSkinningPositions;
+    std::vector<glm::vec4> mSkinningNormals;
 
     glm::mat4 mInvRootTransform;
     std::vector<glm::mat4> mBindPoseMatrices;
@@ -162,6 +178,7 @@ private:
 
     Bounds mBounds;
     float mBoundsScale = 1.1f;
+    float mBakeSampleRate = 0.0f;
 
     // Graphics Resource
     SkeletalMeshResource mResource;
@@ -22,6 +22,13 @@ using namespace std;
 FORCE_LINK_DEF(StaticMesh);
 DEFINE_ASSET(StaticMesh);
 
+// Vertices and indices are serialized as packed little endian fields in the same order as the
+// vertex structs, so when no byte swapping is needed they can be read straight into place.
+static const bool kBulkVertexCopy = !ENDIAN_SWAP &&
+    sizeof(Vertex) == 10 * sizeof(float) &&
+    sizeof(VertexColor) == 10 * sizeof(float) + sizeof(uint32_t);
+static const bool kBulkIndexCopy = !ENDIAN_SWAP && sizeof(IndexType) == sizeof(uint32_t);
+
 bool StaticMesh::HandlePropChange(Datum* datum, uint32_t index, const void* newValue)
 {
     Property* prop = static_cast<Property*>(datum);
@@ -115,21 +122,44 @@ void StaticMesh::LoadStream(Stream& stream, Platform platform)
     mPureVertexColors.clear();
 #endif
 
+    // Since the aligned layout was added, vertex and index blobs start on an aligned offset.
+    // The data itself has always been tightly packed little endian fields that match our vertex
+    // structs, so every version can be bulk copied unless the platform needs byte swapping.
+    bool alignedBulkData = (mVersion >= ASSET_VERSION_ALIGNED_BULK_DATA);
+
+    if (alignedBulkData)
+    {
+        stream.AlignRead(ASSET_BULK_DATA_ALIGNMENT);
+    }
+
     if (mHasVertexColor)
     {
         VertexColor* vertices = GetColorVertices();
-        for (uint32_t i = 0; i < mNumVertices; ++i)
+
+        if (kBulkVertexCopy)
+        {
+            stream.ReadBytes((uint8_t*)vertices, mNumVertices * sizeof(VertexColor));
+        }
+        else
         {
-            vertices[i].mPosition = stream.ReadVec3();
-            vertices[i].mTexcoord0 = stream.ReadVec2();
-            vertices[i].mTexcoord1 = stream.ReadVec2();
-            vertices[i].mNormal = stream.ReadVec3();
-            vertices[i].mColor = stream.ReadUint32();
+            for (uint32_t i = 0; i < mNumVertices; ++i)
+            {
+                vertices[i].mPosition = stream.ReadVec3();
+                vertices[i].mTexcoord0 = stream.ReadVec2();
+                vertices[i].mTexcoord1 = stream.ReadVec2();
+                vertices[i].mNormal = stream.ReadVec3();
+                vertices[i].mColor = stream.ReadUint32();
+            }
+        }
+
 #if EDITOR
-            // Cache these to save later. Should not be affected by color scale config.
-            mPureVertexColors.push_back(vertices[i].mColor);
-#endif
+        // Cache these to save later. Should not be affected by color scale config.
+        mPureVertexColors.resize(mNumVertices);
+        for (uint32_t i = 0; i < mNumVertices; ++i)
+        {
+            mPureVertexColors[i] = vertices[i].mColor;
         }
+#endif
 
         // Only allow vertex colors to go beyond 1.0 when painted.
         // For meshes with vertex colors, convert to reduced color space.
@@ -150,19 +180,40 @@ void StaticMesh::LoadStream(Stream& stream, Platform platform)
     else
     {
         Vertex* vertices = GetVertices();
-        for (uint32_t i = 0; i < mNumVertices; ++i)
+
+        if (kBulkVertexCopy)
+        {
+            stream.ReadBytes((uint8_t*)vertices, mNumVertices * sizeof(Vertex));
+        }
+        else
         {
-            vertices[i].mPosition = stream.ReadVec3();
-            vertices[i].mTexcoord0 = stream.ReadVec2();
-            vertices[i].mTexcoord1 = stream.ReadVec2();
-            vertices[i].mNormal = stream.ReadVec3();
+            for (uint32_t i = 0; i < mNumVertices; ++i)
+            {
+                vertices[i].mPosition = stream.ReadVec3();
+                vertices[i].mTexcoord0 = stream.ReadVec2();
+                vertices[i].mTexcoord1 = stream.ReadVec2();
+                vertices[i].mNormal = stream.ReadVec3();
+            }
         }
     }
 
     ResizeIndexArray(mNumIndices);
-    for (uint32_t i = 0; i < mNumIndices; ++i)
+
+    if (alignedBulkData)
     {
-        mIndices[i] = (IndexType) stream.ReadUint32();
+        stream.AlignRead(ASSET_BULK_DATA_ALIGNMENT);
+    }
+
+    if (kBulkIndexCopy)
+    {
+        stream.ReadBytes((uint8_t*)mIndices, mNumIndices * sizeof(IndexType));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < mNumIndices; ++i)
+        {
+            mIndices[i] = (IndexType) stream.ReadUint32();
+        }
     }
 
     // Collision shapes
@@ -254,6 +305,8 @@ void StaticMesh::SaveStream(Stream& stream, Platform platform)
     stream.WriteBool(mGenerateTriangleCollisionMesh);
     stream.WriteBool(mHasVertexColor);
 
+    stream.AlignWrite(ASSET_BULK_DATA_ALIGNMENT);
+
     if (mHasVertexColor)
     {
         VertexColor* vertices = GetColorVertices();
@@ -280,6 +333,8 @@ void StaticMesh::SaveStream(Stream& stream, Platform platform)
         }
     }
 
+    stream.AlignWrite(ASSET_BULK_DATA_ALIGNMENT);
+
     for (uint32_t i = 0; i < mNumIndices; ++i)
     {
         stream.WriteUint32(mIndices[i]);
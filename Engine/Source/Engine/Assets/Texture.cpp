@@ -384,6 +384,12 @@ void Texture::LoadStream(Stream& stream, Platform platform)
 
         uint32_t cookedDataSize = stream.ReadUint32();
         mPixels.resize(cookedDataSize);
+
+        if (mVersion >= ASSET_VERSION_ALIGNED_BULK_DATA)
+        {
+            stream.AlignRead(ASSET_BULK_DATA_ALIGNMENT);
+        }
+
         stream.ReadBytes(mPixels.data(), cookedDataSize);
     }
     else
@@ -391,10 +397,13 @@ void Texture::LoadStream(Stream& stream, Platform platform)
         int32_t size = (mWidth * mHeight * RGBA8_SIZE);
         mPixels.resize(size);
 
-        for (int32_t i = 0; i < size; ++i)
+        if (mVersion >= ASSET_VERSION_ALIGNED_BULK_DATA)
         {
-            mPixels[i] = stream.ReadUint8();
+            stream.AlignRead(ASSET_BULK_DATA_ALIGNMENT);
         }
+
+        // Pixels are single bytes, so they never need swapping and can be copied in one go.
+        stream.ReadBytes(mPixels.data(), uint32_t(size));
     }
 }
 
@@ -436,16 +445,15 @@ void Texture::SaveStream(Stream& stream, Platform platform)
 
         uint32_t cookedDataSize = (uint32_t)cookedData.size();
         stream.WriteUint32(cookedDataSize);
+        stream.AlignWrite(ASSET_BULK_DATA_ALIGNMENT);
         stream.WriteBytes(cookedData.data(), cookedDataSize);
     }
     else
     {
         // If not using an custom formats, just write out the raw RGBA8 pixels, uncompressed.
         OCT_ASSERT(mPixels.size() == (mWidth * mHeight * RGBA8_SIZE));
-        for (int32_t i = 0; i < int32_t(mPixels.size()); ++i)
-        {
-            stream.WriteUint8(mPixels[i]);
-        }
+        stream.AlignWrite(ASSET_BULK_DATA_ALIGNMENT);
+        stream.WriteBytes(mPixels.data(), (uint32_t)mPixels.size());
     }
 #endif
 }
@@ -0,0 +1,201 @@
+#include "BitStream.h"
+#include "Assertion.h"
+
+#include <string.h>
+
+BitStream::BitStream()
+{
+
+}
+
+BitStream::BitStream(const uint8_t* data, uint32_t size)
+{
+    mReadData = data;
+    mNumBits = size * 8;
+}
+
+void BitStream::Clear()
+{
+    mBuffer.clear();
+    mNumBits = 0;
+    mReadBit = 0;
+    mOverflowed = false;
+}
+
+void BitStream::WriteBits(uint32_t value, uint32_t numBits)
+{
+    OCT_ASSERT(mReadData == nullptr);
+    OCT_ASSERT(numBits <= 32);
+
+    if (numBits < 32)
+    {
+        value &= (1u << numBits) - 1;
+    }
+
+    while (numBits > 0)
+    {
+        uint32_t bitInByte = mNumBits & 7;
+        if (bitInByte == 0)
+        {
+            mBuffer.push_back(0);
+        }
+
+        uint32_t bitsToWrite = 8 - bitInByte;
+        bitsToWrite = (bitsToWrite < numBits) ? bitsToWrite : numBits;
+
+        mBuffer.back() |= uint8_t((value & ((1u << bitsToWrite) - 1)) << bitInByte);
+
+        value >>= bitsToWrite;
+        numBits -= bitsToWrite;
+        mNumBits += bitsToWrite;
+    }
+}
+
+void BitStream::WriteBool(bool value)
+{
+    WriteBits(value ? 1 : 0, 1);
+}
+
+void BitStream::WriteFloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteBits(bits, 32);
+}
+
+void BitStream::WriteVarUint(uint32_t value, uint32_t groupBits)
+{
+    OCT_ASSERT(groupBits > 0 && groupBits < 32);
+
+    while (true)
+    {
+        uint32_t group = value & ((1u << groupBits) - 1);
+        value >>= groupBits;
+
+        WriteBits(group, groupBits);
+        WriteBool(value != 0);
+
+        if (value == 0)
+            break;
+    }
+}
+
+void BitStream::WriteVarInt(int32_t value, uint32_t groupBits)
+{
+    // Zigzag so that small negative numbers stay small.
+    uint32_t zigzag = (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+    WriteVarUint(zigzag, groupBits);
+}
+
+void BitStream::WriteStreamBits(const BitStream& src, uint32_t bitOffset, uint32_t numBits)
+{
+    OCT_ASSERT(bitOffset + numBits <= src.mNumBits);
+    const uint8_t* srcData = src.GetData();
+
+    while (numBits > 0)
+    {
+        uint32_t chunk = (numBits < 8) ? numBits : 8;
+
+        // Gather up to 8 bits which may straddle two source bytes.
+        uint32_t byteIndex = bitOffset >> 3;
+        uint32_t bitInByte = bitOffset & 7;
+        uint32_t value = srcData[byteIndex] >> bitInByte;
+        if (bitInByte + chunk > 8)
+        {
+            value |= uint32_t(srcData[byteIndex + 1]) << (8 - bitInByte);
+        }
+
+        WriteBits(value, chunk);
+
+        bitOffset += chunk;
+        numBits -= chunk;
+    }
+}
+
+uint32_t BitStream::ReadBits(uint32_t numBits)
+{
+    OCT_ASSERT(numBits <= 32);
+
+    if (mReadBit + numBits > mNumBits)
+    {
+        mOverflowed = true;
+        mReadBit = mNumBits;
+        return 0;
+    }
+
+    const uint8_t* data = GetData();
+    uint32_t value = 0;
+    uint32_t shift = 0;
+
+    while (numBits > 0)
+    {
+        uint32_t bitInByte = mReadBit & 7;
+        uint32_t bitsToRead = 8 - bitInByte;
+        bitsToRead = (bitsToRead < numBits) ? bitsToRead : numBits;
+
+        uint32_t bits = (data[mReadBit >> 3] >> bitInByte) & ((1u << bitsToRead) - 1);
+        value |= bits << shift;
+
+        shift += bitsToRead;
+        numBits -= bitsToRead;
+        mReadBit += bitsToRead;
+    }
+
+    return value;
+}
+
+bool BitStream::ReadBool()
+{
+    return ReadBits(1) != 0;
+}
+
+float BitStream::ReadFloat()
+{
+    uint32_t bits = ReadBits(32);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint32_t BitStream::ReadVarUint(uint32_t groupBits)
+{
+    uint32_t value = 0;
+    uint32_t shift = 0;
+
+    while (shift < 32)
+    {
+        value |= ReadBits(groupBits) << shift;
+        shift += groupBits;
+
+        if (!ReadBool())
+            break;
+    }
+
+    return value;
+}
+
+int32_t BitStream::ReadVarInt(uint32_t groupBits)
+{
+    uint32_t zigzag = ReadVarUint(groupBits);
+    return int32_t(zigzag >> 1) ^ -int32_t(zigzag & 1);
+}
+
+const uint8_t* BitStream::GetData() const
+{
+    return (mReadData != nullptr) ? mReadData : mBuffer.data();
+}
+
+uint32_t BitStream::GetNumBits() const
+{
+    return mNumBits;
+}
+
+uint32_t BitStream::GetNumBytes() const
+{
+    return (mNumBits + 7) / 8;
+}
+
+bool BitStream::IsOverflowed() const
+{
+    return mOverflowed;
+}
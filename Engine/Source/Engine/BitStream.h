@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Packs values into a byte buffer using only as many bits as they need.
+// Bits are filled from the least significant bit of each byte, so the
+// layout is the same on little and big endian platforms.
+class BitStream
+{
+public:
+
+    // Write mode. The stream owns a growable buffer.
+    BitStream();
+
+    // Read mode over external data, which must outlive the stream.
+    BitStream(const uint8_t* data, uint32_t size);
+
+    void Clear();
+
+    void WriteBits(uint32_t value, uint32_t numBits);
+    void WriteBool(bool value);
+    void WriteFloat(float value);
+
+    // Variable length unsigned int written in groups of groupBits, each followed by a continue bit.
+    // Small groups suit values that are usually tiny, larger groups suit values that are usually big.
+    void WriteVarUint(uint32_t value, uint32_t groupBits = 4);
+    void WriteVarInt(int32_t value, uint32_t groupBits = 4);
+
+    // Appends a range of bits from another stream.
+    void WriteStreamBits(const BitStream& src, uint32_t bitOffset, uint32_t numBits);
+
+    uint32_t ReadBits(uint32_t numBits);
+    bool ReadBool();
+    float ReadFloat();
+    uint32_t ReadVarUint(uint32_t groupBits = 4);
+    int32_t ReadVarInt(uint32_t groupBits = 4);
+
+    const uint8_t* GetData() const;
+    uint32_t GetNumBits() const;
+    uint32_t GetNumBytes() const;
+
+    // True if a read went past the end of the data. Reads past the end return 0.
+    bool IsOverflowed() const;
+
+protected:
+
+    std::vector<uint8_t> mBuffer;
+    const uint8_t* mReadData = nullptr;
+    uint32_t mNumBits = 0;
+    uint32_t mReadBit = 0;
+    bool mOverflowed = false;
+};
@@ -0,0 +1,129 @@
+#include "BoundsTree.h"
+#include "CameraFrustum.h"
+#include "Utilities.h"
+
+struct FrustumQueryPolicy : btDbvt::ICollide
+{
+    const CameraFrustum* mFrustum = nullptr;
+    std::vector<Node3D*>* mOutNodes = nullptr;
+
+    bool Descent(const btDbvtNode* node) override
+    {
+        // Test the bounding sphere of the node's AABB. This is conservative, but it lets us
+        // reuse the same sphere tests that the renderer uses for individual draws.
+        glm::vec3 center = BulletToGlm(node->volume.Center());
+        float radius = node->volume.Extents().length();
+
+        return mFrustum->mOrtho ?
+            mFrustum->IsSphereInFrustumOrtho(center, radius) :
+            mFrustum->IsSphereInFrustum(center, radius);
+    }
+
+    void Process(const btDbvtNode* leaf) override
+    {
+        mOutNodes->push_back((Node3D*)leaf->data);
+    }
+};
+
+struct GatherPolicy : btDbvt::ICollide
+{
+    std::vector<Node3D*>* mOutNodes = nullptr;
+
+    void Process(const btDbvtNode* leaf) override
+    {
+        mOutNodes->push_back((Node3D*)leaf->data);
+    }
+};
+
+static btDbvtVolume BoundsToVolume(const Bounds& bounds)
+{
+    return btDbvtVolume::FromCR(GlmToBullet(bounds.mCenter), bounds.mRadius);
+}
+
+BoundsTree::BoundsTree()
+{
+
+}
+
+BoundsTree::~BoundsTree()
+{
+    Clear();
+}
+
+void BoundsTree::Update(Node3D* node, const Bounds& bounds)
+{
+    btDbvtVolume volume = BoundsToVolume(bounds);
+    auto it = mLeafMap.find(node);
+
+    if (it == mLeafMap.end())
+    {
+        volume.Expand(btVector3(mMargin, mMargin, mMargin));
+        btDbvtNode* leaf = mTree.insert(volume, node);
+        mLeafMap.insert({ node, leaf });
+    }
+    else
+    {
+        // Only reinserts the leaf if the new bounds escaped the fattened leaf volume.
+        mTree.update(it->second, volume, mMargin);
+    }
+}
+
+void BoundsTree::Remove(Node3D* node)
+{
+    auto it = mLeafMap.find(node);
+
+    if (it != mLeafMap.end())
+    {
+        mTree.remove(it->second);
+        mLeafMap.erase(it);
+    }
+}
+
+void BoundsTree::Clear()
+{
+    mTree.clear();
+    mLeafMap.clear();
+}
+
+bool BoundsTree::Contains(Node3D* node) const
+{
+    return mLeafMap.find(node) != mLeafMap.end();
+}
+
+uint32_t BoundsTree::GetNumNodes() const
+{
+    return (uint32_t)mLeafMap.size();
+}
+
+void BoundsTree::QueryFrustum(const CameraFrustum& frustum, std::vector<Node3D*>& outNodes) const
+{
+    FrustumQueryPolicy policy;
+    policy.mFrustum = &frustum;
+    policy.mOutNodes = &outNodes;
+    btDbvt::collideTU(mTree.m_root, policy);
+}
+
+void BoundsTree::QuerySphere(glm::vec3 center, float radius, std::vector<Node3D*>& outNodes) const
+{
+    GatherPolicy policy;
+    policy.mOutNodes = &outNodes;
+    btDbvtVolume volume = btDbvtVolume::FromCR(GlmToBullet(center), radius);
+    mTree.collideTV(mTree.m_root, volume, policy);
+}
+
+void BoundsTree::GatherAll(std::vector<Node3D*>& outNodes) const
+{
+    GatherPolicy policy;
+    policy.mOutNodes = &outNodes;
+    btDbvt::enumLeaves(mTree.m_root, policy);
+}
+
+void BoundsTree::SetMargin(float margin)
+{
+    mMargin = margin;
+}
+
+float BoundsTree::GetMargin() const
+{
+    return mMargin;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+
+#include "EngineTypes.h"
+
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
+
+class Node3D;
+class CameraFrustum;
+
+// Incrementally maintained bounding volume hierarchy of node bounds.
+// Leaves are stored with a small margin so that nodes that only move a little
+// don't need to be reinserted every time their bounds are updated.
+class BoundsTree
+{
+public:
+
+    BoundsTree();
+    ~BoundsTree();
+
+    // Inserts the node if it isn't in the tree yet, otherwise refits its leaf.
+    void Update(Node3D* node, const Bounds& bounds);
+    void Remove(Node3D* node);
+    void Clear();
+
+    bool Contains(Node3D* node) const;
+    uint32_t GetNumNodes() const;
+
+    void QueryFrustum(const CameraFrustum& frustum, std::vector<Node3D*>& outNodes) const;
+    void QuerySphere(glm::vec3 center, float radius, std::vector<Node3D*>& outNodes) const;
+    void GatherAll(std::vector<Node3D*>& outNodes) const;
+
+    void SetMargin(float margin);
+    float GetMargin() const;
+
+protected:
+
+    btDbvt mTree;
+    std::unordered_map<Node3D*, btDbvtNode*> mLeafMap;
+    float mMargin = 0.5f;
+};
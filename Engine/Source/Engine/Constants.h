@@ -58,5 +58,18 @@
 #define ASSET_LIVE_REF_TRACKING 0
 #endif
 
+// SSE2 kernels for hot loops (skinning, particles). Every x64 CPU has SSE2.
+#if (PLATFORM_WINDOWS || PLATFORM_LINUX) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define SIMD_SSE 1
+#else
+#define SIMD_SSE 0
+#endif
+
+// Single small values are stored inside the Datum instead of on the heap.
+// Build with DATUM_INLINE_STORAGE=0 to measure the heap path with -datumbench.
+#ifndef DATUM_INLINE_STORAGE
+#define DATUM_INLINE_STORAGE 1
+#endif
+
 #define LUA_ENABLED 1
 #define LUA_TYPE_CHECK 1
@@ -13,6 +13,10 @@
 
 #include "System/System.h"
 
+#include <atomic>
+
+static std::atomic<uint32_t> sNumHeapAllocations(0);
+
 const Datum Datum::sNullDatum = Datum();
 
 Datum::Datum()
@@ -1761,10 +1765,24 @@ void Datum::Reserve(uint32_t capacity)
         }
 
         DatumData prevData = mData;
+        bool prevInline = IsInline();
 
         mCapacity = capacity;
         uint32_t typeSize = GetDataTypeSize();
-        mData.vp = SYS_AlignedMalloc(mCapacity * typeSize, 4);
+
+        if (DATUM_INLINE_STORAGE &&
+            mCapacity == 1 &&
+            typeSize <= sizeof(mInlineData) &&
+            mType != DatumType::String &&
+            mType != DatumType::Table)
+        {
+            mData.vp = mInlineData;
+        }
+        else
+        {
+            mData.vp = SYS_AlignedMalloc(mCapacity * typeSize, 4);
+            sNumHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
 
         if (prevData.vp != nullptr)
         {
@@ -1786,7 +1804,11 @@ void Datum::Reserve(uint32_t capacity)
                 memcpy(mData.vp, prevData.vp, typeSize * mCount);
             }
 
-            SYS_AlignedFree(prevData.vp);
+            if (!prevInline)
+            {
+                SYS_AlignedFree(prevData.vp);
+            }
+
             prevData.vp = nullptr;
         }
     }
@@ -1805,13 +1827,27 @@ void Datum::Destroy()
             DestructData(mData, i);
         }
 
-        SYS_AlignedFree(mData.vp);
+        if (!IsInline())
+        {
+            SYS_AlignedFree(mData.vp);
+        }
+
         mData.vp = nullptr;
     }
 
     Reset();
 }
 
+bool Datum::IsInline() const
+{
+    return (mData.vp == mInlineData);
+}
+
+uint32_t Datum::GetNumHeapAllocations()
+{
+    return sNumHeapAllocations.load(std::memory_order_relaxed);
+}
+
 void Datum::DeepCopy(const Datum& src, bool forceInternalStorage)
 {
     mType = src.mType;
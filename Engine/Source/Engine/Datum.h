@@ -369,9 +369,14 @@ public:
 
     static const Datum sNullDatum;
 
+    // Number of times a Datum has allocated heap storage. Used to measure how often values
+    // spill out of the inline storage (see DATUM_INLINE_STORAGE).
+    static uint32_t GetNumHeapAllocations();
+
 protected:
 
     void Reserve(uint32_t capacity);
+    bool IsInline() const;
 
     void PreSet(uint32_t index, DatumType type);
     void PreSetExternal(DatumType type);
@@ -397,4 +402,8 @@ public:
     DatumChangeHandlerFP mChangeHandler = nullptr;
     uint8_t mCount = 0;
     uint8_t mCapacity = 0;
+
+    // Storage for a single small element (anything but strings and tables) so that one-value
+    // Datums like signal args, script call params and replicated values don't hit the heap.
+    uint64_t mInlineData[2] = {};
 };
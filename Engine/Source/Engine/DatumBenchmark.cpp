@@ -0,0 +1,107 @@
+#include "DatumBenchmark.h"
+#include "Datum.h"
+#include "Signals.h"
+#include "ScriptFunc.h"
+#include "Engine.h"
+#include "Log.h"
+#include "Nodes/Node.h"
+
+#include "System/System.h"
+
+struct DatumBenchResult
+{
+    float mAllocsPerIteration = 0.0f;
+    float mUsPerIteration = 0.0f;
+};
+
+static void DatumBenchHandler(Node* listener, const Datum* args, uint32_t numArgs)
+{
+
+}
+
+static DatumBenchResult MeasureDatumIterations(Node* sender, SignalId signal, const ScriptFunc& returnFunc, uint32_t iterations)
+{
+    uint32_t startAllocs = Datum::GetNumHeapAllocations();
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sender->EmitSignal(signal, { Datum(float(i)), Datum(glm::vec3(1.0f, 2.0f, 3.0f)), Datum(sender) });
+
+        if (returnFunc.IsValid())
+        {
+            Datum params[2] = { Datum(int32_t(i)), Datum(0.5f) };
+            Datum ret = returnFunc.CallR(2, params);
+        }
+    }
+
+    uint64_t elapsed = SYS_GetTimeMicroseconds() - startTime;
+    uint32_t allocs = Datum::GetNumHeapAllocations() - startAllocs;
+
+    DatumBenchResult result;
+    result.mAllocsPerIteration = float(allocs) / iterations;
+    result.mUsPerIteration = float(elapsed) / iterations;
+    return result;
+}
+
+void RunDatumBenchmark(uint32_t iterations)
+{
+    iterations = glm::max<uint32_t>(iterations, 1);
+
+    NodePtr sender = Node::Construct(Node::GetStaticType());
+    NodePtr receiver = Node::Construct(Node::GetStaticType());
+    SignalId signal = InternSignal("DatumBench");
+    ScriptFunc handlerFunc;
+    ScriptFunc returnFunc;
+
+    sender->ConnectSignal(signal, receiver.Get(), DatumBenchHandler);
+
+#if LUA_ENABLED
+    lua_State* L = GetLua();
+    if (L != nullptr &&
+        luaL_dostring(L, "function DatumBenchHandler(self, a, b, c) end\nfunction DatumBenchReturn(a, b) return a + b end") == LUA_OK)
+    {
+        lua_getglobal(L, "DatumBenchHandler");
+        handlerFunc = ScriptFunc(L, -1);
+        lua_pop(L, 1);
+
+        lua_getglobal(L, "DatumBenchReturn");
+        returnFunc = ScriptFunc(L, -1);
+        lua_pop(L, 1);
+
+        // Signal connections are keyed by listener, so the script handler needs its own node.
+        sender->ConnectSignal(signal, sender.Get(), handlerFunc);
+    }
+    else
+    {
+        LogWarning("Datum benchmark is running without script calls");
+    }
+#endif
+
+    // Warm up anything that's created lazily, like the nodes' script userdata.
+    MeasureDatumIterations(sender.Get(), signal, returnFunc, 1);
+
+    DatumBenchResult result = MeasureDatumIterations(sender.Get(), signal, returnFunc, iterations);
+
+    LogDebug("---- Datum Benchmark (%u iterations, script calls %s, inline storage %s) ----", iterations, returnFunc.IsValid() ? "on" : "off", DATUM_INLINE_STORAGE ? "on" : "off");
+    LogDebug("%.2f allocs/iteration  %.3f us/iteration", result.mAllocsPerIteration, result.mUsPerIteration);
+
+    FILE* benchFile = fopen("DatumBench.csv", "w");
+
+    if (benchFile != nullptr)
+    {
+        fprintf(benchFile, "Iterations, %u\n", iterations);
+        fprintf(benchFile, "ScriptCalls, %d\n", returnFunc.IsValid() ? 1 : 0);
+        fprintf(benchFile, "InlineStorage, %d\n", DATUM_INLINE_STORAGE);
+        fprintf(benchFile, "AllocsPerIteration, %f\n", result.mAllocsPerIteration);
+        fprintf(benchFile, "UsPerIteration, %f\n", result.mUsPerIteration);
+        fclose(benchFile);
+    }
+    else
+    {
+        LogError("Failed to write DatumBench.csv");
+    }
+
+    Node::Destruct(sender.Get());
+    Node::Destruct(receiver.Get());
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+// Datum allocation benchmark, started with -datumbench <iterations>. Each iteration emits a
+// signal with typical arguments to a native and a script handler, and calls a script function
+// that returns a value. It logs the heap allocations and time per iteration and writes them to
+// DatumBench.csv. Compare against a build with DATUM_INLINE_STORAGE=0 to see the heap path.
+void RunDatumBenchmark(uint32_t iterations);
@@ -0,0 +1,169 @@
+#include "DrawList.h"
+#include "Assertion.h"
+
+#include <string.h>
+
+static const uint32_t kRadixBits = 8;
+static const uint32_t kRadixSize = 1 << kRadixBits;
+static const uint32_t kNumRadixPasses = 64 / kRadixBits;
+
+static inline uint32_t FloatToBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Squeezes a value down to a few bits for grouping. Collisions only cost a little extra state switching.
+static inline uint64_t HashBits(uint64_t value, uint32_t numBits)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    return value >> (64 - numBits);
+}
+
+void DrawList::Clear()
+{
+    mDraws.clear();
+    mKeys.clear();
+    mOrder.clear();
+}
+
+void DrawList::Reserve(uint32_t count)
+{
+    mDraws.reserve(count);
+    mKeys.reserve(count);
+    mOrder.reserve(count);
+}
+
+void DrawList::Add(const DrawData& data, uint64_t sortKey)
+{
+    mOrder.push_back((uint32_t)mDraws.size());
+    mKeys.push_back(sortKey);
+    mDraws.push_back(data);
+}
+
+void DrawList::Sort()
+{
+    uint32_t numKeys = (uint32_t)mKeys.size();
+    if (numKeys <= 1)
+        return;
+
+    // Build the histograms for every pass up front with a single read of the keys.
+    uint32_t histograms[kNumRadixPasses][kRadixSize];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (uint32_t i = 0; i < numKeys; ++i)
+    {
+        uint64_t key = mKeys[i];
+        for (uint32_t p = 0; p < kNumRadixPasses; ++p)
+        {
+            histograms[p][(key >> (p * kRadixBits)) & (kRadixSize - 1)]++;
+        }
+    }
+
+    mTempKeys.resize(numKeys);
+    mTempOrder.resize(numKeys);
+
+    for (uint32_t p = 0; p < kNumRadixPasses; ++p)
+    {
+        uint32_t* histogram = histograms[p];
+        uint32_t shift = p * kRadixBits;
+
+        // If every key has the same digit in this pass, it wouldn't move anything.
+        if (histogram[(mKeys[0] >> shift) & (kRadixSize - 1)] == numKeys)
+            continue;
+
+        uint32_t offset = 0;
+        for (uint32_t d = 0; d < kRadixSize; ++d)
+        {
+            uint32_t count = histogram[d];
+            histogram[d] = offset;
+            offset += count;
+        }
+
+        for (uint32_t i = 0; i < numKeys; ++i)
+        {
+            uint32_t dst = histogram[(mKeys[i] >> shift) & (kRadixSize - 1)]++;
+            mTempKeys[dst] = mKeys[i];
+            mTempOrder[dst] = mOrder[i];
+        }
+
+        mKeys.swap(mTempKeys);
+        mOrder.swap(mTempOrder);
+    }
+}
+
+void DrawList::MarkRemoved(uint32_t sortedIndex)
+{
+    OCT_ASSERT(sortedIndex < mOrder.size());
+    mOrder[sortedIndex] = kRemovedIndex;
+}
+
+void DrawList::Compact()
+{
+    uint32_t dst = 0;
+
+    for (uint32_t i = 0; i < mOrder.size(); ++i)
+    {
+        if (mOrder[i] != kRemovedIndex)
+        {
+            mOrder[dst] = mOrder[i];
+            mKeys[dst] = mKeys[i];
+            dst++;
+        }
+    }
+
+    mOrder.resize(dst);
+    mKeys.resize(dst);
+}
+
+uint32_t DrawList::GetNumDraws() const
+{
+    return (uint32_t)mOrder.size();
+}
+
+DrawData& DrawList::GetDraw(uint32_t sortedIndex)
+{
+    return mDraws[mOrder[sortedIndex]];
+}
+
+const DrawData& DrawList::GetDraw(uint32_t sortedIndex) const
+{
+    return mDraws[mOrder[sortedIndex]];
+}
+
+uint64_t DrawList::MakeOpaqueKey(const DrawData& data)
+{
+    // [63] depthless | [61-62] blend | [53-60] pipeline | [24-52] material | [0-23] depth
+    uint64_t depthless = data.mDepthless ? 1 : 0;
+    uint64_t blend = (uint64_t(BlendMode::Count) - 1 - uint64_t(data.mBlendMode)) & 0x3;
+    uint64_t pipeline = HashBits(data.mNodeType, 8);
+    uint64_t material = HashBits((uint64_t)(uintptr_t)data.mMaterial, 29);
+
+    // The bits of a positive float sort the same as its value, so the top bits make a cheap quantized depth.
+    uint64_t depth = FloatToBits(data.mDistance2) >> 7;
+
+    return (depthless << 63) |
+        (blend << 61) |
+        (pipeline << 53) |
+        (material << 24) |
+        depth;
+}
+
+uint64_t DrawList::MakeTranslucentKey(const DrawData& data, float distance2)
+{
+    // [63] depthless | [32-47] sort priority | [0-31] inverted depth (back to front)
+    uint64_t depthless = data.mDepthless ? 1 : 0;
+
+    int32_t priority = data.mSortPriority;
+    priority = (priority < INT16_MIN) ? INT16_MIN : ((priority > INT16_MAX) ? INT16_MAX : priority);
+    uint64_t biasedPriority = uint64_t(priority + 0x8000);
+
+    uint64_t depth = ~FloatToBits(distance2);
+
+    return (depthless << 63) |
+        (biasedPriority << 32) |
+        depth;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "EngineTypes.h"
+
+class Material;
+
+// The draws for one render pass. DrawData payloads are stored in the order they were added,
+// and a separate compact array of 64-bit sort keys + payload indices is what gets sorted.
+// Sorting and culling only ever move the 12 byte key/index pairs, never the payloads.
+class DrawList
+{
+public:
+
+    void Clear();
+    void Reserve(uint32_t count);
+
+    void Add(const DrawData& data, uint64_t sortKey = 0);
+
+    // Radix sorts the draws by key (ascending). Draws with equal keys keep their insertion order.
+    void Sort();
+
+    // Removes the draw at the given sorted position while keeping the rest in order.
+    // Call Compact() after marking all of the draws that should be removed.
+    void MarkRemoved(uint32_t sortedIndex);
+    void Compact();
+
+    uint32_t GetNumDraws() const;
+    DrawData& GetDraw(uint32_t sortedIndex);
+    const DrawData& GetDraw(uint32_t sortedIndex) const;
+
+    // Key builders. Lower keys are rendered first.
+    // Opaque: depthless last, then blend mode (masked before opaque), pipeline, material, and front-to-back depth.
+    static uint64_t MakeOpaqueKey(const DrawData& data);
+    // Translucent: depthless last, then sort priority, then back-to-front depth.
+    static uint64_t MakeTranslucentKey(const DrawData& data, float distance2);
+
+protected:
+
+    static const uint32_t kRemovedIndex = 0xffffffff;
+
+    std::vector<DrawData> mDraws;
+    std::vector<uint64_t> mKeys;
+    std::vector<uint32_t> mOrder;
+
+    // Scratch buffers for the radix sort.
+    std::vector<uint64_t> mTempKeys;
+    std::vector<uint32_t> mTempOrder;
+};
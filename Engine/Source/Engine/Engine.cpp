@@ -9,6 +9,10 @@
 #include "Assets/Scene.h"
 #include "AssetManager.h"
 #include "NetworkManager.h"
+#include "NetBenchmark.h"
+#include "Skinning.h"
+#include "ParticleSimulation.h"
+#include "DatumBenchmark.h"
 #include "AudioManager.h"
 #include "Constants.h"
 #include "Utilities.h"
@@ -17,6 +21,7 @@
 #include "ScriptAutoReg.h"
 #include "ScriptFunc.h"
 #include "TimerManager.h"
+#include "JobSystem.h"
 #include "Nodes/Widgets/Button.h"
 #include "FileWatcher.h"
 #include "ScriptUtils.h"
@@ -50,6 +55,7 @@ static EngineConfig sEngineConfig;
 
 static std::vector<World*> sWorlds;
 static Clock sClock;
+static NetBenchmark* sNetBenchmark = nullptr;
 
 // Default scene names to try when no explicit scene is specified
 static std::vector<std::string> sDefaultSceneNames = {
@@ -123,6 +129,8 @@ void OnScriptFileChanged(const FileChangeEvent& event)
             // Reload the specific script file
             if (ScriptUtils::ReloadScriptFile(relativePath))
             {
+                Script::InvalidateCallbacks(ScriptUtils::GetClassNameFromFileName(relativePath));
+
                 // Restart affected script instances from any nodes running in play mode
                 for (uint32_t i = 0; i < affectedScripts.size(); ++i)
                 {
@@ -258,6 +266,35 @@ void ReadCommandLineArgs(int32_t argc, char** argv)
         {
             sEngineConfig.mHeadless = true;
         }
+        else if (strcmp(argv[i], "-netbench") == 0)
+        {
+            OCT_ASSERT(i + 3 < argc);
+            sEngineConfig.mNetBenchClients = (uint32_t)glm::max(atoi(argv[i + 1]), 1);
+            sEngineConfig.mNetBenchNodes = (uint32_t)glm::max(atoi(argv[i + 2]), 0);
+            sEngineConfig.mNetBenchDuration = (float)atof(argv[i + 3]);
+            i += 3;
+        }
+        else if (strcmp(argv[i], "-skinbench") == 0)
+        {
+            OCT_ASSERT(i + 2 < argc);
+            sEngineConfig.mSkinBenchVertices = (uint32_t)glm::max(atoi(argv[i + 1]), 1);
+            sEngineConfig.mSkinBenchIterations = (uint32_t)glm::max(atoi(argv[i + 2]), 1);
+            i += 2;
+        }
+        else if (strcmp(argv[i], "-particlebench") == 0)
+        {
+            OCT_ASSERT(i + 3 < argc);
+            sEngineConfig.mParticleBenchParticles = (uint32_t)glm::max(atoi(argv[i + 1]), 1);
+            sEngineConfig.mParticleBenchFrames = (uint32_t)glm::max(atoi(argv[i + 2]), 1);
+            sEngineConfig.mParticleBenchEmitters = (uint32_t)glm::max(atoi(argv[i + 3]), 1);
+            i += 3;
+        }
+        else if (strcmp(argv[i], "-datumbench") == 0)
+        {
+            OCT_ASSERT(i + 1 < argc);
+            sEngineConfig.mDatumBenchIterations = (uint32_t)glm::max(atoi(argv[i + 1]), 1);
+            ++i;
+        }
         else if (strcmp(argv[i], "-build") == 0)
         {
             OCT_ASSERT(i + 1 < argc);
@@ -284,6 +321,7 @@ bool Initialize()
     Renderer::Create();
     AssetManager::Create();
     NetworkManager::Create();
+    JobSystem::Create();
 
 #if EDITOR
     EditorImguiInit();
@@ -303,12 +341,19 @@ bool Initialize()
         SYS_Initialize();
     }
 
+#if !EDITOR
+    // Cold start is measured from here to the default scene being loaded.
+    uint64_t coldStartTime = SYS_GetTimeMicroseconds();
+    bool usingAssetArchive = false;
+#endif
+
     if (sEngineConfig.mWorkingDirectory != "")
     {
         SYS_SetWorkingDirectory(sEngineConfig.mWorkingDirectory);
     }
 
     AssetManager::Get()->Initialize();
+    JobSystem::Get()->Initialize();
 
     if (sEngineConfig.mProjectPath != "")
     {
@@ -334,7 +379,15 @@ bool Initialize()
     if (GetEngineState()->mProjectDirectory != "" &&
         sEngineConfig.mUseAssetRegistry)
     {
-        AssetManager::Get()->DiscoverAssetRegistry((GetEngineState()->mProjectDirectory + "AssetRegistry.txt").c_str());
+        std::string archivePath = GetEngineState()->mProjectDirectory + ASSET_ARCHIVE_FILE_NAME;
+        usingAssetArchive = sEngineConfig.mUseAssetArchive &&
+            SYS_DoesFileExist(archivePath.c_str(), true) &&
+            AssetManager::Get()->DiscoverAssetArchive(archivePath.c_str());
+
+        if (!usingAssetArchive)
+        {
+            AssetManager::Get()->DiscoverAssetRegistry((GetEngineState()->mProjectDirectory + "AssetRegistry.txt").c_str());
+        }
     }
 #endif
 
@@ -502,12 +555,40 @@ bool Initialize()
     if (defaultScene != nullptr)
     {
         GetWorld(0)->LoadScene(defaultScene->GetName().c_str(), true);
+
+        float coldStartMs = float(SYS_GetTimeMicroseconds() - coldStartTime) / 1000.0f;
+        LogDebug("Cold start: %s loaded in %.2f ms (%s)", defaultScene->GetName().c_str(), coldStartMs,
+            usingAssetArchive ? "asset archive" : "loose asset files");
     }
     else
     {
         LogWarning("No default scene found.");
     }
 
+    if (sEngineConfig.mNetBenchClients > 0)
+    {
+        sNetBenchmark = new NetBenchmark();
+        sNetBenchmark->Start(sEngineConfig.mNetBenchClients, sEngineConfig.mNetBenchNodes, sEngineConfig.mNetBenchDuration);
+    }
+
+    if (sEngineConfig.mSkinBenchVertices > 0)
+    {
+        RunSkinningBenchmark(sEngineConfig.mSkinBenchVertices, sEngineConfig.mSkinBenchIterations);
+        Quit();
+    }
+
+    if (sEngineConfig.mParticleBenchParticles > 0)
+    {
+        RunParticleBenchmark(sEngineConfig.mParticleBenchParticles, sEngineConfig.mParticleBenchFrames, sEngineConfig.mParticleBenchEmitters);
+        Quit();
+    }
+
+    if (sEngineConfig.mDatumBenchIterations > 0)
+    {
+        RunDatumBenchmark(sEngineConfig.mDatumBenchIterations);
+        Quit();
+    }
+
 #endif
 
     sEngineState.mInitialized = true;
@@ -601,6 +682,11 @@ bool Update()
 
     NetworkManager::Get()->PostTickUpdate(realDeltaTime);
 
+    if (sNetBenchmark != nullptr)
+    {
+        sNetBenchmark->Update(realDeltaTime);
+    }
+
 #if EDITOR
     EditorImguiDraw();
 #endif
@@ -631,6 +717,12 @@ void Shutdown()
     DestroyFileWatcher();
 #endif
 
+    if (sNetBenchmark != nullptr)
+    {
+        delete sNetBenchmark;
+        sNetBenchmark = nullptr;
+    }
+
     NetworkManager::Get()->Shutdown();
 
     for (uint32_t i = 0; i < sWorlds.size(); ++i)
@@ -654,6 +746,7 @@ void Shutdown()
     NetworkManager::Destroy();
     Renderer::Destroy();
     AssetManager::Destroy();
+    JobSystem::Destroy();
 
     NET_Shutdown();
     if (!IsHeadless())
@@ -676,9 +769,10 @@ void Shutdown()
     sEngineState.mInitialized = false;
 }
 
-void Quit()
+void Quit(int32_t exitCode)
 {
     sEngineState.mQuit = true;
+    sEngineState.mExitCode = exitCode;
 }
 
 World* GetWorld(int32_t index)
@@ -929,6 +1023,7 @@ void ReloadAllScripts(bool restartComponents)
 
     // Reload script files
     ScriptUtils::ReloadAllScriptFiles();
+    Script::InvalidateAllCallbacks();
 
     if (restartComponents)
     {
@@ -992,7 +1087,7 @@ float GetTimeDilation()
 void GarbageCollect()
 {
     ScriptUtils::GarbageCollect();
-    AssetManager::Get()->RefSweep();
+    AssetManager::Get()->RefSweep(false);
 }
 
 void GatherGlobalProperties(std::vector<Property>& props)
@@ -1055,6 +1150,7 @@ void WriteEngineConfig(std::string path)
         fprintf(configIni, "LinearColorSpace=%d\n", sEngineConfig.mLinearColorSpace);
         fprintf(configIni, "PackageForSteam=%d\n", sEngineConfig.mPackageForSteam);
         fprintf(configIni, "UseAssetRegistry=%d\n", sEngineConfig.mUseAssetRegistry);
+        fprintf(configIni, "UseAssetArchive=%d\n", sEngineConfig.mUseAssetArchive);
         fprintf(configIni, "Logging=%d\n", sEngineConfig.mLogging);
         fprintf(configIni, "LogToFile=%d\n", sEngineConfig.mLogToFile);
 
@@ -1158,6 +1254,8 @@ void ReadEngineConfig(std::string path)
                 sEngineConfig.mPackageForSteam = strToBool(value);
             else if (keyStr == "UseAssetRegistry")
                 sEngineConfig.mUseAssetRegistry = strToBool(value);
+            else if (keyStr == "UseAssetArchive")
+                sEngineConfig.mUseAssetArchive = strToBool(value);
             else if (keyStr == "Logging")
                 sEngineConfig.mLogging = strToBool(value);
             else if (keyStr == "LogToFile")
@@ -1168,6 +1266,17 @@ void ReadEngineConfig(std::string path)
             else if (keyStr == "LqEnableMipMaps")
                 sEngineConfig.mLqEnableMipMaps = strToBool(value);
 
+            else if (keyStr == "AsyncLoadThreads")
+                sEngineConfig.mAsyncLoadThreads = atoi(value);
+            else if (keyStr == "AsyncLoadBudgetMs")
+                sEngineConfig.mAsyncLoadBudgetMs = (float)atof(value);
+            else if (keyStr == "AssetAutoSweep")
+                sEngineConfig.mAssetAutoSweep = strToBool(value);
+            else if (keyStr == "AssetSweepBudgetMs")
+                sEngineConfig.mAssetSweepBudgetMs = (float)atof(value);
+            else if (keyStr == "AssetSweepGraceTime")
+                sEngineConfig.mAssetSweepGraceTime = (float)atof(value);
+
             else if (keyStr == "EditorInterfaceScale")
                 sEngineConfig.mEditorInterfaceScale = (float)atof(value);
             else if (keyStr == "ScriptHotReload")
@@ -1268,8 +1377,8 @@ int main(int argc, char** argv)
 #endif
 
 #if PLATFORM_ANDROID
-    exit(0);
+    exit(sEngineState.mExitCode);
 #else
-    return 0;
+    return sEngineState.mExitCode;
 #endif
 }
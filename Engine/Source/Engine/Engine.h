@@ -19,7 +19,8 @@ bool Update();
 
 void Shutdown();
 
-void Quit();
+// A nonzero exit code is returned from main() once the engine shuts down.
+void Quit(int32_t exitCode = 0);
 
 class World* GetWorld(int32_t index);
 int32_t GetNumWorlds();
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <unordered_set>
 #include <unordered_map>
+#include <deque>
 #include <algorithm>
 
 #include "Constants.h"
@@ -25,6 +26,7 @@ class Primitive3D;
 class Light3D;
 class Node3D;
 class Node;
+class SkeletalMesh3D;
 
 // Platform enum moved here for use in EngineConfig
 enum class Platform : int
@@ -178,6 +180,12 @@ struct DrawData
     bool mDepthless;
 };
 
+struct AnimationUpdateRequest
+{
+    SkeletalMesh3D* mNode = nullptr;
+    bool mUpdateBones = false;
+};
+
 struct LightData
 {
     LightType mType;
@@ -220,7 +228,10 @@ struct PrimitivePair
 
     size_t operator()(const PrimitivePair& pairToHash) const
     {
-        size_t hash = (size_t)pairToHash.mPrimitiveA + (size_t)pairToHash.mPrimitiveB;
+        // Order matters here since both (A, B) and (B, A) are tracked as separate overlaps.
+        size_t hashA = std::hash<Primitive3D*>{}(pairToHash.mPrimitiveA);
+        size_t hashB = std::hash<Primitive3D*>{}(pairToHash.mPrimitiveB);
+        size_t hash = hashA ^ (hashB + 0x9e3779b9 + (hashA << 6) + (hashA >> 2));
         return hash;
     }
 
@@ -272,6 +283,7 @@ struct EngineConfig
     bool mLinearColorSpace = false;
     bool mPackageForSteam = false;
     bool mUseAssetRegistry = false;
+    bool mUseAssetArchive = true; // Packaged builds load from the mapped asset archive when one was cooked
     bool mLogging = true;
     bool mLogToFile = false;
     bool mScriptHotReload = false;
@@ -279,6 +291,12 @@ struct EngineConfig
     int32_t mLqMaxTextureSize = 0;
     bool mLqEnableMipMaps = true;
 
+    int32_t mAsyncLoadThreads = 2;
+    float mAsyncLoadBudgetMs = 4.0f; // Main thread time per frame for finishing async loads
+    bool mAssetAutoSweep = false; // Queue assets for unloading as soon as they become unreferenced
+    float mAssetSweepBudgetMs = 1.0f; // Main thread time per frame for unloading queued assets
+    float mAssetSweepGraceTime = 5.0f; // Seconds an unreferenced asset stays loaded in case it gets used again
+
     std::string mProjectPath;
     std::string mCurrentFont;
     std::string mWorkingDirectory;
@@ -298,6 +316,23 @@ struct EngineConfig
     bool mHeadless = false;
     Platform mBuildPlatform = Platform::Count;  // Count = no build requested
     bool mBuildEmbedded = false;
+
+    // Loopback network benchmark (-netbench <clients> <nodes> <seconds>)
+    uint32_t mNetBenchClients = 0;
+    uint32_t mNetBenchNodes = 0;
+    float mNetBenchDuration = 0.0f;
+
+    // CPU skinning benchmark (-skinbench <vertices> <iterations>)
+    uint32_t mSkinBenchVertices = 0;
+    uint32_t mSkinBenchIterations = 0;
+
+    // Particle simulation benchmark (-particlebench <particles> <frames> <emitters>)
+    uint32_t mParticleBenchParticles = 0;
+    uint32_t mParticleBenchFrames = 0;
+    uint32_t mParticleBenchEmitters = 0;
+
+    // Datum allocation benchmark (-datumbench <iterations>)
+    uint32_t mDatumBenchIterations = 0;
 };
 
 enum class ConsoleMode
@@ -342,6 +377,7 @@ struct EngineState
     
     bool mConsoleMode = false;
     bool mQuit = false;
+    int32_t mExitCode = 0;
     bool mWindowMinimized = false;
     bool mStandalone = false;
 
@@ -472,6 +508,48 @@ struct ReliablePacket
     uint16_t mSeq = 0;
 };
 
+// What a client is known to have received for one replicated variable.
+// Hashes are of the encoded bits, so changes smaller than the quantization step are ignored.
+struct NetVarBaseline
+{
+    uint64_t mAckedHash = 0;
+    uint64_t mSentHash = 0;
+    uint32_t mAckedRepId = 0;
+    uint32_t mSentRepId = 0; // Greater than mAckedRepId while a send is in flight.
+};
+
+struct NetNodeBaseline
+{
+    // [0] = native replicated data, [1] = script replicated data
+    std::vector<NetVarBaseline> mVars[2];
+    uint32_t mNumUnacked = 0;
+
+    // Records sent before a set's vars were rebuilt (e.g. a script restart) refer to the old vars.
+    uint32_t mVarsResetRepId[2] = {};
+
+    // Prioritized replication. Accumulates until the node is replicated to this client.
+    float mRepPriority = 0.0f;
+
+    // Set when the data changed while this client wasn't being replicated to.
+    bool mDirty[2] = {};
+};
+
+// A variable that was packed into an outgoing packet, applied to the baseline once the packet is acked.
+struct NetRepRecord
+{
+    NetId mNetId = INVALID_NET_ID;
+    uint32_t mRepId = 0;
+    uint64_t mHash = 0;
+    uint16_t mIndex = 0;
+    uint8_t mScript = 0;
+};
+
+struct NetRepPacket
+{
+    uint16_t mSeq = 0;
+    std::vector<NetRepRecord> mRecords;
+};
+
 struct NetHostProfile
 {
     static const uint32_t sSendBufferSize = 512;
@@ -490,11 +568,40 @@ struct NetHostProfile
     uint16_t mIncomingUnreliableSeq = 0;
     WeakPtr<Node> mPawn;
     bool mReady = true;
+
+    // Delta replication (server side). [0] = unreliable, [1] = reliable
+    std::unordered_map<NetId, NetNodeBaseline> mBaselines;
+    std::vector<NetRepRecord> mPendingRepRecords[2];
+    std::deque<NetRepPacket> mSentRepPackets[2];
+    uint32_t mNextRepId = 1;
+
+    // Prioritized replication (server side). Node priorities are kept in their baselines.
+    float mRepBudget = 0.0f;
+
+    // Unreliable packets received, acked back once a frame (client side).
+    uint16_t mLatestUnreliableSeq = 0;
+    uint32_t mUnreliableReceivedBits = 0;
+    bool mReceivedUnreliable = false;
+    bool mUnreliableAckPending = false;
 };
 
 typedef NetHostProfile NetClient;
 typedef NetHostProfile NetServer;
 
+// Running totals kept by the NetworkManager until ResetStats() is called.
+struct NetStats
+{
+    uint64_t mBytesSent = 0;
+    uint64_t mBytesReceived = 0;
+    uint32_t mPacketsSent = 0;
+    uint32_t mPacketsReceived = 0;
+    uint32_t mMessagesSent = 0;
+    uint32_t mReliableResends = 0;
+    uint32_t mTicks = 0;
+    uint64_t mReplicationTimeUs = 0;
+    uint64_t mIncomingTimeUs = 0;
+};
+
 struct FadingLight
 {
     // mNode should only be used for comparisons!! If deleted, we want to fade it out, not crash.
@@ -0,0 +1,259 @@
+#include "JobSystem.h"
+#include "Log.h"
+#include "Assertion.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+#if (PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_ANDROID)
+#include <thread>
+#endif
+
+// One worker per core, minus the core used by the main thread.
+static const uint32_t kMaxWorkers = 15;
+
+// Which queue the current thread owns. The main thread (and any other non-worker thread) uses queue 0.
+static thread_local uint32_t sQueueIndex = 0;
+
+JobSystem* JobSystem::sInstance = nullptr;
+
+void JobSystem::Create()
+{
+    Destroy();
+    sInstance = new JobSystem();
+}
+
+void JobSystem::Destroy()
+{
+    if (sInstance != nullptr)
+    {
+        delete sInstance;
+        sInstance = nullptr;
+    }
+}
+
+JobSystem* JobSystem::Get()
+{
+    return sInstance;
+}
+
+JobSystem::JobSystem()
+{
+    mNumQueuedJobs = 0;
+    mNextQueue = 0;
+    mShuttingDown = false;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize()
+{
+    uint32_t numWorkers = 0;
+
+#if (PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_ANDROID)
+    uint32_t numCores = std::thread::hardware_concurrency();
+    numWorkers = (numCores > 1) ? (numCores - 1) : 0;
+    numWorkers = std::min(numWorkers, kMaxWorkers);
+#endif
+
+    mShuttingDown = false;
+    mQueues.resize(numWorkers + 1);
+
+    for (uint32_t i = 0; i < mQueues.size(); ++i)
+    {
+        mQueues[i].mMutex = SYS_CreateMutex();
+    }
+
+    for (uint32_t i = 0; i < numWorkers; ++i)
+    {
+        // Worker N owns queue N + 1.
+        uintptr_t queueIndex = i + 1;
+        mThreads.push_back(SYS_CreateThread(WorkerThreadFunc, (void*)queueIndex));
+    }
+
+    LogDebug("JobSystem initialized with %d worker threads", numWorkers);
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mShuttingDown = true;
+    }
+
+    mWorkCondition.notify_all();
+
+    for (uint32_t i = 0; i < mThreads.size(); ++i)
+    {
+        SYS_JoinThread(mThreads[i]);
+        SYS_DestroyThread(mThreads[i]);
+    }
+
+    mThreads.clear();
+
+    for (uint32_t i = 0; i < mQueues.size(); ++i)
+    {
+        OCT_ASSERT(mQueues[i].mJobs.size() == 0);
+        SYS_DestroyMutex(mQueues[i].mMutex);
+        mQueues[i].mMutex = nullptr;
+    }
+
+    mQueues.clear();
+}
+
+void JobSystem::RunJobs(const Job* jobs, uint32_t numJobs)
+{
+    JobCounter counter(0);
+    SubmitJobs(jobs, numJobs, counter);
+    Wait(counter);
+}
+
+void JobSystem::SubmitJobs(const Job* jobs, uint32_t numJobs, JobCounter& counter)
+{
+    if (numJobs == 0)
+        return;
+
+    // Nothing to distribute to, so just run them inline.
+    if (mThreads.size() == 0)
+    {
+        for (uint32_t i = 0; i < numJobs; ++i)
+        {
+            jobs[i].mFunc(jobs[i].mArg);
+        }
+
+        return;
+    }
+
+    counter += int32_t(numJobs);
+
+    // Spread the jobs across all of the queues. Idle workers will steal from busier ones.
+    uint32_t numQueues = (uint32_t)mQueues.size();
+    uint32_t startQueue = mNextQueue.fetch_add(1) % numQueues;
+
+    for (uint32_t q = 0; q < numQueues; ++q)
+    {
+        uint32_t queueIndex = (startQueue + q) % numQueues;
+        JobQueue& queue = mQueues[queueIndex];
+
+        SCOPED_LOCK(queue.mMutex);
+        for (uint32_t i = q; i < numJobs; i += numQueues)
+        {
+            QueuedJob queuedJob;
+            queuedJob.mJob = jobs[i];
+            queuedJob.mCounter = &counter;
+            queue.mJobs.push_back(queuedJob);
+        }
+    }
+
+    // Only count the jobs once they can be popped, so that woken threads don't spin on empty queues.
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mNumQueuedJobs += int32_t(numJobs);
+    }
+
+    mWorkCondition.notify_all();
+    mDoneCondition.notify_all();
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    // Help out until our jobs are done. This may execute jobs from other submitters,
+    // which is fine since they are independent of ours.
+    while (counter.load() > 0)
+    {
+        if (!ExecuteNextJob(sQueueIndex))
+        {
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mDoneCondition.wait(lock, [&]()
+                {
+                    return counter.load() <= 0 || mNumQueuedJobs.load() > 0;
+                });
+        }
+    }
+}
+
+uint32_t JobSystem::GetNumWorkers() const
+{
+    return (uint32_t)mThreads.size();
+}
+
+ThreadFuncRet JobSystem::WorkerThreadFunc(void* arg)
+{
+    JobSystem* jobSystem = JobSystem::Get();
+    sQueueIndex = (uint32_t)(uintptr_t)arg;
+
+    std::string threadName = "Worker " + std::to_string(sQueueIndex);
+    GetProfiler()->SetThreadName(threadName.c_str());
+
+    while (!jobSystem->mShuttingDown)
+    {
+        if (!jobSystem->ExecuteNextJob(sQueueIndex))
+        {
+            std::unique_lock<std::mutex> lock(jobSystem->mWakeMutex);
+            jobSystem->mWorkCondition.wait(lock, [jobSystem]()
+                {
+                    return jobSystem->mShuttingDown.load() || jobSystem->mNumQueuedJobs.load() > 0;
+                });
+        }
+    }
+
+    THREAD_RETURN();
+}
+
+bool JobSystem::PopJob(uint32_t queueIndex, QueuedJob& outJob)
+{
+    // Own queue is used LIFO, stolen jobs are taken FIFO from the other end.
+    {
+        JobQueue& queue = mQueues[queueIndex];
+        SCOPED_LOCK(queue.mMutex);
+
+        if (queue.mJobs.size() > 0)
+        {
+            outJob = queue.mJobs.back();
+            queue.mJobs.pop_back();
+            return true;
+        }
+    }
+
+    uint32_t numQueues = (uint32_t)mQueues.size();
+    for (uint32_t i = 1; i < numQueues; ++i)
+    {
+        JobQueue& victim = mQueues[(queueIndex + i) % numQueues];
+        SCOPED_LOCK(victim.mMutex);
+
+        if (victim.mJobs.size() > 0)
+        {
+            outJob = victim.mJobs.front();
+            victim.mJobs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::ExecuteNextJob(uint32_t queueIndex)
+{
+    if (mNumQueuedJobs.load() <= 0)
+        return false;
+
+    QueuedJob queuedJob;
+    if (!PopJob(queueIndex, queuedJob))
+        return false;
+
+    mNumQueuedJobs--;
+
+    queuedJob.mJob.mFunc(queuedJob.mJob.mArg);
+
+    // The counter may go out of scope as soon as it reaches zero, so don't touch it after this.
+    if (queuedJob.mCounter->fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mDoneCondition.notify_all();
+    }
+
+    return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include "System/System.h"
+
+typedef void (*JobFuncFP)(void* arg);
+
+struct Job
+{
+    JobFuncFP mFunc = nullptr;
+    void* mArg = nullptr;
+};
+
+// Small pool of worker threads with a job queue per thread. Idle threads steal
+// jobs from the other queues and block when there is nothing to do. The thread that
+// submits jobs helps execute them until they have all finished, so submitting from
+// inside a job is allowed.
+class JobSystem
+{
+public:
+
+    static void Create();
+    static void Destroy();
+    static JobSystem* Get();
+
+    ~JobSystem();
+
+    void Initialize();
+    void Shutdown();
+
+    // Runs every job and blocks until they have all finished.
+    void RunJobs(const Job* jobs, uint32_t numJobs);
+
+    uint32_t GetNumWorkers() const;
+
+private:
+
+    static JobSystem* sInstance;
+    JobSystem();
+
+    // Number of unfinished jobs from a SubmitJobs() call.
+    typedef std::atomic<int32_t> JobCounter;
+
+    // Queues jobs without waiting on them. With no workers, the jobs run immediately.
+    void SubmitJobs(const Job* jobs, uint32_t numJobs, JobCounter& counter);
+
+    // Helps execute jobs until every job counted by the counter has finished, and blocks
+    // while the remaining jobs are running on other threads.
+    void Wait(JobCounter& counter);
+
+    struct QueuedJob
+    {
+        Job mJob;
+        JobCounter* mCounter = nullptr;
+    };
+
+    struct JobQueue
+    {
+        MutexObject* mMutex = nullptr;
+        std::deque<QueuedJob> mJobs;
+    };
+
+    static ThreadFuncRet WorkerThreadFunc(void* arg);
+
+    bool PopJob(uint32_t queueIndex, QueuedJob& outJob);
+    bool ExecuteNextJob(uint32_t queueIndex);
+
+    // Queue 0 belongs to the main thread, queue N to worker N.
+    std::vector<JobQueue> mQueues;
+    std::vector<ThreadObject*> mThreads;
+    std::atomic<int32_t> mNumQueuedJobs;
+    std::atomic<uint32_t> mNextQueue;
+    std::atomic<bool> mShuttingDown;
+
+    // Idle workers wait on mWorkCondition for new jobs. Waiting submitters wait on
+    // mDoneCondition for either their counter to reach zero or a new job to help with.
+    std::mutex mWakeMutex;
+    std::condition_variable mWorkCondition;
+    std::condition_variable mDoneCondition;
+};
@@ -1,6 +1,7 @@
 #include "Maths.h"
 #include <time.h>
 #include <stdlib.h>
+#include <atomic>
 
 #define USE_GLM_MATRIX_DECOMPOSE_TRANSLATION 0
 #define USE_GLM_MATRIX_DECOMPOSE_ROTATION 1
@@ -375,9 +376,26 @@ int32_t Maths::RandIndexWeighted(const std::vector<float>& weights)
     return retIndex;
 }
 
+static uint32_t sStreamSeed = 0;
+static std::atomic<uint32_t> sNumStreamSeeds { 0 };
+
 void Maths::SeedRand(uint32_t seed)
 {
     srand(seed);
+    sStreamSeed = seed;
+    sNumStreamSeeds = 0;
+}
+
+uint32_t Maths::NewStreamSeed()
+{
+    // Murmur3 finalizer, so consecutive streams don't start out correlated.
+    uint32_t h = sStreamSeed + sNumStreamSeeds.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
 }
 
 float Maths::RotateYawTowardDirection(float srcYaw, glm::vec3 dir, float speed, float deltaTime)
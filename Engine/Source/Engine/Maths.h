@@ -46,6 +46,10 @@ public:
 
     static void SeedRand(uint32_t seed);
 
+    // Returns a new seed for a separate random stream without consuming values from rand().
+    // The sequence of seeds restarts whenever SeedRand() is called.
+    static uint32_t NewStreamSeed();
+
     static float Damp(float source, float target, float smoothing, float deltaTime);
     static glm::vec3 Damp(glm::vec3 source, glm::vec3 target, float smoothing, float deltaTime);
     static glm::vec4 Damp(glm::vec4 source, glm::vec4 target, float smoothing, float deltaTime);
@@ -0,0 +1,465 @@
+#include "NetBenchmark.h"
+#include "NetworkManager.h"
+#include "NetMsg.h"
+#include "Engine.h"
+#include "World.h"
+#include "Log.h"
+#include "Maths.h"
+#include "Stream.h"
+
+#include "Nodes/3D/Node3d.h"
+
+#include <stdio.h>
+
+#ifdef SendMessage
+#undef SendMessage
+#endif
+
+// Host ids are a byte and a few values are reserved.
+static const uint32_t kMaxBenchClients = 64;
+static const uint32_t kUnreliableAckWindow = 32;
+static const uint16_t kReadySeq = 0;
+static const float kConnectInterval = 1.0f;
+static const float kReadyResendTime = 0.1f;
+static const float kConnectTimeout = 10.0f;
+static const float kNodeSpeed = 20.0f;
+static const float kAreaExtent = 500.0f;
+
+NetBenchmark::~NetBenchmark()
+{
+    Stop();
+}
+
+void NetBenchmark::Start(uint32_t numClients, uint32_t numNodes, float duration)
+{
+    Stop();
+
+    NetworkManager* netMan = NetworkManager::Get();
+
+    if (!NET_IsActive() || !netMan->IsLocal())
+    {
+        LogError("Net benchmark needs an active network in local mode.");
+        Finish(false);
+        return;
+    }
+
+    numClients = glm::clamp<uint32_t>(numClients, 1, kMaxBenchClients);
+    mDuration = glm::max(duration, 1.0f);
+    mTimer = 0.0f;
+    mMeasuring = false;
+
+    // Same sequence of moves every run so results can be compared.
+    Maths::SeedRand(1);
+
+    NetSessionOpenOptions options;
+    options.mName = "NetBench";
+    options.mMaxPlayers = int32_t(numClients + 1);
+    options.mPort = OCT_DEFAULT_PORT;
+    options.mLan = true;
+
+    netMan->EnableSessionBroadcast(false);
+    netMan->OpenSession(options);
+
+    if (!netMan->IsServer())
+    {
+        LogError("Net benchmark failed to open a session.");
+        Finish(false);
+        return;
+    }
+
+    SpawnNodes(numNodes);
+
+    mServerIp = NET_IpStringToUint32("127.0.0.1");
+    mClients.resize(numClients);
+
+    for (uint32_t i = 0; i < numClients; ++i)
+    {
+        SimClient& client = mClients[i];
+        client.mSocket = NET_SocketCreate();
+        NET_SocketSetBlocking(client.mSocket, false);
+        NET_SocketBind(client.mSocket, mServerIp, 0);
+
+        // Stagger the connects a little so they don't all land in one frame.
+        client.mConnectTimer = kConnectInterval * (float(i) / numClients);
+    }
+
+    mRunning = true;
+
+    LogDebug("Net benchmark started: %u clients, %u nodes, %.1f seconds", numClients, numNodes, mDuration);
+}
+
+void NetBenchmark::Stop()
+{
+    for (uint32_t i = 0; i < mClients.size(); ++i)
+    {
+        if (mClients[i].mSocket != NET_INVALID_SOCKET)
+        {
+            NET_SocketClose(mClients[i].mSocket);
+        }
+    }
+
+    mClients.clear();
+    mNodes.clear();
+    mVelocities.clear();
+    mRunning = false;
+    mMeasuring = false;
+}
+
+void NetBenchmark::Update(float deltaTime)
+{
+    if (!mRunning)
+        return;
+
+    MoveNodes(deltaTime);
+
+    for (uint32_t i = 0; i < mClients.size(); ++i)
+    {
+        UpdateClient(mClients[i], deltaTime);
+    }
+
+    mTimer += deltaTime;
+
+    if (!mMeasuring)
+    {
+        if (AreClientsReady())
+        {
+            // Leave the connect burst out of the results.
+            NetworkManager::Get()->ResetStats();
+            mMeasuring = true;
+            mTimer = 0.0f;
+            LogDebug("Net benchmark clients ready, measuring...");
+        }
+        else if (mTimer >= kConnectTimeout)
+        {
+            LogError("Net benchmark timed out waiting for clients to connect.");
+            Finish(false);
+        }
+    }
+    else if (mTimer >= mDuration)
+    {
+        Finish(true);
+    }
+}
+
+bool NetBenchmark::IsRunning() const
+{
+    return mRunning;
+}
+
+void NetBenchmark::SpawnNodes(uint32_t numNodes)
+{
+    World* world = GetWorld(0);
+
+    // Start from an empty world so the project's scene doesn't skew the results.
+    // The container is replicated too, otherwise new clients won't be sent its children.
+    world->DestroyRootNode();
+    Node3D* container = world->SpawnNode<Node3D>();
+    container->SetName("NetBench");
+    container->SetReplicate(true);
+
+    mNodes.reserve(numNodes);
+    mVelocities.reserve(numNodes);
+
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        Node3D* node = container->CreateChild<Node3D>("NetBenchNode");
+        node->SetReplicate(true);
+        node->SetReplicateTransform(true);
+        node->SetPosition(Maths::RandRange(glm::vec3(-kAreaExtent), glm::vec3(kAreaExtent)));
+
+        mNodes.push_back(node);
+        mVelocities.push_back(Maths::RandRange(glm::vec3(-kNodeSpeed), glm::vec3(kNodeSpeed)));
+    }
+}
+
+void NetBenchmark::MoveNodes(float deltaTime)
+{
+    for (uint32_t i = 0; i < mNodes.size(); ++i)
+    {
+        glm::vec3& velocity = mVelocities[i];
+        glm::vec3 pos = mNodes[i]->GetPosition() + velocity * deltaTime;
+
+        // Bounce off the edges of the area.
+        for (int32_t c = 0; c < 3; ++c)
+        {
+            if (glm::abs(pos[c]) > kAreaExtent)
+            {
+                pos[c] = glm::clamp(pos[c], -kAreaExtent, kAreaExtent);
+                velocity[c] = -velocity[c];
+            }
+        }
+
+        mNodes[i]->SetPosition(pos);
+        mNodes[i]->AddRotation(glm::vec3(0.0f, 90.0f * deltaTime, 0.0f));
+    }
+}
+
+void NetBenchmark::UpdateClient(SimClient& client, float deltaTime)
+{
+    if (client.mKicked)
+        return;
+
+    ReceivePackets(client);
+
+    if (client.mHostId == INVALID_HOST_ID)
+    {
+        client.mConnectTimer -= deltaTime;
+        if (client.mConnectTimer <= 0.0f)
+        {
+            char body[OCT_MAX_MSG_BODY_SIZE];
+            Stream stream(body, OCT_MAX_MSG_BODY_SIZE);
+
+            NetMsgConnect connectMsg;
+            connectMsg.mGameCode = GetEngineState()->mGameCode;
+            connectMsg.mVersion = GetEngineState()->mVersion;
+            connectMsg.Write(stream);
+
+            // The server only recognizes a Connect that leads the packet, same as SendMessageImmediate().
+            SendPacket(client, body, stream.GetPos(), false, 0);
+            client.mConnectTimer = kConnectInterval;
+        }
+    }
+
+    // Answer the server's Ready with our own, resending it until the server acks it.
+    if (client.mReadyRequested && !client.mReadyAcked)
+    {
+        client.mReadyResendTimer -= deltaTime;
+        if (client.mReadyResendTimer <= 0.0f)
+        {
+            char body[OCT_MAX_MSG_BODY_SIZE];
+            Stream stream(body, OCT_MAX_MSG_BODY_SIZE);
+
+            NetMsgReady readyMsg;
+            readyMsg.Write(stream);
+
+            SendPacket(client, body, stream.GetPos(), true, kReadySeq);
+            client.mReadyResendTimer = kReadyResendTime;
+        }
+    }
+
+    SendUnreliableMessages(client);
+}
+
+void NetBenchmark::ReceivePackets(SimClient& client)
+{
+    char buffer[OCT_RECV_BUFFER_SIZE];
+    uint32_t ip = 0;
+    uint16_t port = 0;
+    int32_t bytes = 0;
+
+    while ((bytes = NET_SocketRecvFrom(client.mSocket, buffer, OCT_RECV_BUFFER_SIZE, ip, port)) > 0)
+    {
+        if (uint32_t(bytes) < OCT_PACKET_HEADER_SIZE)
+            continue;
+
+        Stream stream(buffer, bytes);
+        uint16_t seq = stream.ReadUint16();
+        bool reliable = stream.ReadBool();
+
+        if (reliable)
+        {
+            // Ack every copy. Order doesn't matter here since messages are never executed.
+            client.mPendingAcks.push_back(seq);
+        }
+        else
+        {
+            // Same bookkeeping as NetworkManager::ProcessIncomingPackets() so the acks look real.
+            int16_t advance = int16_t(seq - client.mLatestUnreliableSeq);
+            uint32_t& receivedBits = client.mUnreliableReceivedBits;
+
+            if (client.mReceivedUnreliable && advance <= 0)
+                continue;
+
+            if (!client.mReceivedUnreliable || uint32_t(advance) > kUnreliableAckWindow)
+            {
+                receivedBits = 0;
+            }
+            else
+            {
+                receivedBits = (uint32_t(advance) == kUnreliableAckWindow) ? 0 : (receivedBits << advance);
+                receivedBits |= (1u << (advance - 1));
+            }
+
+            client.mLatestUnreliableSeq = seq;
+            client.mReceivedUnreliable = true;
+        }
+
+        ReadMessages(client, stream);
+    }
+}
+
+void NetBenchmark::ReadMessages(SimClient& client, Stream& stream)
+{
+    while (stream.GetPos() < stream.GetSize())
+    {
+        NetMsgType msgType = (NetMsgType)stream.GetData()[stream.GetPos()];
+
+        switch (msgType)
+        {
+        case NetMsgType::Accept:
+        {
+            NetMsgAccept msg;
+            msg.Read(stream);
+            client.mHostId = msg.mAssignedHostId;
+            break;
+        }
+        case NetMsgType::Reject:
+        {
+            NetMsgReject msg;
+            msg.Read(stream);
+            LogError("Net benchmark client rejected (reason %d).", int32_t(msg.mReason));
+            client.mKicked = true;
+            return;
+        }
+        case NetMsgType::Kick:
+        {
+            NetMsgKick msg;
+            msg.Read(stream);
+            LogError("Net benchmark client kicked (reason %d).", int32_t(msg.mReason));
+            client.mKicked = true;
+            return;
+        }
+        case NetMsgType::Ready:
+        {
+            NetMsgReady msg;
+            msg.Read(stream);
+            client.mReadyRequested = true;
+            break;
+        }
+        case NetMsgType::Ack:
+        {
+            NetMsgAck msg;
+            msg.Read(stream);
+            if (msg.mSequenceNumber == kReadySeq)
+            {
+                client.mReadyAcked = true;
+            }
+            break;
+        }
+        case NetMsgType::Spawn: { NetMsgSpawn msg; msg.Read(stream); break; }
+        case NetMsgType::Destroy: { NetMsgDestroy msg; msg.Read(stream); break; }
+        case NetMsgType::Ping: { NetMsgPing msg; msg.Read(stream); break; }
+        case NetMsgType::Replicate: { NetMsgReplicate msg; msg.Read(stream); break; }
+        case NetMsgType::ReplicateScript: { NetMsgReplicateScript msg; msg.Read(stream); break; }
+        case NetMsgType::Invoke: { NetMsgInvoke msg; msg.Read(stream); break; }
+        case NetMsgType::InvokeScript: { NetMsgInvokeScript msg; msg.Read(stream); break; }
+
+        default:
+            LogWarning("Net benchmark client received unexpected message type %d.", int32_t(msgType));
+            return;
+        }
+    }
+}
+
+void NetBenchmark::SendPacket(SimClient& client, const char* body, uint32_t size, bool reliable, uint16_t seq)
+{
+    char packet[OCT_MAX_MSG_SIZE];
+    Stream stream(packet, OCT_MAX_MSG_SIZE);
+    stream.WriteUint16(seq);
+    stream.WriteBool(reliable);
+    stream.WriteBytes((const uint8_t*)body, size);
+
+    NET_SocketSendTo(client.mSocket, packet, stream.GetPos(), mServerIp, OCT_DEFAULT_PORT);
+}
+
+void NetBenchmark::SendUnreliableMessages(SimClient& client)
+{
+    if (client.mHostId == INVALID_HOST_ID)
+        return;
+
+    char body[OCT_MAX_MSG_BODY_SIZE];
+    Stream stream(body, OCT_MAX_MSG_BODY_SIZE);
+
+    if (client.mReceivedUnreliable)
+    {
+        NetMsgAckUnreliable ackMsg;
+        ackMsg.mSequenceNumber = client.mLatestUnreliableSeq;
+        ackMsg.mReceivedBits = client.mUnreliableReceivedBits;
+        ackMsg.Write(stream);
+    }
+    else
+    {
+        // Nothing to ack yet, but the server still needs to hear from us.
+        NetMsgPing pingMsg;
+        pingMsg.Write(stream);
+    }
+
+    for (uint32_t i = 0; i < client.mPendingAcks.size(); ++i)
+    {
+        if (stream.GetPos() + sizeof(uint8_t) + sizeof(uint16_t) > OCT_MAX_MSG_BODY_SIZE)
+        {
+            SendPacket(client, body, stream.GetPos(), false, client.mOutgoingUnreliableSeq++);
+            stream.SetPos(0);
+        }
+
+        NetMsgAck ackMsg;
+        ackMsg.mSequenceNumber = client.mPendingAcks[i];
+        ackMsg.Write(stream);
+    }
+
+    client.mPendingAcks.clear();
+
+    SendPacket(client, body, stream.GetPos(), false, client.mOutgoingUnreliableSeq++);
+}
+
+bool NetBenchmark::AreClientsReady() const
+{
+    for (uint32_t i = 0; i < mClients.size(); ++i)
+    {
+        if (!mClients[i].mReadyAcked)
+            return false;
+    }
+
+    return true;
+}
+
+void NetBenchmark::Finish(bool success)
+{
+    if (success)
+    {
+        const NetStats& stats = NetworkManager::Get()->GetStats();
+        uint32_t ticks = glm::max<uint32_t>(stats.mTicks, 1);
+        float seconds = mTimer;
+
+        float bytesSentPerSec = float(stats.mBytesSent) / seconds;
+        float bytesRecvPerSec = float(stats.mBytesReceived) / seconds;
+        float packetsSentPerSec = float(stats.mPacketsSent) / seconds;
+        float msgsPerTick = float(stats.mMessagesSent) / ticks;
+        float repMsPerTick = float(stats.mReplicationTimeUs) / 1000.0f / ticks;
+        float incomingMsPerTick = float(stats.mIncomingTimeUs) / 1000.0f / ticks;
+
+        LogDebug("---- Net Benchmark (%u clients, %u nodes, %.1f s, %u ticks) ----",
+            uint32_t(mClients.size()), uint32_t(mNodes.size()), seconds, stats.mTicks);
+        LogDebug("Bytes sent/s: %.0f  Bytes received/s: %.0f", bytesSentPerSec, bytesRecvPerSec);
+        LogDebug("Packets sent/s: %.1f  Messages/tick: %.2f", packetsSentPerSec, msgsPerTick);
+        LogDebug("Reliable resends: %u", stats.mReliableResends);
+        LogDebug("UpdateReplication: %.3f ms/tick  ProcessIncomingPackets: %.3f ms/tick", repMsPerTick, incomingMsPerTick);
+
+        FILE* benchFile = fopen("NetBench.csv", "w");
+
+        if (benchFile != nullptr)
+        {
+            fprintf(benchFile, "Clients, %u\n", uint32_t(mClients.size()));
+            fprintf(benchFile, "Nodes, %u\n", uint32_t(mNodes.size()));
+            fprintf(benchFile, "Seconds, %f\n", seconds);
+            fprintf(benchFile, "Ticks, %u\n", stats.mTicks);
+            fprintf(benchFile, "BytesSentPerSec, %f\n", bytesSentPerSec);
+            fprintf(benchFile, "BytesReceivedPerSec, %f\n", bytesRecvPerSec);
+            fprintf(benchFile, "PacketsSentPerSec, %f\n", packetsSentPerSec);
+            fprintf(benchFile, "MessagesPerTick, %f\n", msgsPerTick);
+            fprintf(benchFile, "ReliableResends, %u\n", stats.mReliableResends);
+            fprintf(benchFile, "ReplicationMsPerTick, %f\n", repMsPerTick);
+            fprintf(benchFile, "IncomingMsPerTick, %f\n", incomingMsPerTick);
+            fclose(benchFile);
+        }
+        else
+        {
+            LogError("Failed to write NetBench.csv");
+        }
+    }
+
+    Stop();
+
+    // Let whoever launched the benchmark tell a failed run apart from a successful one.
+    Quit(success ? 0 : 1);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "EngineTypes.h"
+#include "Maths.h"
+#include "Network/Network.h"
+#include "Network/NetworkConstants.h"
+
+class Node3D;
+class Stream;
+
+// Loopback replication benchmark, started with -netbench <clients> <nodes> <seconds>.
+// The engine hosts a LAN session and spawns replicated nodes that wander around, while
+// simulated clients connect to it over local UDP sockets. The NetworkManager is a singleton,
+// so the clients speak the wire protocol directly (connect, ready, acks) and never execute
+// the messages they receive. Once every client is ready, the server's NetStats are measured
+// for the requested duration and written to NetBench.csv before the engine quits.
+class NetBenchmark
+{
+public:
+
+    ~NetBenchmark();
+
+    void Start(uint32_t numClients, uint32_t numNodes, float duration);
+    void Stop();
+    void Update(float deltaTime);
+    bool IsRunning() const;
+
+protected:
+
+    struct SimClient
+    {
+        SocketHandle mSocket = NET_INVALID_SOCKET;
+        NetHostId mHostId = INVALID_HOST_ID;
+        uint16_t mOutgoingUnreliableSeq = 1;
+        uint16_t mLatestUnreliableSeq = 0;
+        uint32_t mUnreliableReceivedBits = 0;
+        float mConnectTimer = 0.0f;
+        float mReadyResendTimer = 0.0f;
+        bool mReceivedUnreliable = false;
+        bool mReadyRequested = false;
+        bool mReadyAcked = false;
+        bool mKicked = false;
+        std::vector<uint16_t> mPendingAcks;
+    };
+
+    void SpawnNodes(uint32_t numNodes);
+    void MoveNodes(float deltaTime);
+    void UpdateClient(SimClient& client, float deltaTime);
+    void ReceivePackets(SimClient& client);
+    void ReadMessages(SimClient& client, Stream& stream);
+    void SendPacket(SimClient& client, const char* body, uint32_t size, bool reliable, uint16_t seq);
+    void SendUnreliableMessages(SimClient& client);
+    bool AreClientsReady() const;
+    void Finish(bool success);
+
+    std::vector<SimClient> mClients;
+    std::vector<Node3D*> mNodes;
+    std::vector<glm::vec3> mVelocities;
+    uint32_t mServerIp = 0;
+    float mDuration = 0.0f;
+    float mTimer = 0.0f;
+    bool mRunning = false;
+    bool mMeasuring = false;
+};
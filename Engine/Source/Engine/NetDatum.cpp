@@ -3,8 +3,66 @@
 #include "AssetRef.h"
 #include "Log.h"
 #include "Script.h"
+#include "BitStream.h"
+#include "Stream.h"
+
+#include "Network/NetworkConstants.h"
 
 #include <string.h>
+#include <math.h>
+
+static const uint32_t kNetQuantizeTagBits = 3;
+static_assert(uint32_t(NetQuantize::Count) <= (1u << kNetQuantizeTagBits), "Not enough bits for NetQuantize tag");
+
+static uint32_t GetNumFloatComponents(DatumType type)
+{
+    switch (type)
+    {
+        case DatumType::Float: return 1;
+        case DatumType::Vector2D: return 2;
+        case DatumType::Vector: return 3;
+        case DatumType::Color: return 4;
+        default: return 0;
+    }
+}
+
+static bool IsBitPackable(DatumType type)
+{
+    switch (type)
+    {
+        case DatumType::Integer:
+        case DatumType::Float:
+        case DatumType::Bool:
+        case DatumType::Vector2D:
+        case DatumType::Vector:
+        case DatumType::Color:
+        case DatumType::Byte:
+        case DatumType::Short:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static int32_t QuantizeStep(float value, float step)
+{
+    float steps = glm::clamp(value / step, -1073741824.0f, 1073741824.0f);
+    return int32_t(floorf(steps + 0.5f));
+}
+
+static uint32_t QuantizeAngle(float degrees)
+{
+    float angle = fmodf(degrees, 360.0f);
+    angle = (angle < 0.0f) ? (angle + 360.0f) : angle;
+    return uint32_t(angle * (65536.0f / 360.0f) + 0.5f) & 0xffff;
+}
+
+static float DequantizeAngle(uint32_t value)
+{
+    // Keep the angle in [-180, 180) like the euler angles extracted from a rotation.
+    float angle = value * (360.0f / 65536.0f);
+    return (angle >= 180.0f) ? (angle - 360.0f) : angle;
+}
 
 NetDatum::NetDatum()
 {
@@ -113,6 +171,279 @@ void NetDatum::PostReplicate()
     }
 }
 
+bool NetDatum::IsAlwaysReplicated() const
+{
+    return mAlwaysReplicate;
+}
+
+void NetDatum::SetQuantization(NetQuantize quantize)
+{
+    OCT_ASSERT(quantize != NetQuantize::Bounded); // Use SetBoundedQuantization()
+    mQuantize = quantize;
+}
+
+void NetDatum::SetBoundedQuantization(float minValue, float maxValue, uint32_t numBits)
+{
+    if (maxValue <= minValue || numBits == 0)
+    {
+        LogWarning("Invalid bounded quantization range, replicating at full precision.");
+        mQuantize = NetQuantize::None;
+        return;
+    }
+
+    // More bits than a float mantissa holds would not add any precision.
+    mQuantize = NetQuantize::Bounded;
+    mQuantizeMin = minValue;
+    mQuantizeMax = maxValue;
+    mQuantizeBits = uint8_t(glm::min<uint32_t>(numBits, 24));
+}
+
+NetQuantize NetDatum::GetQuantization() const
+{
+    return mQuantize;
+}
+
+void NetDatum::WriteNet(BitStream& bits, bool quantizeTransform) const
+{
+    NetQuantize mode = mQuantize;
+
+    if (mode == NetQuantize::Position ||
+        mode == NetQuantize::Rotation ||
+        mode == NetQuantize::Scale)
+    {
+        if (!quantizeTransform || mType != DatumType::Vector)
+        {
+            mode = NetQuantize::None;
+        }
+    }
+    else if (mode == NetQuantize::Bounded && GetNumFloatComponents(mType) == 0)
+    {
+        mode = NetQuantize::None;
+    }
+
+    bits.WriteBits(uint32_t(mode), kNetQuantizeTagBits);
+
+    if (mode == NetQuantize::None && !IsBitPackable(mType))
+    {
+        // Strings, assets and nodes use the regular net serialization, prefixed by its size.
+        Stream stream;
+        WriteStream(stream, true);
+
+        bits.WriteVarUint(stream.GetPos(), 7);
+        for (uint32_t b = 0; b < stream.GetPos(); ++b)
+        {
+            bits.WriteBits(uint8_t(stream.GetData()[b]), 8);
+        }
+
+        return;
+    }
+
+    uint32_t numComps = GetNumFloatComponents(mType);
+    float range = mQuantizeMax - mQuantizeMin;
+    uint32_t maxBounded = (1u << mQuantizeBits) - 1;
+
+    for (uint32_t i = 0; i < mCount; ++i)
+    {
+        switch (mode)
+        {
+            case NetQuantize::Position:
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    bits.WriteVarInt(QuantizeStep(mData.v3[i][c], NET_POSITION_PRECISION), 7);
+                }
+                break;
+
+            case NetQuantize::Rotation:
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    bits.WriteBits(QuantizeAngle(mData.v3[i][c]), 16);
+                }
+                break;
+
+            case NetQuantize::Scale:
+            {
+                const glm::vec3& scale = mData.v3[i];
+                bool uniform = (scale.x == scale.y && scale.y == scale.z);
+                bits.WriteBool(uniform);
+
+                for (uint32_t c = 0; c < (uniform ? 1u : 3u); ++c)
+                {
+                    bits.WriteVarInt(QuantizeStep(scale[c] - 1.0f, NET_SCALE_PRECISION), 4);
+                }
+                break;
+            }
+
+            case NetQuantize::Bounded:
+            {
+                const float* comps = mData.f + i * numComps;
+                for (uint32_t c = 0; c < numComps; ++c)
+                {
+                    float alpha = glm::clamp((comps[c] - mQuantizeMin) / range, 0.0f, 1.0f);
+                    bits.WriteBits(uint32_t(alpha * maxBounded + 0.5f), mQuantizeBits);
+                }
+                break;
+            }
+
+            default:
+            {
+                switch (mType)
+                {
+                    case DatumType::Integer: bits.WriteVarInt(mData.i[i], 7); break;
+                    case DatumType::Bool: bits.WriteBool(mData.b[i]); break;
+                    case DatumType::Byte: bits.WriteBits(mData.by[i], 8); break;
+                    case DatumType::Short: bits.WriteBits(uint16_t(mData.sh[i]), 16); break;
+                    default:
+                    {
+                        const float* comps = mData.f + i * numComps;
+                        for (uint32_t c = 0; c < numComps; ++c)
+                        {
+                            bits.WriteFloat(comps[c]);
+                        }
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+    }
+}
+
+bool NetDatum::ReadNet(BitStream& bits)
+{
+    NetQuantize mode = NetQuantize(bits.ReadBits(kNetQuantizeTagBits));
+    uint32_t numComps = GetNumFloatComponents(mType);
+
+    Datum value;
+
+    if (mode == NetQuantize::None && !IsBitPackable(mType))
+    {
+        uint32_t size = bits.ReadVarUint(7);
+        if (size > OCT_MAX_MSG_BODY_SIZE)
+            return false;
+
+        char buffer[OCT_MAX_MSG_BODY_SIZE];
+        for (uint32_t b = 0; b < size; ++b)
+        {
+            buffer[b] = char(bits.ReadBits(8));
+        }
+
+        if (bits.IsOverflowed())
+            return false;
+
+        Stream stream(buffer, size);
+        value.ReadStream(stream, ASSET_VERSION_CURRENT, true, false);
+    }
+    else
+    {
+        // Both sides gather the same replicated data, so a mismatch means the message is corrupt.
+        bool valid = false;
+        switch (mode)
+        {
+            case NetQuantize::None: valid = IsBitPackable(mType); break;
+            case NetQuantize::Position:
+            case NetQuantize::Rotation:
+            case NetQuantize::Scale: valid = (mType == DatumType::Vector); break;
+            case NetQuantize::Bounded: valid = (mQuantize == NetQuantize::Bounded && numComps > 0); break;
+            default: break;
+        }
+
+        if (!valid)
+            return false;
+
+        float range = mQuantizeMax - mQuantizeMin;
+        uint32_t maxBounded = (1u << mQuantizeBits) - 1;
+
+        for (uint32_t i = 0; i < mCount; ++i)
+        {
+            if (mode == NetQuantize::None &&
+                numComps == 0)
+            {
+                switch (mType)
+                {
+                    case DatumType::Integer: value.PushBack(bits.ReadVarInt(7)); break;
+                    case DatumType::Bool: value.PushBack(bits.ReadBool()); break;
+                    case DatumType::Byte: value.PushBack(uint8_t(bits.ReadBits(8))); break;
+                    case DatumType::Short: value.PushBack(int16_t(bits.ReadBits(16))); break;
+                    default: break;
+                }
+
+                continue;
+            }
+
+            glm::vec4 comps = {};
+
+            switch (mode)
+            {
+                case NetQuantize::Position:
+                    for (uint32_t c = 0; c < 3; ++c)
+                    {
+                        comps[c] = bits.ReadVarInt(7) * NET_POSITION_PRECISION;
+                    }
+                    break;
+
+                case NetQuantize::Rotation:
+                    for (uint32_t c = 0; c < 3; ++c)
+                    {
+                        comps[c] = DequantizeAngle(bits.ReadBits(16));
+                    }
+                    break;
+
+                case NetQuantize::Scale:
+                {
+                    bool uniform = bits.ReadBool();
+                    for (uint32_t c = 0; c < (uniform ? 1u : 3u); ++c)
+                    {
+                        comps[c] = 1.0f + bits.ReadVarInt(4) * NET_SCALE_PRECISION;
+                    }
+
+                    if (uniform)
+                    {
+                        comps.y = comps.x;
+                        comps.z = comps.x;
+                    }
+                    break;
+                }
+
+                case NetQuantize::Bounded:
+                    for (uint32_t c = 0; c < numComps; ++c)
+                    {
+                        float alpha = float(bits.ReadBits(mQuantizeBits)) / maxBounded;
+                        comps[c] = mQuantizeMin + alpha * range;
+                    }
+                    break;
+
+                default:
+                    for (uint32_t c = 0; c < numComps; ++c)
+                    {
+                        comps[c] = bits.ReadFloat();
+                    }
+                    break;
+            }
+
+            switch (mType)
+            {
+                case DatumType::Float: value.PushBack(comps.x); break;
+                case DatumType::Vector2D: value.PushBack(glm::vec2(comps)); break;
+                case DatumType::Vector: value.PushBack(glm::vec3(comps)); break;
+                case DatumType::Color: value.PushBack(comps); break;
+                default: break;
+            }
+        }
+    }
+
+    if (bits.IsOverflowed())
+        return false;
+
+    if (value.mType == mType &&
+        value.mCount == mCount &&
+        *this != value)
+    {
+        SetValue(value.mData.vp, 0, mCount);
+    }
+
+    return true;
+}
+
 void NetDatum::Destroy()
 {
     if (mPrevData.vp != nullptr)
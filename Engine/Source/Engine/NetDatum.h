@@ -4,6 +4,23 @@
 
 #include <string>
 
+class BitStream;
+
+// How a NetDatum is packed into replication messages.
+enum class NetQuantize : uint8_t
+{
+    None,       // Full precision
+    Position,   // Vector in fixed point steps of NET_POSITION_PRECISION
+    Rotation,   // Vector of euler degrees, 16 bits per axis
+    Scale,      // Vector in fixed point steps of NET_SCALE_PRECISION
+    Bounded,    // Float/Vector2D/Vector/Color components in [min, max] using a fixed number of bits
+
+    Count
+};
+
+#define NET_POSITION_PRECISION (1.0f / 64.0f)
+#define NET_SCALE_PRECISION (1.0f / 1024.0f)
+
 class NetDatum : public Datum
 {
 public:
@@ -17,12 +34,29 @@ public:
         bool alwaysReplicate = false);
     bool ShouldReplicate() const;
     void PostReplicate();
+    bool IsAlwaysReplicated() const;
+
+    void SetQuantization(NetQuantize quantize);
+    void SetBoundedQuantization(float minValue, float maxValue, uint32_t numBits);
+    NetQuantize GetQuantization() const;
+
+    // Packs the value for a replicate message. Transform quantization is only applied if allowed,
+    // otherwise those datums are sent at full precision.
+    void WriteNet(BitStream& bits, bool quantizeTransform) const;
+
+    // Unpacks a value written by WriteNet() and applies it if it differs from the current value.
+    // Returns false if the data can't be decoded, in which case the rest of the message is unreadable.
+    bool ReadNet(BitStream& bits);
     
 protected:
     virtual void Destroy() override;
 
     DatumData mPrevData = {};
     uint32_t mPrevCount = 0;
+    float mQuantizeMin = 0.0f;
+    float mQuantizeMax = 1.0f;
+    uint8_t mQuantizeBits = 0;
+    NetQuantize mQuantize = NetQuantize::None;
     bool mAlwaysReplicate = false;
 };
 
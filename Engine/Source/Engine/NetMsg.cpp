@@ -6,6 +6,7 @@
 #include "Assets/Scene.h"
 #include "World.h"
 #include "Script.h"
+#include "BitStream.h"
 
 void NetSafeStringWrite(Stream& stream, const std::string& string)
 {
@@ -301,50 +302,70 @@ void NetMsgDestroy::Execute(NetHost sender)
     }
 }
 
+template<typename T>
+static void ApplyReplicatedData(std::vector<T>& repData, const NetMsgReplicate& msg)
+{
+    BitStream bits(msg.mPayload, msg.mPayloadSize);
+    uint32_t index = 0;
+
+    for (uint32_t i = 0; i < msg.mNumVariables; ++i)
+    {
+        index += bits.ReadVarUint();
+
+        if (index >= repData.size())
+        {
+            OCT_ASSERT(0);
+            LogError("Replicated index out of range.");
+            break;
+        }
+
+        // The variable sizes are only known by decoding them, so one bad variable
+        // leaves the rest of the message unreadable.
+        if (!repData[index].ReadNet(bits))
+        {
+            LogError("Failed to decode replicated variable %d on netid %08x.", index, msg.mNodeNetId);
+            break;
+        }
+
+        ++index;
+    }
+}
+
 void NetMsgReplicate::Read(Stream& stream)
 {
     NetMsg::Read(stream);
     mNodeNetId = stream.ReadUint32();
-    mNumVariables = stream.ReadUint16();
+    mNumVariables = stream.ReadUint8();
+    mPayloadSize = stream.ReadUint16();
 
     // Limiting max variables per message to 64.
     OCT_ASSERT(mNumVariables <= 64);
 
-    mIndices.clear();
-    mData.clear();
-
-    mIndices.resize(mNumVariables);
-    mData.resize(mNumVariables);
-
-    for (uint32_t i = 0; i < mNumVariables; ++i)
+    if (mPayloadSize > stream.GetSize() - stream.GetPos())
     {
-        mIndices[i] = stream.ReadUint16();
-
-        // We are assuming the stream data will persist for the duration
-        // of this message's life cycle (until Execute() is called).
-        // This avoids allocation and copying data.
-        mData[i].ReadStream(stream, ASSET_VERSION_CURRENT, true, false);
+        LogError("Replicate message payload exceeds packet size.");
+        mPayloadSize = 0;
+        mNumVariables = 0;
     }
+
+    // We are assuming the stream data will persist for the duration
+    // of this message's life cycle (until Execute() is called).
+    // This avoids allocation and copying data.
+    mPayload = (const uint8_t*)(stream.GetData() + stream.GetPos());
+    stream.SetPos(stream.GetPos() + mPayloadSize);
 }
 
 void NetMsgReplicate::Write(Stream& stream) const
 {
     NetMsg::Write(stream);
     stream.WriteUint32(mNodeNetId);
-    stream.WriteUint16(mNumVariables);
-
-    OCT_ASSERT(mIndices.size() == mNumVariables);
-    OCT_ASSERT(mData.size() == mNumVariables);
-
-    for (uint32_t i = 0; i < mNumVariables; ++i)
-    {
-        stream.WriteUint16(mIndices[i]);
-        mData[i].WriteStream(stream, true);
-    }
+    stream.WriteUint8(mNumVariables);
+    stream.WriteUint16(mPayloadSize);
+    stream.WriteBytes(mPayload, mPayloadSize);
 
     // Multiple replicate messages will need to be send for an actor
     // if it exceeds the message size limit.
-    OCT_ASSERT(stream.GetPos() < OCT_MAX_MSG_BODY_SIZE);
+    OCT_ASSERT(stream.GetPos() <= OCT_MAX_MSG_BODY_SIZE);
 }
 
 void NetMsgReplicate::Execute(NetHost sender)
@@ -355,30 +376,7 @@ void NetMsgReplicate::Execute(NetHost sender)
 
     if (node != nullptr)
     {
-        std::vector<NetDatum>& repData = node->GetReplicatedData();
-
-        for (uint32_t i = 0; i < mNumVariables; ++i)
-        {
-            uint16_t dstIndex = mIndices[i];
-            OCT_ASSERT(dstIndex < repData.size());
-
-            if (dstIndex < repData.size())
-            {
-                // Native net datum
-                OCT_ASSERT(repData[dstIndex].mType == mData[i].mType);
-                OCT_ASSERT(repData[dstIndex].mCount == mData[i].mCount);
-
-                if (repData[dstIndex] != mData[i])
-                {
-                    repData[dstIndex].SetValue(mData[i].mData.vp, 0, repData[dstIndex].mCount);
-                }
-            }
-            else
-            {
-                OCT_ASSERT(0);
-                LogError("Replicated index out of range.");
-            }
-        }
+        ApplyReplicatedData(node->GetReplicatedData(), *this);
     }
     else
     {
@@ -415,29 +413,7 @@ void NetMsgReplicateScript::Execute(NetHost sender)
 
         if (script != nullptr)
         {
-            std::vector<ScriptNetDatum>& repData = script->GetReplicatedData();
-
-            for (uint32_t i = 0; i < mNumVariables; ++i)
-            {
-                uint16_t dstIndex = mIndices[i];
-                OCT_ASSERT(dstIndex < repData.size());
-
-                if (dstIndex < repData.size())
-                {
-                    OCT_ASSERT(repData[dstIndex].mType == mData[i].mType);
-                    OCT_ASSERT(repData[dstIndex].mCount == mData[i].mCount);
-
-                    if (repData[dstIndex] != mData[i])
-                    {
-                        repData[dstIndex].SetValue(mData[i].mData.vp, 0, repData[dstIndex].mCount);
-                    }
-                }
-                else
-                {
-                    OCT_ASSERT(0);
-                    LogError("Replicated index out of range.");
-                }
-            }
+            ApplyReplicatedData(script->GetReplicatedData(), *this);
         }
         else
         {
@@ -646,3 +622,23 @@ void NetMsgAck::Execute(NetHost sender)
     NetMsg::Execute(sender);
     NetworkManager::Get()->HandleAck(sender, mSequenceNumber);
 }
+
+void NetMsgAckUnreliable::Read(Stream& stream)
+{
+    NetMsg::Read(stream);
+    mSequenceNumber = stream.ReadUint16();
+    mReceivedBits = stream.ReadUint32();
+}
+
+void NetMsgAckUnreliable::Write(Stream& stream) const
+{
+    NetMsg::Write(stream);
+    stream.WriteUint16(mSequenceNumber);
+    stream.WriteUint32(mReceivedBits);
+}
+
+void NetMsgAckUnreliable::Execute(NetHost sender)
+{
+    NetMsg::Execute(sender);
+    NetworkManager::Get()->HandleAckUnreliable(sender, mSequenceNumber, mReceivedBits);
+}
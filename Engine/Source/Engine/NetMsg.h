@@ -34,6 +34,7 @@ enum class NetMsgType : uint8_t
     InvokeScript,
     Broadcast,
     Ack,
+    AckUnreliable,
 
     Count
 };
@@ -133,10 +134,13 @@ struct NetMsgReplicate : public NetMsg
 
     virtual bool IsReliable() const override;
 
+    // Bit packed variables. Each one is an index delta (from the previous index + 1)
+    // followed by the data written with NetDatum::WriteNet().
+    // The payload points into the send/recv buffer and is only valid until Execute().
     NetId mNodeNetId = INVALID_TYPE_ID;
-    uint16_t mNumVariables = 0;
-    std::vector<uint16_t> mIndices;
-    std::vector<Datum> mData;
+    uint8_t mNumVariables = 0;
+    uint16_t mPayloadSize = 0;
+    const uint8_t* mPayload = nullptr;
     bool mReliable = false;
 };
 
@@ -186,3 +190,15 @@ struct NetMsgAck : public NetMsg
 
     uint16_t mSequenceNumber = 0;
 };
+
+// Sent by clients once a frame to tell the server which unreliable packets arrived,
+// so replicated variables can be compared against what the client actually has.
+struct NetMsgAckUnreliable : public NetMsg
+{
+    NET_MSG_INTERFACE(AckUnreliable);
+
+    // Latest unreliable sequence number received. Bit N of mReceivedBits
+    // is set if (mSequenceNumber - 1 - N) was also received.
+    uint16_t mSequenceNumber = 0;
+    uint32_t mReceivedBits = 0;
+};
@@ -0,0 +1,206 @@
+#include "NetRelevancyGrid.h"
+#include "Nodes/3D/Node3d.h"
+#include "Assertion.h"
+
+// 21 bits per axis, which covers +/- 1 million cells.
+static const int32_t kCellCoordBits = 21;
+static const uint64_t kCellCoordMask = (1ull << kCellCoordBits) - 1;
+
+void NetRelevancyGrid::SetCellSize(float cellSize)
+{
+    OCT_ASSERT(cellSize > 0.0f);
+
+    if (cellSize != mCellSize)
+    {
+        mCellSize = cellSize;
+
+        // Every node needs to be re-binned with the new cell size.
+        std::vector<Node3D*> nodes;
+        nodes.reserve(mEntries.size());
+        for (auto& it : mEntries)
+        {
+            nodes.push_back(it.first);
+        }
+
+        Clear();
+
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            Add(nodes[i]);
+        }
+    }
+}
+
+float NetRelevancyGrid::GetCellSize() const
+{
+    return mCellSize;
+}
+
+void NetRelevancyGrid::Add(Node3D* node)
+{
+    if (mEntries.find(node) != mEntries.end())
+        return;
+
+    GridEntry& entry = mEntries[node];
+    InsertIntoCell(node, entry, GetCellKey(node->GetWorldPosition()));
+    node->SetInRelevancyGrid(true);
+}
+
+void NetRelevancyGrid::Remove(Node3D* node)
+{
+    auto it = mEntries.find(node);
+
+    if (it != mEntries.end())
+    {
+        // Any queued move is skipped by Update() once the entry is gone.
+        RemoveFromCell(it->second);
+        mEntries.erase(it);
+        node->SetInRelevancyGrid(false);
+    }
+}
+
+void NetRelevancyGrid::Clear()
+{
+    for (auto& it : mEntries)
+    {
+        it.first->SetInRelevancyGrid(false);
+    }
+
+    mCells.clear();
+    mEntries.clear();
+    mMovedNodes.clear();
+}
+
+void NetRelevancyGrid::MarkMoved(Node3D* node)
+{
+    std::lock_guard<std::mutex> lock(mMovedMutex);
+
+    auto it = mEntries.find(node);
+    if (it != mEntries.end() && !it->second.mMoved)
+    {
+        it->second.mMoved = true;
+        mMovedNodes.push_back(node);
+    }
+}
+
+void NetRelevancyGrid::Update()
+{
+    // Re-binning resolves world transforms, which can dirty children and queue them again.
+    // Swap the list out first so those land in the next update instead of this loop.
+    static std::vector<Node3D*> sMovedNodes;
+    sMovedNodes.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mMovedMutex);
+        sMovedNodes.swap(mMovedNodes);
+
+        for (uint32_t i = 0; i < sMovedNodes.size(); ++i)
+        {
+            auto it = mEntries.find(sMovedNodes[i]);
+            if (it != mEntries.end())
+            {
+                it->second.mMoved = false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < sMovedNodes.size(); ++i)
+    {
+        auto it = mEntries.find(sMovedNodes[i]);
+
+        // Removed since it was marked.
+        if (it == mEntries.end())
+            continue;
+
+        uint64_t cell = GetCellKey(it->first->GetWorldPosition());
+
+        if (cell != it->second.mCell)
+        {
+            RemoveFromCell(it->second);
+            InsertIntoCell(it->first, it->second, cell);
+        }
+    }
+}
+
+void NetRelevancyGrid::Query(const glm::vec3& center, float radius, std::vector<Node3D*>& outNodes)
+{
+    ++mQueryStamp;
+
+    glm::ivec3 minCell = glm::ivec3(glm::floor((center - radius) / mCellSize));
+    glm::ivec3 maxCell = glm::ivec3(glm::floor((center + radius) / mCellSize));
+
+    for (int32_t x = minCell.x; x <= maxCell.x; ++x)
+    {
+        for (int32_t y = minCell.y; y <= maxCell.y; ++y)
+        {
+            for (int32_t z = minCell.z; z <= maxCell.z; ++z)
+            {
+                auto cellIt = mCells.find(GetCellKey(x, y, z));
+                if (cellIt == mCells.end())
+                    continue;
+
+                std::vector<Node3D*>& cellNodes = cellIt->second;
+                for (uint32_t i = 0; i < cellNodes.size(); ++i)
+                {
+                    mEntries[cellNodes[i]].mQueryStamp = mQueryStamp;
+                    outNodes.push_back(cellNodes[i]);
+                }
+            }
+        }
+    }
+}
+
+bool NetRelevancyGrid::WasInLastQuery(Node3D* node) const
+{
+    auto it = mEntries.find(node);
+    return (it != mEntries.end() && it->second.mQueryStamp == mQueryStamp);
+}
+
+bool NetRelevancyGrid::Contains(Node3D* node) const
+{
+    return (mEntries.find(node) != mEntries.end());
+}
+
+uint64_t NetRelevancyGrid::GetCellKey(const glm::vec3& position) const
+{
+    glm::ivec3 cell = glm::ivec3(glm::floor(position / mCellSize));
+    return GetCellKey(cell.x, cell.y, cell.z);
+}
+
+uint64_t NetRelevancyGrid::GetCellKey(int32_t x, int32_t y, int32_t z) const
+{
+    return (uint64_t(x) & kCellCoordMask) |
+        ((uint64_t(y) & kCellCoordMask) << kCellCoordBits) |
+        ((uint64_t(z) & kCellCoordMask) << (kCellCoordBits * 2));
+}
+
+void NetRelevancyGrid::InsertIntoCell(Node3D* node, GridEntry& entry, uint64_t cell)
+{
+    std::vector<Node3D*>& cellNodes = mCells[cell];
+    entry.mCell = cell;
+    entry.mIndex = uint32_t(cellNodes.size());
+    cellNodes.push_back(node);
+}
+
+void NetRelevancyGrid::RemoveFromCell(GridEntry& entry)
+{
+    auto cellIt = mCells.find(entry.mCell);
+    OCT_ASSERT(cellIt != mCells.end());
+
+    if (cellIt != mCells.end())
+    {
+        // Swap with the last node in the cell and fix up its index.
+        std::vector<Node3D*>& cellNodes = cellIt->second;
+        OCT_ASSERT(entry.mIndex < cellNodes.size());
+
+        Node3D* lastNode = cellNodes.back();
+        cellNodes[entry.mIndex] = lastNode;
+        mEntries[lastNode].mIndex = entry.mIndex;
+        cellNodes.pop_back();
+
+        if (cellNodes.size() == 0)
+        {
+            mCells.erase(cellIt);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+#include "Maths.h"
+
+class Node3D;
+
+// Hash grid of replicated 3D nodes, used by the server to find the nodes near each client's pawn
+// without testing every net node against every client. The cell size matches the relevancy
+// distance, so a relevancy query only ever touches the 3x3x3 block of cells around the pawn.
+class NetRelevancyGrid
+{
+public:
+
+    void SetCellSize(float cellSize);
+    float GetCellSize() const;
+
+    void Add(Node3D* node);
+    void Remove(Node3D* node);
+    void Clear();
+
+    // Queues a member for re-binning on the next Update(). Called by Node3D whenever its
+    // transform is dirtied, which may happen from a parallel tick.
+    void MarkMoved(Node3D* node);
+
+    // Moves nodes marked since the last update that crossed into a different cell.
+    void Update();
+
+    // Appends every node in a cell touching the sphere. Also stamps them with a new query id
+    // so WasInLastQuery() can tell which nodes were not returned.
+    void Query(const glm::vec3& center, float radius, std::vector<Node3D*>& outNodes);
+    bool WasInLastQuery(Node3D* node) const;
+    bool Contains(Node3D* node) const;
+
+protected:
+
+    struct GridEntry
+    {
+        uint64_t mCell = 0;
+        uint32_t mIndex = 0;
+        uint32_t mQueryStamp = 0;
+        bool mMoved = false;
+    };
+
+    uint64_t GetCellKey(const glm::vec3& position) const;
+    uint64_t GetCellKey(int32_t x, int32_t y, int32_t z) const;
+    void InsertIntoCell(Node3D* node, GridEntry& entry, uint64_t cell);
+    void RemoveFromCell(GridEntry& entry);
+
+    std::unordered_map<uint64_t, std::vector<Node3D*> > mCells;
+    std::unordered_map<Node3D*, GridEntry> mEntries;
+    std::vector<Node3D*> mMovedNodes;
+    std::mutex mMovedMutex; // Guards mMovedNodes and GridEntry::mMoved.
+    float mCellSize = 200.0f;
+    uint32_t mQueryStamp = 0;
+};
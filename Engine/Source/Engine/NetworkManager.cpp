@@ -2,11 +2,15 @@
 #include "Engine.h"
 #include "Log.h"
 #include "Nodes/Node.h"
+#include "Nodes/3D/Node3d.h"
 #include "Assets/Scene.h"
 #include "World.h"
 #include "Profiler.h"
 #include "Maths.h"
 #include "Script.h"
+#include "BitStream.h"
+
+#include "System/System.h"
 
 #include "LuaBindings/Network_Lua.h"
 
@@ -90,6 +94,53 @@ void UpdateDebugPackets(float deltaTime)
 static NetMsgReplicate sMsgReplicate;
 static NetMsgReplicateScript sMsgReplicateScript;
 
+// Encoded replicated variables of one node's native or script data.
+struct RepEncoding
+{
+    std::vector<BitStream> mBits;
+    std::vector<uint64_t> mHashes;
+    std::vector<uint8_t> mAlways;
+    uint32_t mNumVars = 0;
+};
+
+// Delta replication scratch data. Each replicated variable is encoded once and then copied into
+// the messages of every client that hasn't acked that exact value yet. During prioritized
+// replication, encodings are cached so a node sent to several clients is only encoded once per tick.
+static RepEncoding sRepScratchEncoding;
+static const RepEncoding* sRepEncoding = nullptr;
+static std::deque<RepEncoding> sRepEncodingCache;
+static std::unordered_map<uint64_t, uint32_t> sRepEncodingMap;
+static uint32_t sNumCachedRepEncodings = 0;
+static bool sCacheRepEncodings = false;
+static BitStream sRepPayload;
+static std::vector<NetRepRecord> sRepRecords;
+static std::vector<NetClient*> sRepTargets;
+
+struct RepCandidate
+{
+    Node* mNode = nullptr;
+    NetNodeBaseline* mBaseline = nullptr;
+    float mPriority = 0.0f;
+    bool mForce = false;
+};
+
+static std::vector<RepCandidate> sRepCandidates;
+static std::vector<RepCandidate> sClientRepCandidates;
+
+// Relevancy grid query scratch data.
+static std::vector<Node3D*> sGridNodes;
+static std::vector<Node*> sGridLeavingNodes;
+
+// How many seconds of bandwidth budget a client can save up while idle.
+static const float kMaxBudgetBurstTime = 0.25f;
+
+// Nodes with changes that the client hasn't acked yet get their priority boosted by this much.
+static const float kPendingChangePriorityScale = 4.0f;
+
+// Replicated packets kept around per client waiting for an ack. Unreliable acks cover the last 32 packets.
+static const uint32_t kMaxRepPacketRecords = 64;
+static const uint32_t kUnreliableAckWindow = 32;
+
 // Reliable messaging
 static float sReliableResendTime = 0.1f;
 static uint32_t sMaxReliableResends = 20;
@@ -253,7 +304,9 @@ void NetworkManager::PreTickUpdate(float deltaTime)
     if (mNetStatus != NetStatus::Local)
     {
         // Handle incoming messages from the server or clients
+        uint64_t incomingStartTime = SYS_GetTimeMicroseconds();
         ProcessIncomingPackets(deltaTime);
+        mStats.mIncomingTimeUs += SYS_GetTimeMicroseconds() - incomingStartTime;
 
         // Handle upkeep of unreliable messages that still need ACKs from recipients
         UpdateReliablePackets(deltaTime);
@@ -280,7 +333,9 @@ void NetworkManager::PostTickUpdate(float deltaTime)
     if (mNetStatus == NetStatus::Server)
     {
         // Server needs to send replicated actor data to clients
+        uint64_t repStartTime = SYS_GetTimeMicroseconds();
         UpdateReplication(deltaTime);
+        mStats.mReplicationTimeUs += SYS_GetTimeMicroseconds() - repStartTime;
 
         mBroadcastTimer -= deltaTime;
         if (mBroadcastTimer <= 0.0f)
@@ -299,6 +354,8 @@ void NetworkManager::PostTickUpdate(float deltaTime)
             SendMessage(&pingMsg, &mServer);
             mPingTimer = 0.0f;
         }
+
+        SendUnreliableAck(&mServer);
     }
 
     FlushSendBuffers();
@@ -306,6 +363,8 @@ void NetworkManager::PostTickUpdate(float deltaTime)
 #if DEBUG_NETWORK_CONDITIONS
     UpdateDebugPackets(deltaTime);
 #endif
+
+    mStats.mTicks++;
 }
 
 void NetworkManager::Login()
@@ -603,6 +662,26 @@ bool NetworkManager::IsReliableReplicationEnabled() const
     return mEnableReliableReplication;
 }
 
+void NetworkManager::EnableTransformQuantization(bool enable)
+{
+    mEnableTransformQuantization = enable;
+}
+
+bool NetworkManager::IsTransformQuantizationEnabled() const
+{
+    return mEnableTransformQuantization;
+}
+
+void NetworkManager::SetBandwidthBudget(uint32_t bytesPerSecond)
+{
+    mBandwidthBudget = bytesPerSecond;
+}
+
+uint32_t NetworkManager::GetBandwidthBudget() const
+{
+    return mBandwidthBudget;
+}
+
 void NetworkManager::Connect(const char* ipAddress, uint16_t port)
 {
     uint32_t ipAddrInt = NET_IpStringToUint32(ipAddress);
@@ -776,6 +855,8 @@ void NetworkManager::SendMessage(const NetMsg* netMsg, NetHostProfile* hostProfi
         uint32_t startByte = (uint32_t)sendBuffer.size();
         sendBuffer.resize(sendBuffer.size() + stream.GetPos());
         memcpy(sendBuffer.data() + startByte, stream.GetData(), stream.GetPos());
+
+        mStats.mMessagesSent++;
     }
 }
 
@@ -876,6 +957,11 @@ bool NetworkManager::IsIncrementalReplicationEnabled() const
 void NetworkManager::SetRelevancyDistance(float dist)
 {
     mRelevancyDistanceSquared = (dist * dist);
+
+    if (dist > 0.0f)
+    {
+        mRelevancyGrid.SetCellSize(dist);
+    }
 }
 
 void NetworkManager::EnableNetRelevancy(bool enable)
@@ -970,6 +1056,16 @@ float NetworkManager::GetDownloadRate() const
     return mDownloadRate;
 }
 
+const NetStats& NetworkManager::GetStats() const
+{
+    return mStats;
+}
+
+void NetworkManager::ResetStats()
+{
+    mStats = NetStats();
+}
+
 
 bool NetworkManager::IsServer() const
 {
@@ -1033,6 +1129,8 @@ void NetworkManager::AddNetNode(Node* node, NetId netId)
                 // The server needs to send Spawn messages for newly added network actors.
                 if (NetIsServer())
                 {
+                    UpdateRelevancyGridEntry(node);
+
                     if (mEnableNetRelevancy)
                     {
                         // Update node relevancy, which will cause NetMsgSpawn to be sent
@@ -1065,6 +1163,11 @@ void NetworkManager::RemoveNetNode(Node* node)
         OCT_ASSERT(mNetNodeMap.find(netId) != mNetNodeMap.end());
         mNetNodeMap.erase(netId);
 
+        if (node->IsNode3D())
+        {
+            mRelevancyGrid.Remove(static_cast<Node3D*>(node));
+        }
+
         for (uint32_t i = 0; i < mNetNodes.size(); ++i)
         {
             if (mNetNodes[i] == node)
@@ -1322,6 +1425,49 @@ void NetworkManager::HandleAck(NetHost host, uint16_t sequenceNumber)
                 break;
             }
         }
+
+        std::deque<NetRepPacket>& repPackets = profile->mSentRepPackets[1];
+
+        for (auto it = repPackets.begin(); it != repPackets.end(); ++it)
+        {
+            if (it->mSeq == sequenceNumber)
+            {
+                ApplyRepRecords(profile, *it);
+                repPackets.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+void NetworkManager::HandleAckUnreliable(NetHost host, uint16_t sequenceNumber, uint32_t receivedBits)
+{
+    NetClient* client = FindNetClient(host.mId);
+
+    if (client != nullptr)
+    {
+        std::deque<NetRepPacket>& repPackets = client->mSentRepPackets[0];
+
+        while (repPackets.size() > 0 &&
+               !SeqNumLess(sequenceNumber, repPackets.front().mSeq))
+        {
+            // The client drops unreliable packets older than its latest one, so anything
+            // at or before the acked seq that isn't marked received is never going to arrive.
+            uint16_t age = uint16_t(sequenceNumber - repPackets.front().mSeq);
+            bool received = (age == 0) ||
+                (age <= kUnreliableAckWindow && (receivedBits & (1u << (age - 1))) != 0);
+
+            if (received)
+            {
+                ApplyRepRecords(client, repPackets.front());
+            }
+            else
+            {
+                ExpireRepRecords(client, repPackets.front());
+            }
+
+            repPackets.pop_front();
+        }
     }
 }
 
@@ -1419,39 +1565,123 @@ void NetworkManager::HandleBroadcast(
     }
 }
 
-static const uint32_t RepMsgHeaderSize = 
+// Type, net id, num variables and payload size.
+static const uint32_t RepMsgHeaderSize =
+    sizeof(uint8_t) +
     sizeof(NetMsgReplicate::mNodeNetId) +
-    sizeof(NetMsgReplicate::mNumVariables);
+    sizeof(NetMsgReplicate::mNumVariables) +
+    sizeof(NetMsgReplicate::mPayloadSize);
 
-static const uint32_t MaxDatumNetSerializeSize = 
-    OCT_MAX_MSG_BODY_SIZE - 
-    RepMsgHeaderSize -
-    sizeof(uint16_t); // 1 index
+static const uint32_t MaxRepPayloadBits = (OCT_MAX_MSG_BODY_SIZE - RepMsgHeaderSize) * 8;
+static const uint32_t MaxRepVarsPerMsg = 64;
 
-void NetworkManager::SendReplicateMsg(NetMsgReplicate& repMsg, uint32_t& numVars, NetHostId hostId)
+void NetworkManager::SendReplicateMsg(NetMsgReplicate& msg, BitStream& payload, uint32_t& numVars, NetClient* client, bool reliable)
 {
-    OCT_ASSERT(numVars > 0);
+    OCT_ASSERT(numVars > 0 && numVars <= MaxRepVarsPerMsg);
 
-    repMsg.mNumVariables = numVars;
+    msg.mNumVariables = uint8_t(numVars);
+    msg.mPayload = payload.GetData();
+    msg.mPayloadSize = uint16_t(payload.GetNumBytes());
+    msg.mReliable = reliable;
 
-    if (hostId == INVALID_HOST_ID)
+    SendMessage(&msg, client);
+    mRepBytesQueued += RepMsgHeaderSize + msg.mPayloadSize;
+
+    // SendMessage() flushes the buffer before appending the message if needed,
+    // so these records belong to whatever packet the buffer ends up in.
+    std::vector<NetRepRecord>& pending = client->mPendingRepRecords[reliable ? 1 : 0];
+    pending.insert(pending.end(), sRepRecords.begin(), sRepRecords.end());
+
+    sRepRecords.clear();
+    payload.Clear();
+    msg.mPayload = nullptr;
+    msg.mPayloadSize = 0;
+    numVars = 0;
+}
+
+void NetworkManager::ApplyRepRecords(NetHostProfile* profile, const NetRepPacket& packet)
+{
+    for (uint32_t i = 0; i < packet.mRecords.size(); ++i)
     {
-        SendMessageToAllRelevantClients(&repMsg, repMsg.mNodeNetId);
+        const NetRepRecord& record = packet.mRecords[i];
+
+        auto it = profile->mBaselines.find(record.mNetId);
+        if (it == profile->mBaselines.end())
+            continue;
+
+        NetNodeBaseline& baseline = it->second;
+        std::vector<NetVarBaseline>& vars = baseline.mVars[record.mScript];
+
+        // An older packet may be acked after a newer one, so only move the baseline forward.
+        if (record.mRepId >= baseline.mVarsResetRepId[record.mScript] &&
+            record.mIndex < vars.size() &&
+            record.mRepId > vars[record.mIndex].mAckedRepId)
+        {
+            NetVarBaseline& var = vars[record.mIndex];
+            bool wasUnacked = (var.mSentRepId > var.mAckedRepId);
+
+            var.mAckedRepId = record.mRepId;
+            var.mAckedHash = record.mHash;
+
+            if (wasUnacked && var.mSentRepId <= var.mAckedRepId)
+            {
+                OCT_ASSERT(baseline.mNumUnacked > 0);
+                baseline.mNumUnacked--;
+            }
+
+            // An older value was acked after a newer one was sent. Look at the variable again
+            // in case the newer send doesn't make it.
+            if (var.mAckedHash != var.mSentHash)
+            {
+                baseline.mDirty[record.mScript] = true;
+            }
+        }
     }
-    else
+}
+
+void NetworkManager::ExpireRepRecords(NetHostProfile* profile, const NetRepPacket& packet)
+{
+    for (uint32_t i = 0; i < packet.mRecords.size(); ++i)
     {
-        bool relevant = IsNetIdRelevantToHost(repMsg.mNodeNetId, hostId);
+        const NetRepRecord& record = packet.mRecords[i];
 
-        if (relevant)
+        auto it = profile->mBaselines.find(record.mNetId);
+        if (it == profile->mBaselines.end())
+            continue;
+
+        NetNodeBaseline& baseline = it->second;
+        std::vector<NetVarBaseline>& vars = baseline.mVars[record.mScript];
+
+        // Only the latest send of a variable is tracked. If a newer one is in flight, wait for that instead.
+        if (record.mRepId >= baseline.mVarsResetRepId[record.mScript] &&
+            record.mIndex < vars.size() &&
+            record.mRepId == vars[record.mIndex].mSentRepId &&
+            record.mRepId > vars[record.mIndex].mAckedRepId)
         {
-            SendMessage(&repMsg, hostId);
+            NetVarBaseline& var = vars[record.mIndex];
+
+            // Go back to what the client is known to have, so the variable is sent again if it differs.
+            var.mSentRepId = var.mAckedRepId;
+            var.mSentHash = var.mAckedHash;
+            baseline.mDirty[record.mScript] = true;
+
+            OCT_ASSERT(baseline.mNumUnacked > 0);
+            baseline.mNumUnacked--;
         }
     }
+}
 
-    repMsg.mIndices.clear();
-    repMsg.mData. clear();
-    repMsg.mNumVariables = 0;
-    numVars = 0;
+void NetworkManager::SendUnreliableAck(NetHostProfile* profile)
+{
+    if (profile->mUnreliableAckPending)
+    {
+        NetMsgAckUnreliable ackMsg;
+        ackMsg.mSequenceNumber = profile->mLatestUnreliableSeq;
+        ackMsg.mReceivedBits = profile->mUnreliableReceivedBits;
+        SendMessage(&ackMsg, profile);
+
+        profile->mUnreliableAckPending = false;
+    }
 }
 
 void NetworkManager::SendInvokeMsg(NetMsgInvoke& msg, Node* node, NetFunc* func, uint32_t numParams, const Datum** params)
@@ -1577,6 +1807,7 @@ void NetworkManager::ResendPacket(NetHostProfile* hostProfile, ReliablePacket& p
 
     packet.mTimeSinceSend = 0.0f;
     packet.mNumSends++;
+    mStats.mReliableResends++;
 }
 
 void NetworkManager::ResendOutgoingReliablePackets(NetHostProfile* hostProfile)
@@ -1639,6 +1870,10 @@ void NetworkManager::UpdateReplication(float deltaTime)
     if (mNetNodes.size() > 0 &&
         mEnableNetRelevancy)
     {
+        // Nodes entering and leaving each pawn's relevancy radius are found through the grid every frame.
+        UpdateGridRelevancy();
+
+        // The slow sweep still covers everything else (non-3D nodes, pawns changing, always relevant toggling).
         const uint32_t kRelevancyUpdatesPerFrame = 10;
 
         if (mRelevancyUpdateIndex >= mNetNodes.size())
@@ -1653,6 +1888,12 @@ void NetworkManager::UpdateReplication(float deltaTime)
         }
     }
 
+    if (mBandwidthBudget > 0)
+    {
+        UpdatePrioritizedReplication(deltaTime, incRepNode);
+        return;
+    }
+
     // Do the replication
     uint32_t numNodesReplicated = 0;
     float remainingDeltaTime = deltaTime;
@@ -1697,55 +1938,384 @@ void NetworkManager::UpdateReplication(float deltaTime)
     }
 }
 
-template<typename T>
-bool ReplicateData(std::vector<T>& repData, NetMsgReplicate& msg, NetId hostId, bool force, bool reliable)
+static uint64_t HashRepBits(const BitStream& bits)
 {
-    // msg.mNetId should already be set by caller.
-    msg.mIndices.clear();
-    msg.mData.clear();
-    msg.mReliable = reliable;
+    // FNV-1a over the encoded bytes. Unused bits in the last byte are always 0.
+    uint64_t hash = 14695981039346656037ull;
+    const uint8_t* data = bits.GetData();
 
-    bool replicated = false;
-    uint32_t numVars = 0;
+    for (uint32_t i = 0; i < bits.GetNumBytes(); ++i)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
 
-    uint32_t msgSerializedSize = RepMsgHeaderSize;
+    return (hash ^ bits.GetNumBits()) * 1099511628211ull;
+}
 
-    for (uint32_t i = 0; i < repData.size(); ++i)
+static uint32_t GetVarUintBits(uint32_t value)
+{
+    // Matches BitStream::WriteVarUint() with the default 4 bit groups.
+    uint32_t numBits = 5;
+    while (value >= 16)
     {
-        if (force || repData[i].ShouldReplicate())
+        value >>= 4;
+        numBits += 5;
+    }
+
+    return numBits;
+}
+
+void NetworkManager::UpdatePrioritizedReplication(float deltaTime, Node* incRepNode)
+{
+    // Forced replication is cleared by the first ReplicateNode() call, so grab it up front.
+    sRepCandidates.clear();
+    sRepCandidates.resize(mNetNodes.size());
+
+    for (uint32_t i = 0; i < mNetNodes.size(); ++i)
+    {
+        sRepCandidates[i].mNode = mNetNodes[i];
+        sRepCandidates[i].mForce = mNetNodes[i]->NeedsForcedReplication();
+    }
+
+    float maxBudget = mBandwidthBudget * glm::max(kMaxBudgetBurstTime, deltaTime);
+
+    // Nodes don't change while replicating to each client, so share their encodings.
+    sRepEncodingMap.clear();
+    sNumCachedRepEncodings = 0;
+    sCacheRepEncodings = true;
+
+    auto compareCandidates = [](const RepCandidate& a, const RepCandidate& b)
+    {
+        return a.mPriority < b.mPriority;
+    };
+
+    for (uint32_t c = 0; c < mClients.size(); ++c)
+    {
+        NetClient* client = &mClients[c];
+
+        // Unspent budget carries over a little, overspending is paid back over the next frames.
+        client->mRepBudget = glm::min(client->mRepBudget + mBandwidthBudget * deltaTime, maxBudget);
+
+        if (!client->mReady)
+            continue;
+
+        Node* pawn = client->mPawn.Get<Node>();
+        sClientRepCandidates.clear();
+
+        // Priority accumulates every frame based on the node's own priority and its
+        // distance to the client's pawn, so nodes that have waited longest bubble up.
+        for (uint32_t i = 0; i < sRepCandidates.size(); ++i)
         {
-            // First check if the replicated variable will fit into the message.
-            // If not, we will need to send a message for all of the replicated vars
-            // that have been processed to this point, and then begin a new message.
-            uint32_t datumSerializeSize = repData[i].GetSerializationSize(true);
+            RepCandidate candidate = sRepCandidates[i];
+            Node* node = candidate.mNode;
+            NetId netId = node->GetNetId();
 
-            // If the replicated variable is too large, then skip it.
-            if (datumSerializeSize > MaxDatumNetSerializeSize)
+            if (mEnableNetRelevancy &&
+                client->mRelevantNetIds.find(netId) == client->mRelevantNetIds.end())
             {
-                LogWarning("Replicated variable too large to replicate. Most likely a big string.");
                 continue;
             }
-            else if (msgSerializedSize + datumSerializeSize > OCT_MAX_MSG_BODY_SIZE)
+
+            float rate = node->GetNetPriority();
+
+            if (pawn != nullptr)
             {
-                // Send what we have until now
-                NetworkManager::Get()->SendReplicateMsg(msg, numVars, hostId);
-                msgSerializedSize = RepMsgHeaderSize;
-                replicated = true;
+                rate *= node->GetNetPriorityScale(pawn);
             }
 
-            msg.mIndices.push_back((uint16_t)i);
-            msg.mData.push_back(Datum(repData[i]));
+            // The baseline is created here if the node hasn't been sent to this client yet.
+            NetNodeBaseline& baseline = client->mBaselines[netId];
+            if (baseline.mVars[0].size() == 0 ||
+                baseline.mDirty[0] ||
+                baseline.mDirty[1] ||
+                baseline.mNumUnacked > 0)
+            {
+                rate *= kPendingChangePriorityScale;
+            }
 
-            numVars++;
-            msgSerializedSize += datumSerializeSize;
+            baseline.mRepPriority += rate * deltaTime;
+            candidate.mBaseline = &baseline;
+            candidate.mPriority = (candidate.mForce || node == incRepNode) ? FLT_MAX : baseline.mRepPriority;
+            sClientRepCandidates.push_back(candidate);
+        }
+
+        // The budget usually only covers a few nodes, so pop them off a heap instead of sorting everything.
+        std::make_heap(sClientRepCandidates.begin(), sClientRepCandidates.end(), compareCandidates);
+        auto heapEnd = sClientRepCandidates.end();
+
+        while (heapEnd != sClientRepCandidates.begin())
+        {
+            const RepCandidate& top = sClientRepCandidates.front();
+            bool force = (top.mPriority == FLT_MAX);
+
+            if (client->mRepBudget <= 0.0f && !force)
+                break;
+
+            std::pop_heap(sClientRepCandidates.begin(), heapEnd, compareCandidates);
+            --heapEnd;
+            RepCandidate& candidate = *heapEnd;
+
+            mRepBytesQueued = 0;
+            bool replicated = ReplicateNode(candidate.mNode, client->mHost.mId, force, false);
+            client->mRepBudget -= float(mRepBytesQueued);
+
+            // Nodes the client already has keep their priority, so they stay near the front once they do change.
+            if (replicated)
+            {
+                candidate.mBaseline->mRepPriority = 0.0f;
+            }
+        }
+    }
+
+    sCacheRepEncodings = false;
+
+    for (uint32_t i = 0; i < sRepCandidates.size(); ++i)
+    {
+        sRepCandidates[i].mNode->ClearForcedReplication();
+    }
+}
+
+template<typename T>
+bool NetworkManager::ReplicateData(std::vector<T>& repData, NetMsgReplicate& msg, NetHostId hostId, bool force, bool reliable)
+{
+    // msg.mNodeNetId should already be set by caller.
+    NetId netId = msg.mNodeNetId;
+    bool script = (msg.GetType() == NetMsgType::ReplicateScript);
+    uint32_t set = script ? 1 : 0;
+
+    bool changed = false;
+    for (uint32_t i = 0; i < repData.size(); ++i)
+    {
+        if (repData[i].ShouldReplicate())
+        {
+            changed = true;
             repData[i].PostReplicate();
         }
     }
 
-    if (numVars > 0)
+    // Change detection is shared by every client, so remember the change for
+    // the clients that aren't being replicated to right now.
+    if (changed)
+    {
+        for (uint32_t c = 0; c < mClients.size(); ++c)
+        {
+            auto it = mClients[c].mBaselines.find(netId);
+            if (it != mClients[c].mBaselines.end())
+            {
+                it->second.mDirty[set] = true;
+            }
+        }
+    }
+
+    sRepTargets.clear();
+
+    if (hostId == INVALID_HOST_ID)
+    {
+        for (uint32_t c = 0; c < mClients.size(); ++c)
+        {
+            if (!mEnableNetRelevancy ||
+                mClients[c].mRelevantNetIds.find(netId) != mClients[c].mRelevantNetIds.end())
+            {
+                sRepTargets.push_back(&mClients[c]);
+            }
+        }
+    }
+    else if (IsNetIdRelevantToHost(netId, hostId))
+    {
+        NetClient* client = FindNetClient(hostId);
+        if (client != nullptr)
+        {
+            sRepTargets.push_back(client);
+        }
+    }
+
+    // Skip clients that already have (or are being sent) everything. Lost packets
+    // keep the baseline unacked, so those clients still get another look.
+    for (int32_t t = int32_t(sRepTargets.size()) - 1; t >= 0; --t)
+    {
+        auto it = sRepTargets[t]->mBaselines.find(netId);
+        bool needed = force ||
+            it == sRepTargets[t]->mBaselines.end() ||
+            it->second.mVars[set].size() != repData.size() ||
+            it->second.mDirty[set] ||
+            it->second.mNumUnacked > 0;
+
+        if (!needed)
+        {
+            sRepTargets.erase(sRepTargets.begin() + t);
+        }
+    }
+
+    if (sRepTargets.size() == 0)
+        return false;
+
+    // Encode each variable once. Clients receive a copy of the bits for the variables they need.
+    RepEncoding* encoding = &sRepScratchEncoding;
+    bool encode = true;
+
+    if (sCacheRepEncodings)
+    {
+        uint64_t key = (uint64_t(netId) << 1) | set;
+        auto it = sRepEncodingMap.find(key);
+
+        if (it != sRepEncodingMap.end())
+        {
+            encoding = &sRepEncodingCache[it->second];
+            encode = false;
+        }
+        else
+        {
+            if (sNumCachedRepEncodings == sRepEncodingCache.size())
+            {
+                sRepEncodingCache.emplace_back();
+            }
+
+            encoding = &sRepEncodingCache[sNumCachedRepEncodings];
+            sRepEncodingMap.insert({ key, sNumCachedRepEncodings });
+            sNumCachedRepEncodings++;
+        }
+    }
+
+    if (encode)
+    {
+        encoding->mNumVars = (uint32_t)repData.size();
+        if (encoding->mBits.size() < encoding->mNumVars)
+        {
+            encoding->mBits.resize(encoding->mNumVars);
+        }
+
+        encoding->mHashes.resize(encoding->mNumVars);
+        encoding->mAlways.resize(encoding->mNumVars);
+
+        for (uint32_t i = 0; i < encoding->mNumVars; ++i)
+        {
+            encoding->mBits[i].Clear();
+            repData[i].WriteNet(encoding->mBits[i], mEnableTransformQuantization);
+            encoding->mHashes[i] = HashRepBits(encoding->mBits[i]);
+            encoding->mAlways[i] = repData[i].IsAlwaysReplicated();
+        }
+    }
+
+    sRepEncoding = encoding;
+
+    bool replicated = false;
+
+    for (uint32_t t = 0; t < sRepTargets.size(); ++t)
+    {
+        replicated = ReplicateDataToClient(sRepTargets[t], msg, script, force, reliable) || replicated;
+    }
+
+    return replicated;
+}
+
+#ifndef NDEBUG
+static uint32_t CountUnackedVars(const std::vector<NetVarBaseline>& vars)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < vars.size(); ++i)
+    {
+        if (vars[i].mSentRepId > vars[i].mAckedRepId)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+#endif
+
+bool NetworkManager::ReplicateDataToClient(NetClient* client, NetMsgReplicate& msg, bool script, bool force, bool reliable)
+{
+    const RepEncoding& encoding = *sRepEncoding;
+    NetNodeBaseline& baseline = client->mBaselines[msg.mNodeNetId];
+    std::vector<NetVarBaseline>& vars = baseline.mVars[script ? 1 : 0];
+    baseline.mDirty[script ? 1 : 0] = false;
+
+    uint32_t repId = client->mNextRepId++;
+
+    // Script replicated data is re-gathered when the script restarts, so the count can change.
+    if (vars.size() != encoding.mNumVars)
+    {
+        // Sends still in flight for the old vars will never be acked or expired against the new ones,
+        // so stop counting them now. Their records are ignored from here on.
+        for (uint32_t i = 0; i < vars.size(); ++i)
+        {
+            if (vars[i].mSentRepId > vars[i].mAckedRepId)
+            {
+                OCT_ASSERT(baseline.mNumUnacked > 0);
+                baseline.mNumUnacked--;
+            }
+        }
+
+        vars.clear();
+        vars.resize(encoding.mNumVars);
+        baseline.mVarsResetRepId[script ? 1 : 0] = repId;
+        force = true;
+
+        // Whatever is still unacked must belong to the other set.
+        OCT_ASSERT(baseline.mNumUnacked == CountUnackedVars(baseline.mVars[script ? 0 : 1]));
+    }
+    bool replicated = false;
+    uint32_t numMsgVars = 0;
+    uint32_t nextIndex = 0;
+
+    BitStream& payload = sRepPayload;
+    payload.Clear();
+    sRepRecords.clear();
+
+    for (uint32_t i = 0; i < encoding.mNumVars; ++i)
+    {
+        NetVarBaseline& var = vars[i];
+        // Compare against the latest value sent. If it's lost, the send expires and falls back to the acked value.
+        bool upToDate = (var.mSentRepId != 0 && var.mSentHash == encoding.mHashes[i]);
+
+        if (upToDate && !force && !encoding.mAlways[i])
+            continue;
+
+        uint32_t varBits = encoding.mBits[i].GetNumBits();
+
+        // If the replicated variable is too large, then skip it.
+        if (GetVarUintBits(i) + varBits > MaxRepPayloadBits)
+        {
+            LogWarning("Replicated variable too large to replicate. Most likely a big string.");
+            continue;
+        }
+
+        // If the variable won't fit, send what we have until now and begin a new message.
+        if (numMsgVars == MaxRepVarsPerMsg ||
+            payload.GetNumBits() + GetVarUintBits(i - nextIndex) + varBits > MaxRepPayloadBits)
+        {
+            SendReplicateMsg(msg, payload, numMsgVars, client, reliable);
+            nextIndex = 0;
+            replicated = true;
+        }
+
+        payload.WriteVarUint(i - nextIndex);
+        payload.WriteStreamBits(encoding.mBits[i], 0, varBits);
+        nextIndex = i + 1;
+        numMsgVars++;
+
+        NetRepRecord record;
+        record.mNetId = msg.mNodeNetId;
+        record.mRepId = repId;
+        record.mHash = encoding.mHashes[i];
+        record.mIndex = uint16_t(i);
+        record.mScript = script ? 1 : 0;
+        sRepRecords.push_back(record);
+
+        if (var.mSentRepId <= var.mAckedRepId)
+        {
+            baseline.mNumUnacked++;
+        }
+
+        var.mSentRepId = repId;
+        var.mSentHash = encoding.mHashes[i];
+    }
+
+    if (numMsgVars > 0)
     {
-        NetworkManager::Get()->SendReplicateMsg(msg, numVars, hostId);
-        msgSerializedSize = RepMsgHeaderSize;
+        SendReplicateMsg(msg, payload, numMsgVars, client, reliable);
         replicated = true;
     }
 
@@ -1770,7 +2340,7 @@ bool NetworkManager::ReplicateNode(Node* node, NetId hostId, bool force, bool re
         sMsgReplicateScript.mNodeNetId = node->GetNetId();
 
         std::vector<ScriptNetDatum>& scriptRepData = script->GetReplicatedData();
-        nodeReplicated = ReplicateData<ScriptNetDatum>(scriptRepData, sMsgReplicateScript, hostId, force, reliable);
+        nodeReplicated = ReplicateData<ScriptNetDatum>(scriptRepData, sMsgReplicateScript, hostId, force, reliable) || nodeReplicated;
     }
 
     node->ClearForcedReplication();
@@ -1834,20 +2404,30 @@ int32_t NetworkManager::RecvFrom(char* buffer, uint32_t size, NetHost& outHost)
 
 void NetworkManager::SendTo(const NetHost& host, const char* buffer, uint32_t size)
 {
+    int32_t bytes = 0;
+
     if (mInOnlineSession && mOnlinePlatform)
     {
         mOnlinePlatform->SendMessage(host, buffer, size);
-        mBytesSent += size;
+        bytes = int32_t(size);
     }
     else
     {
-        mBytesSent += NET_SocketSendTo(
+        bytes = NET_SocketSendTo(
             mSocket,
             buffer,
             size,
             host.mIpAddress,
             host.mPort);
     }
+
+    mBytesSent += bytes;
+
+    if (bytes > 0)
+    {
+        mStats.mBytesSent += bytes;
+        mStats.mPacketsSent++;
+    }
 }
 
 void NetworkManager::ProcessIncomingPackets(float deltaTime)
@@ -1975,6 +2555,24 @@ void NetworkManager::ProcessIncomingPackets(float deltaTime)
             {
                 processMsg = true;
                 curSeq = seq + 1;
+
+                // Remember which unreliable packets arrived so they can be acked for delta replication.
+                uint16_t advance = uint16_t(seq - senderProfile->mLatestUnreliableSeq);
+                uint32_t& receivedBits = senderProfile->mUnreliableReceivedBits;
+
+                if (!senderProfile->mReceivedUnreliable || advance > kUnreliableAckWindow)
+                {
+                    receivedBits = 0;
+                }
+                else if (advance > 0)
+                {
+                    receivedBits = (advance == kUnreliableAckWindow) ? 0 : (receivedBits << advance);
+                    receivedBits |= (1u << (advance - 1));
+                }
+
+                senderProfile->mLatestUnreliableSeq = seq;
+                senderProfile->mReceivedUnreliable = true;
+                senderProfile->mUnreliableAckPending = true;
             }
         }
 
@@ -1995,6 +2593,8 @@ void NetworkManager::ProcessIncomingPackets(float deltaTime)
         }
 
         mBytesReceived += bytes;
+        mStats.mBytesReceived += bytes;
+        mStats.mPacketsReceived++;
 
 #if DEBUG_MSG_STATS
         sNumPacketsReceived++;
@@ -2027,6 +2627,7 @@ void NetworkManager::ProcessMessages(NetHost sender, Stream& stream)
             NET_MSG_CASE(InvokeScript)
             //NET_MSG_CASE(Broadcast)
             NET_MSG_CASE(Ack)
+            NET_MSG_CASE(AckUnreliable)
 
         default: break;
         }
@@ -2195,6 +2796,23 @@ void NetworkManager::FlushSendBuffer(NetHostProfile* hostProfile, bool reliable)
                 hostProfile->mOutgoingPackets.emplace_back(outgoingSeq, sSendBuffer, packetSize);
             }
 
+            // Tag the replicated variables in this packet with its seq so acks can update the client baselines.
+            std::vector<NetRepRecord>& pendingRecords = hostProfile->mPendingRepRecords[reliable ? 1 : 0];
+            if (pendingRecords.size() > 0)
+            {
+                std::deque<NetRepPacket>& repPackets = hostProfile->mSentRepPackets[reliable ? 1 : 0];
+                repPackets.emplace_back();
+                repPackets.back().mSeq = outgoingSeq;
+                repPackets.back().mRecords.swap(pendingRecords);
+
+                // Losing track of a packet only means its variables get sent again.
+                if (repPackets.size() > kMaxRepPacketRecords)
+                {
+                    ExpireRepRecords(hostProfile, repPackets.front());
+                    repPackets.pop_front();
+                }
+            }
+
             outgoingSeq++;
         }
         else
@@ -2329,6 +2947,7 @@ void NetworkManager::SetIdRelevantToClient(NetId netId, bool relevant, NetHostId
             else
             {
                 mClients[c].mRelevantNetIds.erase(netId);
+                mClients[c].mBaselines.erase(netId);
             }
         }
     }
@@ -2344,6 +2963,96 @@ void NetworkManager::SetIdRelevantToClient(NetId netId, bool relevant, NetHostId
             else
             {
                 client->mRelevantNetIds.erase(netId);
+                client->mBaselines.erase(netId);
+            }
+        }
+    }
+}
+
+void NetworkManager::UpdateRelevancyGridEntry(Node* node)
+{
+    if (!NetIsServer() ||
+        !node->IsNode3D() ||
+        node->GetNetId() == INVALID_NET_ID)
+    {
+        return;
+    }
+
+    Node3D* node3d = static_cast<Node3D*>(node);
+
+    if (node3d->IsAlwaysRelevant())
+    {
+        mRelevancyGrid.Remove(node3d);
+    }
+    else
+    {
+        mRelevancyGrid.Add(node3d);
+    }
+}
+
+void NetworkManager::MarkRelevancyGridNodeMoved(Node3D* node)
+{
+    mRelevancyGrid.MarkMoved(node);
+}
+
+void NetworkManager::UpdateGridRelevancy()
+{
+    mRelevancyGrid.Update();
+
+    float radius = sqrtf(mRelevancyDistanceSquared);
+
+    for (uint32_t c = 0; c < mClients.size(); ++c)
+    {
+        NetClient* client = &mClients[c];
+        Node* pawn = client->mPawn.Get<Node>();
+
+        // Without a 3D pawn everything is relevant, which the sweep takes care of.
+        if (pawn == nullptr || !pawn->IsNode3D())
+            continue;
+
+        std::unordered_set<NetId>& clientRelIds = client->mRelevantNetIds;
+
+        // Nodes near the pawn may have just crossed the relevancy radius in either direction.
+        sGridNodes.clear();
+        mRelevancyGrid.Query(static_cast<Node3D*>(pawn)->GetWorldPosition(), radius, sGridNodes);
+
+        for (uint32_t i = 0; i < sGridNodes.size(); ++i)
+        {
+            Node3D* node = sGridNodes[i];
+            bool relevant = node->CheckNetRelevance(pawn);
+            bool wasRelevant = (clientRelIds.find(node->GetNetId()) != clientRelIds.end());
+
+            if (relevant && !wasRelevant)
+            {
+                SendSpawnMessage(node, client);
+            }
+            else if (!relevant && wasRelevant)
+            {
+                SendDestroyMessage(node, client);
+            }
+        }
+
+        // Relevant nodes that weren't anywhere near the pawn have left the radius (or teleported away).
+        // Always relevant nodes aren't in the grid, so they never leave.
+        sGridLeavingNodes.clear();
+        for (NetId netId : clientRelIds)
+        {
+            auto it = mNetNodeMap.find(netId);
+            if (it != mNetNodeMap.end() && it->second->IsNode3D())
+            {
+                Node3D* node = static_cast<Node3D*>(it->second);
+                if (mRelevancyGrid.Contains(node) && !mRelevancyGrid.WasInLastQuery(node))
+                {
+                    sGridLeavingNodes.push_back(node);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < sGridLeavingNodes.size(); ++i)
+        {
+            if (!sGridLeavingNodes[i]->CheckNetRelevance(pawn))
+            {
+                SendDestroyMessage(sGridLeavingNodes[i], client);
             }
         }
     }
@@ -3,6 +3,7 @@
 #include "EngineTypes.h"
 #include "NetMsg.h"
 #include "NetFunc.h"
+#include "NetRelevancyGrid.h"
 #include "ScriptFunc.h"
 #include "Nodes/Node.h"
 
@@ -13,6 +14,8 @@
 
 #include <unordered_map>
 
+class BitStream;
+
 // Conflict in WinUser.h
 #ifdef SendMessage
 #undef SendMessage
@@ -68,6 +71,10 @@ public:
     float GetReplicationInterval() const;
     void EnableReliableReplication(bool reliable);
     bool IsReliableReplicationEnabled() const;
+    void EnableTransformQuantization(bool enable);
+    bool IsTransformQuantizationEnabled() const;
+    void SetBandwidthBudget(uint32_t bytesPerSecond);
+    uint32_t GetBandwidthBudget() const;
 
     void Connect(const char* ipAddress, uint16_t port = OCT_DEFAULT_PORT);
     void Connect(uint32_t ipAddress, uint16_t port = OCT_DEFAULT_PORT);
@@ -87,7 +94,6 @@ public:
     int32_t RecvFrom(char* buffer, uint32_t size, NetHost& outHost);
     void SendTo(const NetHost& host, const char* buffer, uint32_t size);
 
-    void SendReplicateMsg(NetMsgReplicate& repMsg, uint32_t& numVars, NetHostId hostId);
     void SendInvokeMsg(NetMsgInvoke& msg, Node* node, NetFunc* func, uint32_t numParams, const Datum** params);
     void SendInvokeMsg(Node* node, NetFunc* func, uint32_t numParams, const Datum** params);
     void SendInvokeScriptMsg(Script* script, ScriptNetFunc* func, uint32_t numParams, const Datum** params);
@@ -109,6 +115,11 @@ public:
     void EnableNetRelevancy(bool enable);
     void SetRelevancyDistance(float dist);
     float GetRelevancyDistanceSquared() const;
+
+    // Always relevant nodes are kept out of the relevancy grid. Call when that flag changes.
+    void UpdateRelevancyGridEntry(Node* node);
+    void MarkRelevancyGridNodeMoved(Node3D* node);
+
     void SetPawn(NetHostId id, Node* pawn);
     Node* GetPawn(NetHostId id);
 
@@ -116,6 +127,8 @@ public:
     int32_t GetBytesReceived() const;
     float GetUploadRate() const;
     float GetDownloadRate() const;
+    const NetStats& GetStats() const;
+    void ResetStats();
 
     bool IsServer() const;
     bool IsClient() const;
@@ -135,6 +148,7 @@ public:
     void HandleDisconnect(NetHost host);
     void HandleKick(NetMsgKick::Reason reason);
     void HandleAck(NetHost host, uint16_t sequenceNumber);
+    void HandleAckUnreliable(NetHost host, uint16_t sequenceNumber, uint32_t receivedBits);
     void HandleReady(NetHost host);
     void HandleBroadcast(
         NetHost host,
@@ -163,7 +177,15 @@ private:
     NetworkManager();
 
     void UpdateReplication(float deltaTime);
+    void UpdatePrioritizedReplication(float deltaTime, Node* incRepNode);
     bool ReplicateNode(Node* node, NetId hostId, bool force, bool reliable);
+    template<typename T>
+    bool ReplicateData(std::vector<T>& repData, NetMsgReplicate& msg, NetHostId hostId, bool force, bool reliable);
+    bool ReplicateDataToClient(NetClient* client, NetMsgReplicate& msg, bool script, bool force, bool reliable);
+    void SendReplicateMsg(NetMsgReplicate& msg, BitStream& payload, uint32_t& numVars, NetClient* client, bool reliable);
+    void ApplyRepRecords(NetHostProfile* profile, const NetRepPacket& packet);
+    void ExpireRepRecords(NetHostProfile* profile, const NetRepPacket& packet);
+    void SendUnreliableAck(NetHostProfile* profile);
     void UpdateHostConnections(float deltaTime);
     void ProcessIncomingPackets(float deltaTime);
     void ProcessMessages(NetHost sender, Stream& stream);
@@ -181,18 +203,23 @@ private:
     bool IsNetIdRelevantToHost(NetId netId, NetHostId host);
     void SetIdRelevantToClient(NetId netId, bool relevant, NetHostId hostId);
     void UpdateNodeRelevancy(Node* testNode);
+    void UpdateGridRelevancy();
 
     NetStatus mNetStatus = NetStatus::Local;
     std::vector<NetClient> mClients;
     std::vector<NetSession> mSessions;
     std::unordered_map<NetId, Node*> mNetNodeMap;
     std::vector<Node*> mNetNodes;
+    NetRelevancyGrid mRelevancyGrid;
+    NetStats mStats;
     NetServer mServer;
     uint32_t mBroadcastIp = 0;
     uint32_t mMaxClients = 15;
     uint32_t mReplicationIndex = 0;
     uint32_t mIncrementalRepIndex = 0;
     uint32_t mRelevancyUpdateIndex = 0;
+    uint32_t mBandwidthBudget = 0;
+    uint32_t mRepBytesQueued = 0;
     NetId mNextNetId = 1;
     float mConnectTimer = 0.0f;
     float mBroadcastTimer = 0.0f;
@@ -217,6 +244,7 @@ private:
     bool mEnableNetRelevancy = false;
     bool mEnableReliableReplication = false;
     bool mEnableIncrementalReplication = true;
+    bool mEnableTransformQuantization = false;
 
     ScriptableFP<NetCallbackConnectFP> mConnectCallback;
     ScriptableFP<NetCallbackAcceptFP> mAcceptCallback;
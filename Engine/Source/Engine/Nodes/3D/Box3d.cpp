@@ -94,6 +94,7 @@ void Box3D::SetExtents(glm::vec3 extents)
     {
         mExtents = extents;
         UpdateRigidBody();
+        MarkBoundsDirty();
     }
 }
 
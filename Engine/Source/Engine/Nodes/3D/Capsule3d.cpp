@@ -128,6 +128,7 @@ void Capsule3D::SetHeight(float height)
     {
         mHeight = height;
         UpdateRigidBody();
+        MarkBoundsDirty();
     }
 }
 
@@ -142,6 +143,7 @@ void Capsule3D::SetRadius(float radius)
     {
         mRadius = radius;
         UpdateRigidBody();
+        MarkBoundsDirty();
     }
 }
 
@@ -210,6 +210,7 @@ void InstancedMesh3D::MarkInstanceDataDirty()
 {
     mInstanceDataDirty = true;
     mInstancedMeshResource.mDirty = true;
+    MarkBoundsDirty();
 }
 
 void InstancedMesh3D::UpdateInstanceData()
@@ -9,6 +9,8 @@
 #include "Assets/SkeletalMesh.h"
 
 #include "Nodes/3D/SkeletalMesh3d.h"
+#include "Nodes/3D/Primitive3d.h"
+#include "Nodes/3D/PointLight3d.h"
 
 FORCE_LINK_DEF(Node3D);
 DEFINE_NODE(Node3D, Node);
@@ -139,8 +141,11 @@ void Node3D::GatherReplicatedData(std::vector<NetDatum>& outData)
     if (mReplicateTransform)
     {
         outData.push_back(NetDatum(DatumType::Vector, this, &mPosition, 1, OnRep_RootPosition));
+        outData.back().SetQuantization(NetQuantize::Position);
         outData.push_back(NetDatum(DatumType::Vector, this, &mRotationEuler, 1, OnRep_RootRotation));
+        outData.back().SetQuantization(NetQuantize::Rotation);
         outData.push_back(NetDatum(DatumType::Vector, this, &mScale, 1, OnRep_RootScale));
+        outData.back().SetQuantization(NetQuantize::Scale);
     }
 }
 
@@ -172,10 +177,35 @@ void Node3D::AttachToBone(SkeletalMesh3D* parent, int32_t boneIndex, bool keepWo
     }
 }
 
+// Every change to a node's world transform goes through here (or SetTransform()),
+// so the world's bounds trees never hold stale bounds for a moved primitive or light.
+static void MarkWorldBoundsDirty(World* world, Node3D* node)
+{
+    if (node->IsPrimitive3D())
+    {
+        world->MarkPrimitiveBoundsDirty(static_cast<Primitive3D*>(node));
+    }
+    else if (node->IsLight3D() && static_cast<Light3D*>(node)->IsPointLight3D())
+    {
+        world->MarkLightBoundsDirty(static_cast<PointLight3D*>(node));
+    }
+}
+
 void Node3D::MarkTransformDirty()
 {
     mTransformDirty = true;
 
+    if (mWorld != nullptr)
+    {
+        mWorld->QueueTransformUpdate(this);
+        MarkWorldBoundsDirty(mWorld, this);
+    }
+
+    if (mInRelevancyGrid)
+    {
+        NetworkManager::Get()->MarkRelevancyGridNodeMoved(this);
+    }
+
     // TODO-NODE: Consider propogating this to children nodes. 
     // It looks like Godot does it this way, and might remove some one-frame-delay bugs.
 #if 0
@@ -194,6 +224,36 @@ bool Node3D::IsTransformDirty() const
     return mTransformDirty;
 }
 
+bool Node3D::IsTransformQueued() const
+{
+    return mTransformQueued;
+}
+
+void Node3D::SetTransformQueued(bool queued)
+{
+    mTransformQueued = queued;
+}
+
+uint32_t Node3D::GetTransformQueueIndex() const
+{
+    return mTransformQueueIndex;
+}
+
+void Node3D::SetTransformQueueIndex(uint32_t index)
+{
+    mTransformQueueIndex = index;
+}
+
+bool Node3D::IsInRelevancyGrid() const
+{
+    return mInRelevancyGrid;
+}
+
+void Node3D::SetInRelevancyGrid(bool inGrid)
+{
+    mInRelevancyGrid = inGrid;
+}
+
 void Node3D::UpdateTransform(bool updateChildren)
 {
     // First we need to update parent transform if it's dirty.
@@ -207,6 +267,10 @@ void Node3D::UpdateTransform(bool updateChildren)
 
     if (mTransformDirty)
     {
+        // Resolving a world transform marks children dirty and syncs physics, which isn't
+        // safe from a parallel tick. Those nodes queue the update and the main thread resolves it.
+        OCT_ASSERT(!World::IsParallelTickThread());
+
         // Update transform
         mTransform = glm::mat4(1);
 
@@ -294,6 +358,23 @@ bool Node3D::CheckNetRelevance(Node* playerNode)
     }
 }
 
+float Node3D::GetNetPriorityScale(Node* playerNode)
+{
+    Node3D* player3D = playerNode->As<Node3D>();
+
+    if (player3D == nullptr || this == playerNode)
+    {
+        return 1.0f;
+    }
+
+    // Fall off linearly out to the relevancy distance, but never stop replicating entirely.
+    float dist2 = glm::distance2(GetWorldPosition(), player3D->GetWorldPosition());
+    float netRelDist2 = NetworkManager::Get()->GetRelevancyDistanceSquared();
+    float ratio = (netRelDist2 > 0.0f) ? sqrtf(dist2 / netRelDist2) : 0.0f;
+
+    return glm::clamp(1.0f - ratio, 0.1f, 1.0f);
+}
+
 void Node3D::GatherProxyDraws(std::vector<DebugDraw>& inoutDraws)
 {
 #if DEBUG_DRAW_ENABLED
@@ -399,6 +480,8 @@ void Node3D::SetScale(glm::vec3 scale)
 
 void Node3D::SetTransform(const glm::mat4& transform)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     mTransform = transform;
 
     // Update the relative transforms to match the new world transform.
@@ -409,6 +492,13 @@ void Node3D::SetTransform(const glm::mat4& transform)
 
     mTransformDirty = false;
 
+    // The transform was written directly (e.g. synced from physics), so the
+    // bounds have to be refreshed even though nothing is left dirty.
+    if (mWorld != nullptr)
+    {
+        MarkWorldBoundsDirty(mWorld, this);
+    }
+
     for (uint32_t i = 0; i < mChildren.size(); ++i)
     {
         Node3D* child3d = mChildren[i]->IsNode3D() ? static_cast<Node3D*>(mChildren[i].Get()) : nullptr;
@@ -33,9 +33,16 @@ public:
 
     void MarkTransformDirty();
     bool IsTransformDirty() const;
+    bool IsTransformQueued() const;
+    void SetTransformQueued(bool queued);
+    uint32_t GetTransformQueueIndex() const;
+    void SetTransformQueueIndex(uint32_t index);
+    bool IsInRelevancyGrid() const;
+    void SetInRelevancyGrid(bool inGrid);
     virtual void UpdateTransform(bool updateChildren);
 
     virtual bool CheckNetRelevance(Node* playerNode) override;
+    virtual float GetNetPriorityScale(Node* playerNode) override;
 
     virtual void GatherProxyDraws(std::vector<DebugDraw>& inoutDraws);
 
@@ -109,4 +116,7 @@ protected:
     bool mInheritTransform = true;
 
     bool mTransformDirty;
+    bool mTransformQueued = false;
+    uint32_t mTransformQueueIndex = 0;
+    bool mInRelevancyGrid = false;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Utilities.h"
 #include "Maths.h"
 #include "Profiler.h"
+#include "JobSystem.h"
 #include "Assets/ParticleSystemInstance.h"
 
 #include "Graphics/Graphics.h"
@@ -48,6 +49,10 @@ bool Particle3D::HandlePropChange(Datum* datum, uint32_t index, const void* newV
 Particle3D::Particle3D()
 {
     mName = "Particle";
+
+    // Maths::SeedRand() restarts the stream seeds, so emitters stay repeatable without
+    // pulling values out of the rand() sequence. Xorshift needs a nonzero state.
+    mRandState = Maths::NewStreamSeed() | 1u;
 }
 
 Particle3D::~Particle3D()
@@ -137,8 +142,8 @@ void Particle3D::Destroy()
 
     GFX_DestroyParticleCompResource(this);
 
-    mParticles.clear();
-    mParticles.shrink_to_fit();
+    mParticles.Clear();
+    mParticles.ShrinkToFit();
 
     Primitive3D::Destroy();
 }
@@ -193,6 +198,7 @@ void Particle3D::TickCommon(float deltaTime)
 {
     mHasSimulatedThisFrame = false;
     mHasUpdatedVerticesThisFrame = false;
+    mInView = false;
 
     if (mAutoDestroy)
     {
@@ -232,7 +238,7 @@ void Particle3D::Simulate(float deltaTime)
 
 void Particle3D::Reset()
 {
-    mParticles.clear();
+    mParticles.Clear();
     mElapsedTime = 0.0f;
     mLoop = 0;
 }
@@ -359,7 +365,7 @@ bool Particle3D::IsSimulationEnabled() const
 
 uint32_t Particle3D::GetNumParticles()
 {
-    return (uint32_t)mParticles.size();
+    return mParticles.GetCount();
 }
 
 uint32_t Particle3D::GetNumVertices()
@@ -367,7 +373,7 @@ uint32_t Particle3D::GetNumVertices()
     return (uint32_t)mVertices.size();
 }
 
-std::vector<Particle>& Particle3D::GetParticles()
+ParticleArrays& Particle3D::GetParticles()
 {
     return mParticles;
 }
@@ -381,23 +387,23 @@ void Particle3D::SetParticleVelocity(int32_t index, glm::vec3 velocity)
 {
     if (index == -1)
     {
-        for (uint32_t i = 0; i < mParticles.size(); ++i)
+        for (uint32_t i = 0; i < mParticles.GetCount(); ++i)
         {
-            mParticles[i].mVelocity = velocity;
+            mParticles.mVelocities[i] = velocity;
         }
     }
-    else if (index >= 0 && index < (int32_t)mParticles.size())
+    else if (index >= 0 && index < (int32_t)mParticles.GetCount())
     {
-        mParticles[index].mVelocity = velocity;
+        mParticles.mVelocities[index] = velocity;
     }
 }
 
 glm::vec3 Particle3D::GetParticleVelocity(int32_t index)
 {
     glm::vec3 ret = { 0.0f, 0.0f, 0.0f };
-    if (index >= 0 && index < (int32_t)mParticles.size())
+    if (index >= 0 && index < (int32_t)mParticles.GetCount())
     {
-        ret = mParticles[index].mVelocity;
+        ret = mParticles.mVelocities[index];
     }
     return ret;
 }
@@ -407,23 +413,23 @@ void Particle3D::SetParticlePosition(int32_t index, glm::vec3 position)
 {
     if (index == -1)
     {
-        for (uint32_t i = 0; i < mParticles.size(); ++i)
+        for (uint32_t i = 0; i < mParticles.GetCount(); ++i)
         {
-            mParticles[i].mPosition = position;
+            mParticles.mPositions[i] = position;
         }
     }
-    else if (index >= 0 && index < int32_t(mParticles.size()))
+    else if (index >= 0 && index < int32_t(mParticles.GetCount()))
     {
-        mParticles[index].mPosition = position;
+        mParticles.mPositions[index] = position;
     }
 }
 
 glm::vec3 Particle3D::GetParticlePosition(int32_t index)
 {
     glm::vec3 ret = { 0.0f, 0.0f, 0.0f };
-    if (index >= 0 && index < int32_t(mParticles.size()))
+    if (index >= 0 && index < int32_t(mParticles.GetCount()))
     {
-        ret = mParticles[index].mPosition;
+        ret = mParticles.mPositions[index];
     }
     return ret;
 }
@@ -432,14 +438,14 @@ void Particle3D::SetParticleSpeed(int32_t index, float speed)
 {
     if (index == -1)
     {
-        for (uint32_t i = 0; i < mParticles.size(); ++i)
+        for (uint32_t i = 0; i < mParticles.GetCount(); ++i)
         {
-            mParticles[i].mVelocity = Maths::SafeNormalize(mParticles[i].mVelocity) * speed;
+            mParticles.mVelocities[i] = Maths::SafeNormalize(mParticles.mVelocities[i]) * speed;
         }
     }
-    else if (index >= 0 && index < int32_t(mParticles.size()))
+    else if (index >= 0 && index < int32_t(mParticles.GetCount()))
     {
-        mParticles[index].mVelocity = Maths::SafeNormalize(mParticles[index].mVelocity) * speed;
+        mParticles.mVelocities[index] = Maths::SafeNormalize(mParticles.mVelocities[index]) * speed;
     }
 }
 
@@ -475,14 +481,12 @@ Bounds Particle3D::GetLocalBounds() const
 
 void Particle3D::KillExpiredParticles(float deltaTime)
 {
-    for (int32_t i = int32_t(mParticles.size()) - 1; i >= 0; --i)
+    // Iterating backwards means the particle swapped into a removed slot has already been checked.
+    for (int32_t i = int32_t(mParticles.GetCount()) - 1; i >= 0; --i)
     {
-        Particle& particle = mParticles[i];
-
-        if (particle.mElapsedTime >= particle.mLifetime)
+        if (mParticles.mElapsedTimes[i] >= mParticles.mLifetimes[i])
         {
-            // Might be more efficient if we swap instead of erase?
-            mParticles.erase(mParticles.begin() + i);
+            mParticles.Remove(uint32_t(i));
         }
     }
 }
@@ -493,15 +497,7 @@ void Particle3D::UpdateParticles(float deltaTime)
 
     if (system != nullptr)
     {
-        ParticleParams& params = system->GetParams();
-
-        for (uint32_t i = 0; i < mParticles.size(); ++i)
-        {
-            mParticles[i].mElapsedTime += deltaTime;
-            mParticles[i].mVelocity += (params.mAcceleration * deltaTime);
-            mParticles[i].mPosition += (mParticles[i].mVelocity * deltaTime);
-            mParticles[i].mRotation += (mParticles[i].mRotationSpeed * deltaTime);
-        }
+        IntegrateParticles(mParticles, system->GetParams().mAcceleration, deltaTime);
     }
 }
 
@@ -555,25 +551,30 @@ void Particle3D::SpawnNewParticles(float deltaTime)
 
         if (maxParticles > 0)
         {
-            int32_t numParticles = (int32_t)mParticles.size();
+            int32_t numParticles = (int32_t)mParticles.GetCount();
             spawnCount = glm::min(maxParticles - numParticles, spawnCount);
         }
 
+        if (spawnCount > 0)
+        {
+            mParticles.Reserve(mParticles.GetCount() + uint32_t(spawnCount));
+        }
+
         for (int32_t i = 0; i < spawnCount; ++i)
         {
             Particle newParticle;
 
-            newParticle.mLifetime = Maths::RandRange(params.mLifetimeMin, params.mLifetimeMax);
+            newParticle.mLifetime = RandRange(params.mLifetimeMin, params.mLifetimeMax);
             if (system->IsRadialSpawn())
             {
                 // Doing the powf(x,1/3) seems to be important for getting a uniform distribution in sphere.
-                float distUnit = Maths::RandRange(params.mPositionMin.x, params.mPositionMax.x);
+                float distUnit = RandRange(params.mPositionMin.x, params.mPositionMax.x);
                 distUnit = Maths::Map(distUnit, params.mPositionMin.x, params.mPositionMax.x, 0.0f, 1.0f);
                 distUnit = powf(distUnit, 1 / 3.0f);
                 distUnit = Maths::Map(distUnit, 0.0f, 1.0f, params.mPositionMin.x, params.mPositionMax.x);
 
-                float yaw = Maths::RandRange(0.0f, PI * 2.0f);
-                float pitch = Maths::RandRange(-PI/2.0f, PI/2.0f);
+                float yaw = RandRange(0.0f, PI * 2.0f);
+                float pitch = RandRange(-PI/2.0f, PI/2.0f);
                 glm::vec3 newPos = glm::vec3(0.0f, 0.0f, distUnit);
                 newPos = glm::rotate(newPos, pitch, glm::vec3(1.0f, 0.0f, 0.0f));
                 newPos = glm::rotate(newPos, yaw, glm::vec3(0.0f, 1.0f, 0.0f));
@@ -581,17 +582,17 @@ void Particle3D::SpawnNewParticles(float deltaTime)
             }
             else
             {
-                newParticle.mPosition = Maths::RandRange(params.mPositionMin, params.mPositionMax);
+                newParticle.mPosition = RandRange(params.mPositionMin, params.mPositionMax);
             }
-            newParticle.mVelocity = Maths::RandRange(params.mVelocityMin, params.mVelocityMax);
-            newParticle.mSize = Maths::RandRange(params.mSizeMin, params.mSizeMax);
-            newParticle.mRotation = Maths::RandRange(params.mRotationMin, params.mRotationMax);
-            newParticle.mRotationSpeed = Maths::RandRange(params.mRotationSpeedMin, params.mRotationSpeedMax);
+            newParticle.mVelocity = RandRange(params.mVelocityMin, params.mVelocityMax);
+            newParticle.mSize = RandRange(params.mSizeMin, params.mSizeMax);
+            newParticle.mRotation = RandRange(params.mRotationMin, params.mRotationMax);
+            newParticle.mRotationSpeed = RandRange(params.mRotationSpeedMin, params.mRotationSpeedMax);
 
             if (system->IsRatioLocked())
             {
                 float ratioYX = params.mSizeMax.x != 0.0f ? (params.mSizeMax.y / params.mSizeMax.x) : 1.0f;
-                newParticle.mSize.x = Maths::RandRange(params.mSizeMin.x, params.mSizeMax.x);
+                newParticle.mSize.x = RandRange(params.mSizeMin.x, params.mSizeMax.x);
                 newParticle.mSize.y = ratioYX * newParticle.mSize.x;
             }
 
@@ -610,31 +611,61 @@ void Particle3D::SpawnNewParticles(float deltaTime)
                 newParticle.mVelocity = mTransform * glm::vec4(newParticle.mVelocity, 0.0f);
             }
 
-            mParticles.push_back(newParticle);
+            mParticles.Add(newParticle);
         }
     }
 }
 
+uint32_t Particle3D::NextRand()
+{
+    uint32_t x = mRandState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mRandState = x;
+    return x;
+}
+
+float Particle3D::RandRange(float min, float max)
+{
+    // Top 24 bits map exactly onto a float in [0, 1].
+    float randFloat = float(NextRand() >> 8) / 16777215.0f;
+    return min + (max - min) * randFloat;
+}
+
+glm::vec2 Particle3D::RandRange(glm::vec2 min, glm::vec2 max)
+{
+    glm::vec2 retRand;
+    retRand.x = RandRange(min.x, max.x);
+    retRand.y = RandRange(min.y, max.y);
+    return retRand;
+}
+
+glm::vec3 Particle3D::RandRange(glm::vec3 min, glm::vec3 max)
+{
+    glm::vec3 retRand;
+    retRand.x = RandRange(min.x, max.x);
+    retRand.y = RandRange(min.y, max.y);
+    retRand.z = RandRange(min.z, max.z);
+    return retRand;
+}
+
 void Particle3D::UpdateVertexBuffer()
+{
+    UpdateVertices();
+    UploadVertices();
+}
+
+void Particle3D::UpdateVertices()
 {
     ParticleSystem* system = mParticleSystem.Get<ParticleSystem>();
 
     if (system == nullptr || mHasUpdatedVerticesThisFrame)
         return;
 
-    uint32_t numParticles = (uint32_t)mParticles.size();
+    uint32_t numParticles = mParticles.GetCount();
     mVertices.resize(numParticles * 4);
 
-    const ParticleParams& params = system->GetParams();
-
-    const float alphaEase = params.mAlphaEase;
-    const float scaleEase = params.mScaleEase;
-
-    const float invAlphaEase2 = (alphaEase != 0.0f) ? (0.5f / alphaEase) : 1.0f;
-    const float invScaleEase2 = (scaleEase != 0.0f) ? (0.5f / scaleEase) : 1.0f;
-
-    const float invColorScale = Renderer::Get()->GetColorScaleInverse();
-
     glm::vec3 right = { 1.0f, 0.0f, 0.0f };
     glm::vec3 up = { 0.0f, 1.0f, 0.0f };
     glm::vec3 forward = { 0.0f, 0.0f, -1.0f };
@@ -690,77 +721,143 @@ void Particle3D::UpdateVertexBuffer()
         break;
     }
 
-    for (uint32_t i = 0; i < numParticles; ++i)
+    ParticleVertexParams vertParams;
+    vertParams.mParams = &system->GetParams();
+    vertParams.mInvColorScale = Renderer::Get()->GetColorScaleInverse();
+    vertParams.mRight = right;
+    vertParams.mUp = up;
+
+    // Rotating an axis around the perpendicular forward vector by r gives axis * cos(r) + (forward x axis) * sin(r).
+    vertParams.mRightPerp = glm::cross(forward, right);
+    vertParams.mUpPerp = glm::cross(forward, up);
+
+    if (mUseLocalSpace && mOrientation == ParticleOrientation::Billboard)
+    {
+        vertParams.mRight = glm::vec4(vertParams.mRight, 0.0f) * mTransform;
+        vertParams.mUp = glm::vec4(vertParams.mUp, 0.0f) * mTransform;
+        vertParams.mRightPerp = glm::vec4(vertParams.mRightPerp, 0.0f) * mTransform;
+        vertParams.mUpPerp = glm::vec4(vertParams.mUpPerp, 0.0f) * mTransform;
+    }
+
+    if (numParticles > 0)
+    {
+        BuildParticleVertices(mParticles, vertParams, 0, numParticles, mVertices.data());
+    }
+
+    mHasUpdatedVerticesThisFrame = true;
+    mVerticesPendingUpload = true;
+}
+
+void Particle3D::UploadVertices()
+{
+    if (mVerticesPendingUpload)
     {
-        VertexParticle* verts = &mVertices[i * 4];
+        GFX_UpdateParticleCompVertexBuffer(this, mVertices);
+        mVerticesPendingUpload = false;
+    }
+}
+
+void Particle3D::SetInView(bool inView)
+{
+    mInView = inView;
+}
 
-        float life = mParticles[i].mElapsedTime / mParticles[i].mLifetime;
+bool Particle3D::IsInView() const
+{
+    return mInView;
+}
 
-        glm::vec2 scale = glm::mix(params.mScaleStart, params.mScaleEnd, life);
-        glm::vec4 color = glm::mix(params.mColorStart, params.mColorEnd, life);
+struct ParticleUpdateBatch
+{
+    Particle3D* const* mParticles = nullptr;
+    uint32_t mNumParticles = 0;
+    float mDeltaTime = 0.0f;
+};
 
-        float easeX = 2 * fabs(life - 0.5f);
+static void UpdateParticleBatch(Particle3D* const* particles, uint32_t numParticles, float deltaTime)
+{
+    for (uint32_t i = 0; i < numParticles; ++i)
+    {
+        Particle3D* particle = particles[i];
 
-        if (scaleEase > 0.0f)
+        if (particle->IsInView())
+        {
+            particle->Simulate(deltaTime);
+            particle->UpdateVertices();
+        }
+        else if (particle->ShouldAlwaysSimulate())
         {
-            float scalePower = glm::clamp(invScaleEase2 * (1.0f - easeX), 0.0f, 1.0f);
-            scale = glm::mix(glm::vec2(0.0f, 0.0f), scale, scalePower);
+            particle->Simulate(deltaTime);
         }
+    }
+}
+
+static void UpdateParticleBatchJob(void* arg)
+{
+    SCOPED_FRAME_STAT("ParticleUpdate");
+    ParticleUpdateBatch* batch = (ParticleUpdateBatch*)arg;
+    UpdateParticleBatch(batch->mParticles, batch->mNumParticles, batch->mDeltaTime);
+}
 
-        if (alphaEase > 0.0f)
+void Particle3D::UpdateEmitters(const std::vector<Particle3D*>& particles, float deltaTime)
+{
+    static std::vector<ParticleUpdateBatch> sBatches;
+    static std::vector<Job> sJobs;
+
+    JobSystem* jobSystem = JobSystem::Get();
+    uint32_t numEmitters = uint32_t(particles.size());
+    uint32_t numWorkers = (jobSystem != nullptr) ? jobSystem->GetNumWorkers() : 0;
+
+    if (numWorkers > 0 && numEmitters > 1)
+    {
+        // Emitters vary wildly in particle count, so batches are split by particle count
+        // (plus one per emitter for its fixed cost) rather than by number of emitters.
+        uint64_t totalCost = 0;
+        for (uint32_t i = 0; i < numEmitters; ++i)
         {
-            float alphaPower = glm::clamp(invAlphaEase2 * (1.0f - easeX), 0.0f, 1.0f);
-            color.a = glm::mix(0.0f, color.a, alphaPower);
+            totalCost += particles[i]->GetNumParticles() + 1;
         }
 
-        glm::vec3 pos = mParticles[i].mPosition;
-        glm::vec2 halfSize = mParticles[i].mSize * scale * 0.5f;
-        color *= invColorScale;
-        uint8_t colors[4] =
+        uint64_t batchCost = totalCost / ((numWorkers + 1) * 4);
+        batchCost = glm::max<uint64_t>(batchCost, 1);
+
+        sBatches.clear();
+        uint64_t cost = 0;
+
+        for (uint32_t i = 0; i < numEmitters; ++i)
         {
-            uint8_t(glm::clamp(color.r * 255.0f, 0.0f, 255.0f)),
-            uint8_t(glm::clamp(color.g * 255.0f, 0.0f, 255.0f)),
-            uint8_t(glm::clamp(color.b * 255.0f, 0.0f, 255.0f)),
-            uint8_t(glm::clamp(color.a * 255.0f, 0.0f, 255.0f))
-        };
-        uint32_t color32 = 
-            (colors[0]) |
-            (colors[1] << 8) |
-            (colors[2] << 16) |
-            (colors[3] << 24);
-
-        glm::vec3 rightAxis = glm::rotate(right, mParticles[i].mRotation, forward);
-        glm::vec3 upAxis = glm::rotate(up, mParticles[i].mRotation, forward);
-
-        if (mUseLocalSpace && mOrientation == ParticleOrientation::Billboard)
+            if (sBatches.size() == 0 || cost >= batchCost)
+            {
+                ParticleUpdateBatch batch;
+                batch.mParticles = particles.data() + i;
+                batch.mDeltaTime = deltaTime;
+                sBatches.push_back(batch);
+                cost = 0;
+            }
+
+            sBatches.back().mNumParticles++;
+            cost += particles[i]->GetNumParticles() + 1;
+        }
+
+        uint32_t numBatches = uint32_t(sBatches.size());
+        sJobs.resize(numBatches);
+
+        for (uint32_t i = 0; i < numBatches; ++i)
         {
-            rightAxis = glm::vec4(rightAxis, 0.0f) * mTransform;
-            upAxis = glm::vec4(upAxis, 0.0f) * mTransform;
+            sJobs[i].mFunc = UpdateParticleBatchJob;
+            sJobs[i].mArg = &sBatches[i];
         }
 
-        //   0----2
-        //   |  / |
-        //   | /  |
-        //   1----3
-        verts[0].mPosition = pos - (rightAxis * halfSize.x) + (upAxis * halfSize.y);
-        verts[0].mTexcoord = glm::vec2(0.0f, 0.0f);
-        verts[0].mColor = color32;
-
-        verts[1].mPosition = pos - (rightAxis * halfSize.x) - (upAxis * halfSize.y);
-        verts[1].mTexcoord = glm::vec2(0.0f, 1.0f);
-        verts[1].mColor = color32;
-
-        verts[2].mPosition = pos + (rightAxis * halfSize.x) + (upAxis * halfSize.y);
-        verts[2].mTexcoord = glm::vec2(1.0f, 0.0f);
-        verts[2].mColor = color32;
-
-        verts[3].mPosition = pos + (rightAxis * halfSize.x) - (upAxis * halfSize.y);
-        verts[3].mTexcoord = glm::vec2(1.0f, 1.0f);
-        verts[3].mColor = color32;
+        jobSystem->RunJobs(sJobs.data(), numBatches);
+    }
+    else
+    {
+        UpdateParticleBatch(particles.data(), numEmitters, deltaTime);
     }
 
-    GFX_UpdateParticleCompVertexBuffer(this, mVertices);
-
-    mHasUpdatedVerticesThisFrame = true;
+    for (uint32_t i = 0; i < numEmitters; ++i)
+    {
+        particles[i]->UploadVertices();
+    }
 }
 
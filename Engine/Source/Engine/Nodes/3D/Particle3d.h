@@ -3,6 +3,7 @@
 #include "Nodes/3D/Primitive3d.h"
 #include "Assets/ParticleSystem.h"
 #include "Assets/ParticleSystemInstance.h"
+#include "ParticleSimulation.h"
 
 enum class ParticleOrientation : uint8_t
 {
@@ -17,19 +18,6 @@ enum class ParticleOrientation : uint8_t
     Count
 };
 
-struct Particle
-{
-    glm::vec3 mPosition = {};
-    float mElapsedTime = 0.0f;
-
-    glm::vec3 mVelocity = {};
-    float mLifetime = 1.0f;
-
-    glm::vec2 mSize = {};
-    float mRotationSpeed = 0.0f;
-    float mRotation = 0.0f;
-};
-
 class Particle3D : public Primitive3D
 {
 public:
@@ -58,6 +46,20 @@ public:
     void Simulate(float deltaTime);
     void UpdateVertexBuffer();
 
+    // UpdateVertexBuffer() split in two. UpdateVertices() only touches this emitter's own
+    // data so it can run on a worker thread, while UploadVertices() calls into the graphics
+    // layer and must run on the main thread.
+    void UpdateVertices();
+    void UploadVertices();
+
+    // Set by the renderer when this emitter is gathered for drawing and survives culling.
+    void SetInView(bool inView);
+    bool IsInView() const;
+
+    // Simulates every emitter in the list across the job system. Emitters in view also
+    // rebuild their vertices, others only simulate if ShouldAlwaysSimulate() is set.
+    static void UpdateEmitters(const std::vector<Particle3D*>& particles, float deltaTime);
+
     void Reset();
     void EnableEmission(bool enable);
     bool IsEmissionEnabled() const;
@@ -91,7 +93,7 @@ public:
 
     uint32_t GetNumParticles();
     uint32_t GetNumVertices();
-    std::vector<Particle>& GetParticles();
+    ParticleArrays& GetParticles();
     const std::vector<VertexParticle>& GetVertices();
 
     void SetParticleVelocity(int32_t index, glm::vec3 velocity);
@@ -119,16 +121,26 @@ protected:
     void UpdateParticles(float deltaTime);
     void SpawnNewParticles(float deltaTime);
 
+    // Per-emitter xorshift generator. Emitters are simulated on worker threads, where the
+    // shared rand() state is neither thread safe nor deterministic.
+    uint32_t NextRand();
+    float RandRange(float min, float max);
+    glm::vec2 RandRange(glm::vec2 min, glm::vec2 max);
+    glm::vec3 RandRange(glm::vec3 min, glm::vec3 max);
+
     float mElapsedTime = 0.0f;
     bool mEmit = true;
     bool mAutoEmit = true;
     bool mAutoDestroy = false;
-    std::vector<Particle> mParticles;
+    ParticleArrays mParticles;
     std::vector<VertexParticle> mVertices;
     float mEmissionCounter = 0.0f;
     uint32_t mLoop = 0;
+    uint32_t mRandState = 1;
     bool mHasSimulatedThisFrame = false;
     bool mHasUpdatedVerticesThisFrame = false;
+    bool mVerticesPendingUpload = false;
+    bool mInView = false;
 
     // Properties
     ParticleSystemRef mParticleSystem;
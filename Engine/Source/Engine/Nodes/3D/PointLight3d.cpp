@@ -5,6 +5,7 @@
 #include "Engine.h"
 #include "AssetManager.h"
 #include "Maths.h"
+#include "World.h"
 
 #if EDITOR
 #include "EditorState.h"
@@ -16,6 +17,22 @@
 FORCE_LINK_DEF(PointLight3D);
 DEFINE_NODE(PointLight3D, Light3D);
 
+bool PointLight3D::HandlePropChange(Datum* datum, uint32_t index, const void* newValue)
+{
+    Property* prop = static_cast<Property*>(datum);
+    OCT_ASSERT(prop != nullptr);
+    PointLight3D* pointLight = static_cast<PointLight3D*>(prop->mOwner);
+    bool success = false;
+
+    if (prop->mName == "Radius")
+    {
+        pointLight->SetRadius(*(float*)newValue);
+        success = true;
+    }
+
+    return success;
+}
+
 PointLight3D::PointLight3D() :
     mRadius(5)
 {
@@ -47,7 +64,7 @@ void PointLight3D::GatherProperties(std::vector<Property>& outProps)
 
     SCOPED_CATEGORY("Light");
 
-    outProps.push_back(Property(DatumType::Float, "Radius", this, &mRadius));
+    outProps.push_back(Property(DatumType::Float, "Radius", this, &mRadius, 1, HandlePropChange));
 }
 
 void PointLight3D::GatherProxyDraws(std::vector<DebugDraw>& inoutDraws)
@@ -89,6 +106,16 @@ void PointLight3D::GatherProxyDraws(std::vector<DebugDraw>& inoutDraws)
 #endif // DEBUG_DRAW_ENABLED
 }
 
+bool PointLight3D::IsLightBoundsDirty() const
+{
+    return mLightBoundsDirty;
+}
+
+void PointLight3D::SetLightBoundsDirty(bool dirty)
+{
+    mLightBoundsDirty = dirty;
+}
+
 bool PointLight3D::IsPointLight3D() const
 {
     return true;
@@ -102,6 +129,11 @@ bool PointLight3D::IsDirectionalLight3D() const
 void PointLight3D::SetRadius(float radius)
 {
     mRadius = radius;
+
+    if (mWorld != nullptr)
+    {
+        mWorld->MarkLightBoundsDirty(this);
+    }
 }
 
 float PointLight3D::GetRadius() const
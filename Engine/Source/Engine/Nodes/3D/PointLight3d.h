@@ -44,7 +44,13 @@ public:
     void SetRadius(float radius);
     float GetRadius() const;
 
+    bool IsLightBoundsDirty() const;
+    void SetLightBoundsDirty(bool dirty);
+
 protected:
 
+    static bool HandlePropChange(Datum* datum, uint32_t index, const void* newValue);
+
     float mRadius;
+    bool mLightBoundsDirty = false;
 };
\ No newline at end of file
@@ -160,6 +160,15 @@ bool Primitive3D::IsPrimitive3D() const
     return true;
 }
 
+bool Primitive3D::CanTickInParallel() const
+{
+    // Moving a primitive with a rigid body re-adds it to the dynamics world,
+    // and simulated primitives copy their physics transform back in Tick().
+    return Node3D::CanTickInParallel() &&
+        !mPhysicsEnabled &&
+        !IsRigidBodyInWorld();
+}
+
 void Primitive3D::Tick(float deltaTime)
 {
     Node3D::Tick(deltaTime);
@@ -504,6 +513,8 @@ glm::vec3 Primitive3D::GetAngularVelocity() const
 
 void Primitive3D::AddLinearVelocity(glm::vec3 deltaVelocity)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 delta = { deltaVelocity.x, deltaVelocity.y, deltaVelocity.z };
@@ -514,6 +525,8 @@ void Primitive3D::AddLinearVelocity(glm::vec3 deltaVelocity)
 
 void Primitive3D::AddAngularVelocity(glm::vec3 deltaVelocity)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 delta = { deltaVelocity.x, deltaVelocity.y, deltaVelocity.z };
@@ -524,6 +537,8 @@ void Primitive3D::AddAngularVelocity(glm::vec3 deltaVelocity)
 
 void Primitive3D::SetLinearVelocity(glm::vec3 linearVelocity)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 velocity = { linearVelocity.x, linearVelocity.y, linearVelocity.z };
@@ -534,6 +549,8 @@ void Primitive3D::SetLinearVelocity(glm::vec3 linearVelocity)
 
 void Primitive3D::SetAngularVelocity(glm::vec3 angularVelocity)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 velocity = { angularVelocity.x, angularVelocity.y, angularVelocity.z };
@@ -544,6 +561,8 @@ void Primitive3D::SetAngularVelocity(glm::vec3 angularVelocity)
 
 void Primitive3D::AddForce(glm::vec3 force)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 forceBt = { force.x, force.y, force.z };
@@ -554,6 +573,8 @@ void Primitive3D::AddForce(glm::vec3 force)
 
 void Primitive3D::AddImpulse(glm::vec3 impulse)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         btVector3 impulseBt = { impulse.x, impulse.y, impulse.z };
@@ -564,6 +585,8 @@ void Primitive3D::AddImpulse(glm::vec3 impulse)
 
 void Primitive3D::ClearForces()
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (mRigidBody)
     {
         mRigidBody->clearForces();
@@ -583,6 +606,8 @@ void Primitive3D::FullSyncRigidBodyTransform()
 
 void Primitive3D::SyncRigidBodyTransform()
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (GetWorld() != nullptr)
     {
         if (mRigidBody != nullptr)
@@ -628,6 +653,8 @@ void Primitive3D::SyncRigidBodyTransform()
 
 void Primitive3D::SyncRigidBodyMass()
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (!mRigidBody)
         return;
 
@@ -646,6 +673,8 @@ void Primitive3D::SyncRigidBodyMass()
 
 void Primitive3D::SyncCollisionFlags()
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     if (!mRigidBody)
         return;
 
@@ -751,6 +780,9 @@ void Primitive3D::SetCollisionShape(btCollisionShape* newShape)
     }
 
     EnableRigidBody(true);
+
+    // Local bounds of most primitives follow their collision shape.
+    MarkBoundsDirty();
 }
 
 bool Primitive3D::SweepToWorldPosition(glm::vec3 position, SweepTestResult& outSweepResult, uint8_t mask, bool testOnly)
@@ -833,6 +865,34 @@ Bounds Primitive3D::GetLocalBounds() const
     return retBounds;
 }
 
+void Primitive3D::MarkBoundsDirty()
+{
+    if (mWorld != nullptr)
+    {
+        mWorld->MarkPrimitiveBoundsDirty(this);
+    }
+}
+
+bool Primitive3D::IsRenderBoundsDirty() const
+{
+    return mRenderBoundsDirty;
+}
+
+void Primitive3D::SetRenderBoundsDirty(bool dirty)
+{
+    mRenderBoundsDirty = dirty;
+}
+
+uint32_t Primitive3D::GetDirtyBoundsIndex() const
+{
+    return mDirtyBoundsIndex;
+}
+
+void Primitive3D::SetDirtyBoundsIndex(uint32_t index)
+{
+    mDirtyBoundsIndex = index;
+}
+
 void Primitive3D::GatherProxyDraws(std::vector<DebugDraw>& inoutDraws)
 {
 #if DEBUG_DRAW_ENABLED
@@ -894,6 +954,8 @@ bool Primitive3D::IsRigidBodyInWorld() const
 
 void Primitive3D::EnableRigidBody(bool enable)
 {
+    OCT_ASSERT(!World::IsParallelTickThread());
+
     World* world = GetWorld();
     if (world == nullptr)
         return;
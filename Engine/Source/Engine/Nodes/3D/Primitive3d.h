@@ -56,6 +56,7 @@ public:
 
     virtual const char* GetTypeName() const override;
     virtual bool IsPrimitive3D() const override;
+    virtual bool CanTickInParallel() const override;
     virtual void Tick(float deltaTime) override;
     virtual void GatherProperties(std::vector<Property>& outProps) override;
 
@@ -139,6 +140,13 @@ public:
     Bounds GetBounds() const;
     virtual Bounds GetLocalBounds() const;
 
+    // Call when the local bounds change so that the world's bounds tree gets refit.
+    void MarkBoundsDirty();
+    bool IsRenderBoundsDirty() const;
+    void SetRenderBoundsDirty(bool dirty);
+    uint32_t GetDirtyBoundsIndex() const;
+    void SetDirtyBoundsIndex(uint32_t index);
+
     virtual void GatherProxyDraws(std::vector<DebugDraw>& inoutDraws) override;
 
     static bool HandlePropChange(Datum* datum, uint32_t index, const void* newValue);
@@ -173,6 +181,8 @@ protected:
     bool mCastShadows = false;
     bool mReceiveShadows = true;
     bool mReceiveSimpleShadows = true;
+    bool mRenderBoundsDirty = false;
+    uint32_t mDirtyBoundsIndex = 0;
     //BeginOverlapHandlerFP mBeginOverlapHandler;
     //EndOverlapHandlerFP mEndOverlapHandler;
     //CollisionHandlerFP mCollisionHandler;
@@ -6,9 +6,16 @@
 #include "Log.h"
 #include "Maths.h"
 #include "Utilities.h"
+#include "Skinning.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "World.h"
+#include "Nodes/3D/Camera3d.h"
 
 #include "Graphics/Graphics.h"
 
+#include <algorithm>
+
 static const char* sBoneInfluenceModeStrings[] =
 {
     "One Bone",
@@ -20,23 +27,16 @@ static const char* sAnimationUpdateModeStrings[] =
 {
     "Always Update",
     "Always Update Time",
-    "Only When Rendered"
+    "Only When Rendered",
+    "Distance Rate"
 };
-static_assert(int32_t(AnimationUpdateMode::Count) == 3, "Need to update string conversion table");
+static_assert(int32_t(AnimationUpdateMode::Count) == 4, "Need to update string conversion table");
 
 FORCE_LINK_DEF(SkeletalMesh3D);
 DEFINE_NODE(SkeletalMesh3D, Mesh3D);
 
 #define NUM_ANIMATION_SLOTS 8
 
-struct DecompTransform
-{
-    glm::vec3 mPosition = { 0.0f, 0.0f, 0.0f };
-    glm::quat mRotation = { 0.0f, 0.0f, 0.0f, 1.0f };
-    glm::vec3 mScale = { 1.0f, 1.0f, 1.0f };
-    bool mValid = false;
-};
-
 bool SkeletalMesh3D::HandlePropChange(Datum* datum, uint32_t index, const void* newValue)
 {
     Property* prop = static_cast<Property*>(datum);
@@ -56,6 +56,11 @@ bool SkeletalMesh3D::HandlePropChange(Datum* datum, uint32_t index, const void*
         meshComp->PlayAnimation(meshComp->mDefaultAnimation.c_str(), true, 1.0f, 1.0f, 0);
         success = true;
     }
+    else if (prop->mName == "Bounds Radius Override")
+    {
+        meshComp->SetBoundsRadiusOverride(*(float*) newValue);
+        success = true;
+    }
 
     return success;
 }
@@ -104,7 +109,9 @@ void SkeletalMesh3D::GatherProperties(std::vector<Property>& outProps)
     outProps.push_back(Property(DatumType::Bool, "Inherit Pose", this, &mInheritPose));
     outProps.push_back(Property(DatumType::Integer, "Bone Influence Mode", this, &mBoneInfluenceMode, 1, nullptr, NULL_DATUM, (int32_t)BoneInfluenceMode::Num, sBoneInfluenceModeStrings));
     outProps.push_back(Property(DatumType::Integer, "Animation Update Mode", this, &mAnimationUpdateMode, 1, nullptr, NULL_DATUM, (int32_t)AnimationUpdateMode::Count, sAnimationUpdateModeStrings));
-    outProps.push_back(Property(DatumType::Float, "Bounds Radius Override", this, &mBoundsRadiusOverride));
+    outProps.push_back(Property(DatumType::Float, "Animation LOD Distance", this, &mAnimLodDistance));
+    outProps.push_back(Property(DatumType::Integer, "Animation LOD Max Interval", this, &mAnimLodMaxInterval));
+    outProps.push_back(Property(DatumType::Float, "Bounds Radius Override", this, &mBoundsRadiusOverride, 1, HandlePropChange));
 }
 
 void SkeletalMesh3D::Create()
@@ -143,6 +150,13 @@ void SkeletalMesh3D::EditorTick(float deltaTime)
     TickCommon(deltaTime);
 }
 
+bool SkeletalMesh3D::IsParallelTickSafe() const
+{
+    // Tick only resets the animation flag. Animation itself is updated after ticking,
+    // and physics driven meshes are kept on the main thread by Primitive3D::CanTickInParallel().
+    return true;
+}
+
 void SkeletalMesh3D::TickCommon(float deltaTime)
 {
     mHasAnimatedThisFrame = false;
@@ -190,6 +204,8 @@ void SkeletalMesh3D::SetSkeletalMesh(SkeletalMesh* skeletalMesh)
         {
             mBoneMatrices.resize(0);
         }
+
+        MarkBoundsDirty();
     }
 }
 
@@ -460,7 +476,11 @@ bool SkeletalMesh3D::IsInheritPoseEnabled() const
 
 void SkeletalMesh3D::SetBoundsRadiusOverride(float radius)
 {
-    mBoundsRadiusOverride = radius;
+    if (mBoundsRadiusOverride != radius)
+    {
+        mBoundsRadiusOverride = radius;
+        MarkBoundsDirty();
+    }
 }
 
 float SkeletalMesh3D::GetBoundsRadiusOverride() const
@@ -544,14 +564,49 @@ void SkeletalMesh3D::SetScriptAnimEventHandler(const ScriptFunc& func)
     mAnimEventHandler.mScriptFunc = func;
 }
 
-glm::vec3 SkeletalMesh3D::InterpolateScale(float time, const Channel& channel)
+// Returns the index of the key that starts the interval containing time, clamped to [0, size - 2].
+// Checks the cursor and its neighbors first, and only binary searches after seeks and loops.
+template<typename KeyType>
+static uint32_t FindKeyIndex(float time, const std::vector<KeyType>& keys, uint32_t& cursor)
+{
+    OCT_ASSERT(keys.size() > 1);
+
+    const uint32_t lastIndex = uint32_t(keys.size() - 2);
+    uint32_t index = glm::min(cursor, lastIndex);
+
+    for (uint32_t step = 0; step < 3; ++step)
+    {
+        bool afterStart = (index == 0 || time >= keys[index].mTime);
+        bool beforeEnd = (index == lastIndex || time < keys[index + 1].mTime);
+
+        if (afterStart && beforeEnd)
+        {
+            cursor = index;
+            return index;
+        }
+
+        index = afterStart ? (index + 1) : (index - 1);
+    }
+
+    auto it = std::upper_bound(
+        keys.begin() + 1,
+        keys.end(),
+        time,
+        [](float t, const KeyType& key) { return t < key.mTime; });
+
+    index = glm::min(uint32_t(it - keys.begin()) - 1, lastIndex);
+    cursor = index;
+    return index;
+}
+
+glm::vec3 SkeletalMesh3D::InterpolateScale(float time, const Channel& channel, uint32_t& cursor)
 {
     if (channel.mScaleKeys.size() == 1)
     {
         return channel.mScaleKeys[0].mValue;
     }
 
-    uint32_t index = FindScaleIndex(time, channel);
+    uint32_t index = FindScaleIndex(time, channel, cursor);
     uint32_t nextIndex = index + 1;
     OCT_ASSERT(nextIndex < channel.mScaleKeys.size());
 
@@ -566,14 +621,14 @@ glm::vec3 SkeletalMesh3D::InterpolateScale(float time, const Channel& channel)
     return retScale;
 }
 
-glm::quat SkeletalMesh3D::InterpolateRotation(float time, const Channel& channel)
+glm::quat SkeletalMesh3D::InterpolateRotation(float time, const Channel& channel, uint32_t& cursor)
 {
     if (channel.mRotationKeys.size() == 1)
     {
         return channel.mRotationKeys[0].mValue;
     }
 
-    uint32_t index = FindRotationIndex(time, channel);
+    uint32_t index = FindRotationIndex(time, channel, cursor);
     uint32_t nextIndex = index + 1;
     OCT_ASSERT(nextIndex < channel.mRotationKeys.size());
 
@@ -589,14 +644,14 @@ glm::quat SkeletalMesh3D::InterpolateRotation(float time, const Channel& channel
     return retQuat;
 }
 
-glm::vec3 SkeletalMesh3D::InterpolatePosition(float time, const Channel& channel)
+glm::vec3 SkeletalMesh3D::InterpolatePosition(float time, const Channel& channel, uint32_t& cursor)
 {
     if (channel.mPositionKeys.size() == 1)
     {
         return channel.mPositionKeys[0].mValue;
     }
 
-    uint32_t index = FindPositionIndex(time, channel);
+    uint32_t index = FindPositionIndex(time, channel, cursor);
     uint32_t nextIndex = index + 1;
     OCT_ASSERT(nextIndex < channel.mPositionKeys.size());
 
@@ -611,6 +666,27 @@ glm::vec3 SkeletalMesh3D::InterpolatePosition(float time, const Channel& channel
     return retPos;
 }
 
+void SkeletalMesh3D::SampleBakedChannel(
+    float time,
+    const Animation& animation,
+    const Channel& channel,
+    glm::vec3& outPosition,
+    glm::quat& outRotation,
+    glm::vec3& outScale)
+{
+    OCT_ASSERT(animation.mBakedInterval > 0.0f);
+    OCT_ASSERT(channel.mBakedPositions.size() > 1);
+
+    const uint32_t lastIndex = uint32_t(channel.mBakedPositions.size() - 2);
+    float sample = glm::max(time / animation.mBakedInterval, 0.0f);
+    uint32_t index = glm::min(uint32_t(sample), lastIndex);
+    float factor = glm::clamp(sample - float(index), 0.0f, 1.0f);
+
+    outPosition = glm::mix(channel.mBakedPositions[index], channel.mBakedPositions[index + 1], factor);
+    outRotation = glm::normalize(glm::slerp(channel.mBakedRotations[index], channel.mBakedRotations[index + 1], factor));
+    outScale = glm::mix(channel.mBakedScales[index], channel.mBakedScales[index + 1], factor);
+}
+
 void SkeletalMesh3D::DetectTriggeredAnimEvents(
     const Animation& animation,
     float prevTickTime,
@@ -643,49 +719,19 @@ void SkeletalMesh3D::DetectTriggeredAnimEvents(
     }
 }
 
-uint32_t SkeletalMesh3D::FindScaleIndex(float time, const Channel& channel)
+uint32_t SkeletalMesh3D::FindScaleIndex(float time, const Channel& channel, uint32_t& cursor)
 {
-    OCT_ASSERT(channel.mScaleKeys.size() > 0);
-
-    for (uint32_t i = 0; i < channel.mScaleKeys.size() - 1; ++i)
-    {
-        if (time < channel.mScaleKeys[i + 1].mTime)
-        {
-            return i;
-        }
-    }
-
-    return uint32_t(channel.mScaleKeys.size() - 2);
+    return FindKeyIndex(time, channel.mScaleKeys, cursor);
 }
 
-uint32_t SkeletalMesh3D::FindRotationIndex(float time, const Channel& channel)
+uint32_t SkeletalMesh3D::FindRotationIndex(float time, const Channel& channel, uint32_t& cursor)
 {
-    OCT_ASSERT(channel.mRotationKeys.size() > 0);
-
-    for (uint32_t i = 0; i < channel.mRotationKeys.size() - 1; ++i)
-    {
-        if (time < channel.mRotationKeys[i + 1].mTime)
-        {
-            return i;
-        }
-    }
-
-    return uint32_t(channel.mRotationKeys.size() - 2);
+    return FindKeyIndex(time, channel.mRotationKeys, cursor);
 }
 
-uint32_t SkeletalMesh3D::FindPositionIndex(float time, const Channel& channel)
+uint32_t SkeletalMesh3D::FindPositionIndex(float time, const Channel& channel, uint32_t& cursor)
 {
-    OCT_ASSERT(channel.mPositionKeys.size() > 0);
-
-    for (uint32_t i = 0; i < channel.mPositionKeys.size() - 1; ++i)
-    {
-        if (time < channel.mPositionKeys[i + 1].mTime)
-        {
-            return i;
-        }
-    }
-
-    return uint32_t(channel.mPositionKeys.size() - 2);
+    return FindKeyIndex(time, channel.mPositionKeys, cursor);
 }
 
 glm::mat4 SkeletalMesh3D::GetBoneTransform(const std::string& name) const
@@ -859,6 +905,26 @@ void SkeletalMesh3D::SetAnimationUpdateMode(AnimationUpdateMode mode)
     mAnimationUpdateMode = mode;
 }
 
+void SkeletalMesh3D::SetAnimationLodDistance(float distance)
+{
+    mAnimLodDistance = distance;
+}
+
+float SkeletalMesh3D::GetAnimationLodDistance() const
+{
+    return mAnimLodDistance;
+}
+
+void SkeletalMesh3D::SetAnimationLodMaxInterval(int32_t interval)
+{
+    mAnimLodMaxInterval = glm::max(interval, 1);
+}
+
+int32_t SkeletalMesh3D::GetAnimationLodMaxInterval() const
+{
+    return mAnimLodMaxInterval;
+}
+
 Vertex* SkeletalMesh3D::GetSkinnedVertices()
 {
     return mSkinnedVertices.data();
@@ -908,14 +974,24 @@ Bounds SkeletalMesh3D::GetLocalBounds() const
 }
 
 void SkeletalMesh3D::UpdateAnimation(float deltaTime, bool updateBones)
+{
+    if (AdvanceAnimation(deltaTime, updateBones))
+    {
+        EvaluatePose();
+        FinishAnimationUpdate(deltaTime);
+    }
+}
+
+bool SkeletalMesh3D::AdvanceAnimation(float deltaTime, bool updateBones)
 {
     if (mHasAnimatedThisFrame)
-        return;
+        return false;
 
-    static std::vector<DecompTransform> sDecompTransforms;
-    static std::vector<AnimEvent> sAnimEvents;
-    sAnimEvents.clear();
-    sDecompTransforms.clear();
+    mHasAnimatedThisFrame = true;
+    mUpdatingBones = updateBones;
+    mEvaluatePose = false;
+    mCpuSkinPending = false;
+    mPendingAnimEvents.clear();
 
     SkeletalMesh* mesh = mSkeletalMesh.Get<SkeletalMesh>();
 
@@ -957,212 +1033,517 @@ void SkeletalMesh3D::UpdateAnimation(float deltaTime, bool updateBones)
         !inheritPose && 
         (mActiveAnimations.size() > 0 || mRevertToBindPose))
     {
-        uint32_t numBones = GetNumBones();
-        sDecompTransforms.resize(numBones);
-
-        if (updateBones)
-        {
-            mesh->CopyBindPose(mBoneMatrices);
-        }
-
-        bool bonesUpdated = false;
-
-        for (int32_t i = 0; i < (int32_t)mActiveAnimations.size(); ++i)
+        for (uint32_t i = 0; i < mActiveAnimations.size(); ++i)
         {
-            const Animation* anim = mesh->GetAnimation(mActiveAnimations[i].mName.c_str());
-            bool animFinished = false;
+            ActiveAnimation& activeAnim = mActiveAnimations[i];
+            const Animation* anim = mesh->GetAnimation(activeAnim.mName.c_str());
 
-            if (anim != nullptr)
+            if (anim == nullptr)
             {
-                float prevAnimTime = mActiveAnimations[i].mTime;
-                float& animationTime = mActiveAnimations[i].mTime;
-                float animationSpeed = mActiveAnimations[i].mSpeed * mAnimationSpeed;
-                animationTime += (deltaTime * animationSpeed);
+                LogWarning("Invalid animation name \"%s\" received in SkeletalMesh::AnimateBones()", activeAnim.mName.c_str());
+                activeAnim.mFinished = true;
+                continue;
+            }
 
-                float weight = mActiveAnimations[i].mWeight;
-                weight = glm::clamp(weight, 0.0f, 1.0f);
+            float prevAnimTime = activeAnim.mTime;
+            float& animationTime = activeAnim.mTime;
+            float animationSpeed = activeAnim.mSpeed * mAnimationSpeed;
+            animationTime += (deltaTime * animationSpeed);
 
-                if (anim != nullptr)
+            // Mod the animation time to fit within the animation duration
+            const float durationSeconds = anim->mDuration / anim->mTicksPerSecond;
+            const float prevTickTime = prevAnimTime * anim->mTicksPerSecond;
+
+            if (activeAnim.mLoop)
+            {
+                if (animationSpeed > 0.0f &&
+                    animationTime > durationSeconds)
                 {
-                    // Mod the animation time to fit within the animation duration
-                    const float durationSeconds = anim->mDuration / anim->mTicksPerSecond;
-                    const float prevTickTime = prevAnimTime * anim->mTicksPerSecond;
-
-                    if (mActiveAnimations[i].mLoop)
-                    {
-                        if (animationSpeed > 0.0f &&
-                            animationTime > durationSeconds)
-                        {
-                            animationTime = fmod(animationTime - durationSeconds, durationSeconds);
-                        }
-                        else if (animationSpeed < 0.0f &&
-                                 animationTime < 0.0f)
-                        {
-                            animationTime = fmod(durationSeconds + animationTime, durationSeconds);
-                        }
-                    }
-                    else
-                    {
-                        if (animationTime > durationSeconds)
-                        {
-                            animFinished = true;
-                            animationTime = durationSeconds;
-                        }
-                    }
-
-                    if (weight > 0.0f)
-                    {
-                        float tickTime = animationTime * anim->mTicksPerSecond;
-
-                        if (updateBones)
-                        {
-                            // Go through all the channels, and update the relative transform 
-                            // for each bone that exists in the animation.
-                            for (uint32_t i = 0; i < anim->mChannels.size(); ++i)
-                            {
-                                int32_t boneIndex = anim->mChannels[i].mBoneIndex;
-                                OCT_ASSERT(boneIndex != -1 &&
-                                    boneIndex >= 0 &&
-                                    boneIndex < (int32_t)mesh->GetBones().size());
-
-                                if (boneIndex != -1)
-                                {
-                                    glm::vec3 scale = InterpolateScale(tickTime, anim->mChannels[i]);
-                                    glm::quat rotation = InterpolateRotation(tickTime, anim->mChannels[i]);
-                                    glm::vec3 position = InterpolatePosition(tickTime, anim->mChannels[i]);
-
-                                    if (bonesUpdated)
-                                    {
-                                        sDecompTransforms[boneIndex].mPosition = glm::mix(sDecompTransforms[boneIndex].mPosition, position, weight);
-                                        sDecompTransforms[boneIndex].mRotation = glm::slerp(sDecompTransforms[boneIndex].mRotation, rotation, weight);
-                                        sDecompTransforms[boneIndex].mScale = glm::mix(sDecompTransforms[boneIndex].mScale, scale, weight);
-                                    }
-                                    else
-                                    {
-                                        // First animation doesn't need lerps.
-                                        sDecompTransforms[boneIndex].mPosition = position;
-                                        sDecompTransforms[boneIndex].mRotation = rotation;
-                                        sDecompTransforms[boneIndex].mScale = scale;
-                                    }
-
-                                    sDecompTransforms[boneIndex].mValid = true;
-                                }
-                            }
-                        }
-
-                        if (anim->mEventTracks.size() > 0)
-                        {
-                            DetectTriggeredAnimEvents(*anim, prevTickTime, tickTime, animationSpeed, sAnimEvents);
-                        }
-
-                        bonesUpdated = true;
-                    }
+                    animationTime = fmod(animationTime - durationSeconds, durationSeconds);
+                }
+                else if (animationSpeed < 0.0f &&
+                         animationTime < 0.0f)
+                {
+                    animationTime = fmod(durationSeconds + animationTime, durationSeconds);
                 }
             }
             else
             {
-                LogWarning("Invalid animation name \"%s\" received in SkeletalMesh::AnimateBones()", mActiveAnimations[i].mName.c_str());
-                animFinished = true;
+                if (animationTime > durationSeconds)
+                {
+                    activeAnim.mFinished = true;
+                    animationTime = durationSeconds;
+                }
             }
 
-            if (animFinished)
+            if (activeAnim.mWeight > 0.0f &&
+                anim->mEventTracks.size() > 0)
             {
-                const std::string& animName = mActiveAnimations[i].mName;
+                float tickTime = animationTime * anim->mTicksPerSecond;
+                DetectTriggeredAnimEvents(*anim, prevTickTime, tickTime, animationSpeed, mPendingAnimEvents);
+            }
+        }
 
-                for (int32_t q = int32_t(mQueuedAnimations.size()) - 1; q >= 0; --q)
-                {
-                    if (mQueuedAnimations[q].mDependentAnim == animName)
-                    {
-                        QueuedAnimation& queuedAnim = mQueuedAnimations[q];
-                        PlayAnimation(
-                            queuedAnim.mName.c_str(),
-                            queuedAnim.mLoop,
-                            queuedAnim.mSpeed,
-                            queuedAnim.mWeight,
-                            queuedAnim.mSlot);
-
-                        mQueuedAnimations.erase(mQueuedAnimations.begin() + q);
-                    }
-                }
+        if (updateBones)
+        {
+            mEvaluatePose = true;
 
-                mActiveAnimations.erase(mActiveAnimations.begin() + i);
-                --i;
+            // Sample a new pose once the LOD interval has passed. The sample is taken one interval
+            // ahead, and the frames in between interpolate towards it in EvaluatePose().
+            uint32_t lodInterval = ComputeLodInterval();
+            mSamplePose = (mFramesSincePoseSample >= mAnimLodInterval) ||
+                (lodInterval < mAnimLodInterval) ||
+                (mPose.size() != GetNumBones());
+
+            if (mSamplePose)
+            {
+                mFramesSincePoseSample = 0;
+                mAnimLodInterval = lodInterval;
+                mPoseLookahead = (lodInterval > 1) ? deltaTime * float(lodInterval) : 0.0f;
             }
+
+            ++mFramesSincePoseSample;
         }
+    }
 
-        if (updateBones)
+    // CPU skinned characters need to update their verts even if they are paused
+    // because vertex data is double buffered for MAX_FRAMES.
+    mCpuSkinPending = updateBones &&
+        mesh != nullptr &&
+        (mEvaluatePose || inheritPose || mAnimationPaused);
+
+    return true;
+}
+
+void SkeletalMesh3D::EvaluatePose()
+{
+    SkeletalMesh* mesh = mSkeletalMesh.Get<SkeletalMesh>();
+
+    if (mesh == nullptr)
+        return;
+
+    if (mEvaluatePose)
+    {
+        uint32_t numBones = GetNumBones();
+
+        if (mSamplePose)
         {
-            // Unless no animations were computed, create bone matrices for all the bones
-            // from the decomposed parts (position / rotation / scale);
-            if (bonesUpdated)
+            mPrevPose.swap(mPose);
+            SamplePose(mesh, mPose);
+
+            if (mPrevPose.size() != mPose.size())
             {
-                // Create matrices from lerped pos/rot/scale
-                for (uint32_t i = 0; i < numBones; ++i)
-                {
-                    if (sDecompTransforms[i].mValid)
-                    {
-                        glm::mat4& transform = mBoneMatrices[i];
+                mPrevPose = mPose;
+            }
+        }
 
-                        transform = glm::mat4(1.0f);
+        // mFramesSincePoseSample is 1 on the frame a sample is taken. The previous sample was
+        // taken for this frame, and the new one for the frame the next sample is due.
+        float alpha = 1.0f;
+        if (mAnimLodInterval > 1)
+        {
+            alpha = float(mFramesSincePoseSample - 1) / float(mAnimLodInterval);
+        }
+
+        mesh->CopyBindPose(mBoneMatrices);
+
+        // Create matrices from lerped pos/rot/scale
+        for (uint32_t i = 0; i < numBones; ++i)
+        {
+            if (mPose[i].mValid)
+            {
+                glm::vec3 position = mPose[i].mPosition;
+                glm::quat rotation = mPose[i].mRotation;
+                glm::vec3 scale = mPose[i].mScale;
 
-                        transform = glm::translate(transform, sDecompTransforms[i].mPosition);
-                        transform *= glm::toMat4(sDecompTransforms[i].mRotation);
-                        transform = glm::scale(transform, sDecompTransforms[i].mScale);
-                    }
+                if (alpha < 1.0f && mPrevPose[i].mValid)
+                {
+                    position = glm::mix(mPrevPose[i].mPosition, position, alpha);
+                    rotation = glm::slerp(mPrevPose[i].mRotation, rotation, alpha);
+                    scale = glm::mix(mPrevPose[i].mScale, scale, alpha);
                 }
+
+                glm::mat4& transform = mBoneMatrices[i];
+
+                transform = glm::mat4(1.0f);
+
+                transform = glm::translate(transform, position);
+                transform *= glm::toMat4(rotation);
+                transform = glm::scale(transform, scale);
             }
+        }
 
-            mesh->FinalizeBoneTransforms(mBoneMatrices);
+        mesh->FinalizeBoneTransforms(mBoneMatrices);
+    }
 
-            if (GFX_IsCpuSkinningRequired(this))
+    if (mCpuSkinPending &&
+        GFX_IsCpuSkinningRequired(this))
+    {
+        CpuSkinVertices();
+    }
+}
+
+void SkeletalMesh3D::FinishAnimationUpdate(float deltaTime)
+{
+    if (mUploadSkinnedVertices)
+    {
+        GFX_UpdateSkeletalMeshCompVertexBuffer(this, mSkinnedVertices);
+        mUploadSkinnedVertices = false;
+    }
+
+    // Remove finished animations and start anything queued behind them. Playing an animation
+    // can reorder the active list, so start over from the front after each one.
+    for (uint32_t i = 0; i < mActiveAnimations.size(); ++i)
+    {
+        if (!mActiveAnimations[i].mFinished)
+            continue;
+
+        std::string animName = mActiveAnimations[i].mName;
+        mActiveAnimations.erase(mActiveAnimations.begin() + i);
+
+        for (int32_t q = int32_t(mQueuedAnimations.size()) - 1; q >= 0; --q)
+        {
+            if (mQueuedAnimations[q].mDependentAnim == animName)
             {
-                CpuSkinVertices();
+                QueuedAnimation queuedAnim = mQueuedAnimations[q];
+                mQueuedAnimations.erase(mQueuedAnimations.begin() + q);
+
+                PlayAnimation(
+                    queuedAnim.mName.c_str(),
+                    queuedAnim.mLoop,
+                    queuedAnim.mSpeed,
+                    queuedAnim.mWeight,
+                    queuedAnim.mSlot);
             }
         }
 
-        // Fire off any events that triggered.
-        if (mAnimEventHandler.mFuncPointer != nullptr)
+        i = uint32_t(-1);
+    }
+
+    // Fire off any events that triggered.
+    if (mAnimEventHandler.mFuncPointer != nullptr)
+    {
+        for (uint32_t i = 0; i < mPendingAnimEvents.size(); ++i)
         {
-            for (uint32_t i = 0; i < sAnimEvents.size(); ++i)
+            mPendingAnimEvents[i].mNode = this;
+            mAnimEventHandler.mFuncPointer(mPendingAnimEvents[i]);
+        }
+    }
+    if (mAnimEventHandler.mScriptFunc.IsValid())
+    {
+        for (uint32_t i = 0; i < mPendingAnimEvents.size(); ++i)
+        {
+            mPendingAnimEvents[i].mNode = this;
+
+            Datum animTable;
+            animTable.SetNodeField("node", ResolveWeakPtr<Node>(mPendingAnimEvents[i].mNode));
+            animTable.SetStringField("name", mPendingAnimEvents[i].mName);
+            animTable.SetStringField("animation", mPendingAnimEvents[i].mAnimation);
+            animTable.SetFloatField("time", mPendingAnimEvents[i].mTime);
+            animTable.SetVectorField("value", mPendingAnimEvents[i].mValue);
+
+            mAnimEventHandler.mScriptFunc.Call(1, &animTable);
+        }
+    }
+
+    mPendingAnimEvents.clear();
+
+    if (mUpdatingBones)
+    {
+        UpdateAttachedChildren(deltaTime);
+    }
+}
+
+struct PoseEvaluationBatch
+{
+    SkeletalMesh3D** mNodes = nullptr;
+    uint32_t mNumNodes = 0;
+};
+
+static void PoseEvaluationJob(void* arg)
+{
+    SCOPED_FRAME_STAT("PoseEvaluation");
+    PoseEvaluationBatch* batch = (PoseEvaluationBatch*)arg;
+
+    for (uint32_t i = 0; i < batch->mNumNodes; ++i)
+    {
+        batch->mNodes[i]->EvaluatePose();
+    }
+}
+
+void SkeletalMesh3D::UpdateAnimations(const std::vector<AnimationUpdateRequest>& requests, float deltaTime)
+{
+    static std::vector<SkeletalMesh3D*> sAdvancedNodes;
+    static std::vector<uint32_t> sInheritingRequests;
+    static std::vector<PoseEvaluationBatch> sBatches;
+    static std::vector<Job> sJobs;
+    sAdvancedNodes.clear();
+    sInheritingRequests.clear();
+
+    for (uint32_t i = 0; i < requests.size(); ++i)
+    {
+        SkeletalMesh3D* node = requests[i].mNode;
+
+        // Meshes that inherit their parent's pose need the parent's bones to be finished first.
+        if (node->IsInheritPoseEnabled())
+        {
+            sInheritingRequests.push_back(i);
+        }
+        else if (node->AdvanceAnimation(deltaTime, requests[i].mUpdateBones))
+        {
+            sAdvancedNodes.push_back(node);
+        }
+    }
+
+    JobSystem* jobSystem = JobSystem::Get();
+    uint32_t numNodes = uint32_t(sAdvancedNodes.size());
+    uint32_t numWorkers = (jobSystem != nullptr) ? jobSystem->GetNumWorkers() : 0;
+
+    if (numWorkers > 0 && numNodes > 1)
+    {
+        // A few batches per thread so that one heavy mesh doesn't hold up everything else.
+        uint32_t numBatches = glm::min(numNodes, (numWorkers + 1) * 4);
+        uint32_t batchSize = (numNodes + numBatches - 1) / numBatches;
+        numBatches = (numNodes + batchSize - 1) / batchSize;
+
+        sBatches.resize(numBatches);
+        sJobs.resize(numBatches);
+
+        for (uint32_t i = 0; i < numBatches; ++i)
+        {
+            uint32_t start = i * batchSize;
+            sBatches[i].mNodes = sAdvancedNodes.data() + start;
+            sBatches[i].mNumNodes = glm::min(batchSize, numNodes - start);
+            sJobs[i].mFunc = PoseEvaluationJob;
+            sJobs[i].mArg = &sBatches[i];
+        }
+
+        jobSystem->RunJobs(sJobs.data(), numBatches);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numNodes; ++i)
+        {
+            sAdvancedNodes[i]->EvaluatePose();
+        }
+    }
+
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        sAdvancedNodes[i]->FinishAnimationUpdate(deltaTime);
+    }
+
+    for (uint32_t i = 0; i < sInheritingRequests.size(); ++i)
+    {
+        const AnimationUpdateRequest& request = requests[sInheritingRequests[i]];
+        request.mNode->UpdateAnimation(deltaTime, request.mUpdateBones);
+    }
+}
+
+// Meshes playing a single animation at the same time within a frame end up with the same pose,
+// so the first one to sample it shares the result with the rest.
+struct SharedPoseKey
+{
+    const SkeletalMesh* mMesh = nullptr;
+    const Animation* mAnimation = nullptr;
+    float mTickTime = 0.0f;
+
+    bool operator==(const SharedPoseKey& other) const
+    {
+        return mMesh == other.mMesh &&
+            mAnimation == other.mAnimation &&
+            mTickTime == other.mTickTime;
+    }
+};
+
+struct SharedPoseKeyHash
+{
+    size_t operator()(const SharedPoseKey& key) const
+    {
+        uint32_t timeBits;
+        memcpy(&timeBits, &key.mTickTime, sizeof(timeBits));
+
+        size_t hash = std::hash<const void*>()(key.mMesh);
+        hash ^= std::hash<const void*>()(key.mAnimation) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32_t>()(timeBits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+static std::unordered_map<SharedPoseKey, std::vector<DecompTransform>, SharedPoseKeyHash> sSharedPoses;
+static uint32_t sSharedPoseFrame = 0;
+
+void SkeletalMesh3D::SamplePose(SkeletalMesh* mesh, std::vector<DecompTransform>& outPose)
+{
+    static MutexObject* sSharedPoseMutex = SYS_CreateMutex();
+
+    uint32_t numBones = GetNumBones();
+    outPose.clear();
+    outPose.resize(numBones);
+
+    SharedPoseKey sharedKey;
+    bool shareable = false;
+
+    // With a single animation, its weight doesn't affect the pose (the first animation doesn't lerp).
+    if (mActiveAnimations.size() == 1 &&
+        mActiveAnimations[0].mWeight > 0.0f)
+    {
+        const Animation* anim = mesh->GetAnimation(mActiveAnimations[0].mName.c_str());
+
+        if (anim != nullptr)
+        {
+            shareable = true;
+            sharedKey.mMesh = mesh;
+            sharedKey.mAnimation = anim;
+            sharedKey.mTickTime = GetPoseSampleTime(mActiveAnimations[0], *anim) * anim->mTicksPerSecond;
+
+            ScopedLock lock(sSharedPoseMutex);
+            uint32_t frame = GetEngineState()->mFrameNumber;
+
+            if (sSharedPoseFrame != frame)
+            {
+                sSharedPoses.clear();
+                sSharedPoseFrame = frame;
+            }
+
+            auto it = sSharedPoses.find(sharedKey);
+            if (it != sSharedPoses.end() &&
+                it->second.size() == numBones)
             {
-                sAnimEvents[i].mNode = this;
-                mAnimEventHandler.mFuncPointer(sAnimEvents[i]);
+                outPose = it->second;
+                return;
             }
         }
-        if (mAnimEventHandler.mScriptFunc.IsValid())
+    }
+
+    bool bonesUpdated = false;
+
+    for (uint32_t a = 0; a < mActiveAnimations.size(); ++a)
+    {
+        ActiveAnimation& activeAnim = mActiveAnimations[a];
+        const Animation* anim = mesh->GetAnimation(activeAnim.mName.c_str());
+
+        float weight = glm::clamp(activeAnim.mWeight, 0.0f, 1.0f);
+
+        if (anim == nullptr ||
+            weight <= 0.0f)
         {
-            for (uint32_t i = 0; i < sAnimEvents.size(); ++i)
+            continue;
+        }
+
+        float tickTime = GetPoseSampleTime(activeAnim, *anim) * anim->mTicksPerSecond;
+
+        std::vector<KeyCursor>& cursors = activeAnim.mKeyCursors;
+        if (cursors.size() != anim->mChannels.size())
+        {
+            cursors.clear();
+            cursors.resize(anim->mChannels.size());
+        }
+
+        // Go through all the channels, and update the relative transform 
+        // for each bone that exists in the animation.
+        for (uint32_t i = 0; i < anim->mChannels.size(); ++i)
+        {
+            const Channel& channel = anim->mChannels[i];
+            int32_t boneIndex = channel.mBoneIndex;
+            OCT_ASSERT(boneIndex != -1 &&
+                boneIndex >= 0 &&
+                boneIndex < (int32_t)mesh->GetBones().size());
+
+            if (boneIndex != -1)
             {
-                sAnimEvents[i].mNode = this;
+                glm::vec3 scale;
+                glm::quat rotation;
+                glm::vec3 position;
 
-                Datum animTable;
-                animTable.SetNodeField("node", ResolveWeakPtr<Node>(sAnimEvents[i].mNode));
-                animTable.SetStringField("name", sAnimEvents[i].mName);
-                animTable.SetStringField("animation", sAnimEvents[i].mAnimation);
-                animTable.SetFloatField("time", sAnimEvents[i].mTime);
-                animTable.SetVectorField("value", sAnimEvents[i].mValue);
+                if (anim->mBakedInterval > 0.0f &&
+                    channel.mBakedPositions.size() > 1)
+                {
+                    SampleBakedChannel(tickTime, *anim, channel, position, rotation, scale);
+                }
+                else
+                {
+                    scale = InterpolateScale(tickTime, channel, cursors[i].mScale);
+                    rotation = InterpolateRotation(tickTime, channel, cursors[i].mRotation);
+                    position = InterpolatePosition(tickTime, channel, cursors[i].mPosition);
+                }
+
+                if (bonesUpdated)
+                {
+                    outPose[boneIndex].mPosition = glm::mix(outPose[boneIndex].mPosition, position, weight);
+                    outPose[boneIndex].mRotation = glm::slerp(outPose[boneIndex].mRotation, rotation, weight);
+                    outPose[boneIndex].mScale = glm::mix(outPose[boneIndex].mScale, scale, weight);
+                }
+                else
+                {
+                    // First animation doesn't need lerps.
+                    outPose[boneIndex].mPosition = position;
+                    outPose[boneIndex].mRotation = rotation;
+                    outPose[boneIndex].mScale = scale;
+                }
 
-                mAnimEventHandler.mScriptFunc.Call(1, &animTable);
+                outPose[boneIndex].mValid = true;
             }
         }
+
+        bonesUpdated = true;
     }
 
-    // CPU skinned characters need to update their verts even if they are paused
-    // because vertex data is double buffered for MAX_FRAMES.
-    if (updateBones &&
-        (inheritPose || mAnimationPaused) &&
-        mesh != nullptr &&
-        GFX_IsCpuSkinningRequired(this))
+    if (shareable)
     {
-        CpuSkinVertices();
+        ScopedLock lock(sSharedPoseMutex);
+
+        if (sSharedPoseFrame == GetEngineState()->mFrameNumber)
+        {
+            sSharedPoses.insert({ sharedKey, outPose });
+        }
     }
+}
+
+float SkeletalMesh3D::GetPoseSampleTime(const ActiveAnimation& activeAnim, const Animation& anim) const
+{
+    float time = activeAnim.mTime;
 
-    if (updateBones)
+    if (mPoseLookahead > 0.0f)
     {
-        UpdateAttachedChildren(deltaTime);
+        const float durationSeconds = anim.mDuration / anim.mTicksPerSecond;
+        time += mPoseLookahead * activeAnim.mSpeed * mAnimationSpeed;
+
+        if (activeAnim.mLoop && durationSeconds > 0.0f)
+        {
+            time = fmod(time, durationSeconds);
+            if (time < 0.0f)
+            {
+                time += durationSeconds;
+            }
+        }
+        else
+        {
+            time = glm::clamp(time, 0.0f, durationSeconds);
+        }
     }
 
-    mHasAnimatedThisFrame = true;
+    return time;
+}
+
+uint32_t SkeletalMesh3D::ComputeLodInterval()
+{
+    uint32_t interval = 1;
+    Camera3D* camera = (mWorld != nullptr) ? mWorld->GetActiveCamera() : nullptr;
+
+    if (mAnimationUpdateMode == AnimationUpdateMode::DistanceRate &&
+        camera != nullptr &&
+        mAnimLodDistance > 0.0f &&
+        mAnimLodMaxInterval > 1)
+    {
+        // Every multiple of the LOD distance adds a frame between pose samples.
+        float distance = glm::distance(camera->GetWorldPosition(), GetWorldPosition());
+        // Clamp before converting, huge distances would overflow the uint32_t.
+        float lodInterval = glm::min(1.0f + distance / mAnimLodDistance, float(mAnimLodMaxInterval));
+        interval = uint32_t(lodInterval);
+    }
+
+    return interval;
 }
 
 void SkeletalMesh3D::UpdateAttachedChildren(float deltaTime)
@@ -1190,44 +1571,28 @@ void SkeletalMesh3D::CpuSkinVertices()
     SkeletalMesh* mesh = mSkeletalMesh.Get<SkeletalMesh>();
     if (mesh != nullptr)
     {
-        mSkinnedVertices.resize(mesh->GetNumVertices());
-        const std::vector<VertexSkinned>& verts = mesh->GetVertices();
-
-        if (mBoneInfluenceMode == BoneInfluenceMode::One)
-        {
-            for (uint32_t i = 0; i < mesh->GetNumVertices(); ++i)
-            {
-                const VertexSkinned& srcVert = verts[i];
-                Vertex& dstVert = mSkinnedVertices[i];
-
-                glm::mat4 transform = mBoneMatrices[srcVert.mBoneIndices[0]];
+        SCOPED_FRAME_STAT("CpuSkinning");
 
-                dstVert.mPosition = transform * glm::vec4(srcVert.mPosition, 1.0f);
-                dstVert.mNormal = transform * glm::vec4(srcVert.mNormal, 0.0f);
-                dstVert.mTexcoord0 = srcVert.mTexcoord0;
-                dstVert.mTexcoord1 = srcVert.mTexcoord1;
-            }
-        }
-        else
-        {
-            for (uint32_t i = 0; i < mesh->GetNumVertices(); ++i)
-            {
-                const VertexSkinned& srcVert = verts[i];
-                Vertex& dstVert = mSkinnedVertices[i];
-
-                static_assert(MAX_BONE_INFLUENCES == 4, "Need to adjust this code or convert to loop.");
-                glm::mat4 transform = mBoneMatrices[srcVert.mBoneIndices[0]] * srcVert.mBoneWeights[0];
-                transform += mBoneMatrices[srcVert.mBoneIndices[1]] * srcVert.mBoneWeights[1];
-                transform += mBoneMatrices[srcVert.mBoneIndices[2]] * srcVert.mBoneWeights[2];
-                transform += mBoneMatrices[srcVert.mBoneIndices[3]] * srcVert.mBoneWeights[3];
-
-                dstVert.mPosition = transform * glm::vec4(srcVert.mPosition, 1.0f);
-                dstVert.mNormal = transform * glm::vec4(srcVert.mNormal, 0.0f);
-                dstVert.mTexcoord0 = srcVert.mTexcoord0;
-                dstVert.mTexcoord1 = srcVert.mTexcoord1;
-            }
-        }
+        uint32_t numVertices = mesh->GetNumVertices();
+        mSkinnedVertices.resize(numVertices);
 
-        GFX_UpdateSkeletalMeshCompVertexBuffer(this, mSkinnedVertices);
+        const std::vector<VertexSkinned>& verts = mesh->GetVertices();
+        const std::vector<glm::vec4>& positions = mesh->GetSkinningPositions();
+        const std::vector<glm::vec4>& normals = mesh->GetSkinningNormals();
+        bool hasStreams = (positions.size() == numVertices && normals.size() == numVertices);
+
+        SkinningParams params;
+        params.mBoneMatrices = mBoneMatrices.data();
+        params.mVertices = verts.data();
+        params.mPositions = hasStreams ? positions.data() : nullptr;
+        params.mNormals = hasStreams ? normals.data() : nullptr;
+        params.mOutVertices = mSkinnedVertices.data();
+        params.mNumVertices = numVertices;
+        params.mNumInfluences = (mBoneInfluenceMode == BoneInfluenceMode::One) ? 1 : MAX_BONE_INFLUENCES;
+
+        SkinVerticesParallel(params);
+
+        // Uploaded by FinishAnimationUpdate(), since this may run on a worker thread.
+        mUploadSkinnedVertices = true;
     }
 }
@@ -16,6 +16,7 @@ enum class AnimationUpdateMode
     AlwaysUpdateTimeAndBones,
     AlwaysUpdateTime,
     OnlyUpdateWhenRendered,
+    DistanceRate, // Like OnlyUpdateWhenRendered, but far away meshes sample new poses less often.
 
     Count
 };
@@ -25,6 +26,23 @@ struct AnimEvent;
 struct Channel;
 struct Animation;
 
+struct DecompTransform
+{
+    glm::vec3 mPosition = { 0.0f, 0.0f, 0.0f };
+    glm::quat mRotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+    glm::vec3 mScale = { 1.0f, 1.0f, 1.0f };
+    bool mValid = false;
+};
+
+// Key index where each channel was last sampled. Playback usually stays within the same
+// pair of keys or moves to the next one, so sampling starts searching from here.
+struct KeyCursor
+{
+    uint32_t mPosition = 0;
+    uint32_t mRotation = 0;
+    uint32_t mScale = 0;
+};
+
 struct ActiveAnimation
 {
     std::string mName;
@@ -33,6 +51,8 @@ struct ActiveAnimation
     float mWeight = 0.0f;
     int32_t mSlot = 0;
     bool mLoop = false;
+    bool mFinished = false;
+    std::vector<KeyCursor> mKeyCursors;
 };
 
 struct QueuedAnimation
@@ -66,6 +86,7 @@ public:
 
     virtual void Tick(float deltaTime) override;
     virtual void EditorTick(float deltaTime) override;
+    virtual bool IsParallelTickSafe() const override;
 
     virtual bool IsStaticMesh3D() const override;
     virtual bool IsSkeletalMesh3D() const override;
@@ -124,6 +145,11 @@ public:
     AnimationUpdateMode GetAnimationUpdateMode() const;
     void SetAnimationUpdateMode(AnimationUpdateMode mode);
 
+    void SetAnimationLodDistance(float distance);
+    float GetAnimationLodDistance() const;
+    void SetAnimationLodMaxInterval(int32_t interval);
+    int32_t GetAnimationLodMaxInterval() const;
+
     Vertex* GetSkinnedVertices();
     uint32_t GetNumSkinnedVertices();
 
@@ -132,6 +158,16 @@ public:
 
     void UpdateAnimation(float deltaTime, bool updateBones);
 
+    // The phases of UpdateAnimation(). Advance and Finish touch animation state, events and
+    // scripts so they must run serially, but EvaluatePose() only writes to this mesh's own
+    // pose, so many meshes can evaluate in parallel between the two.
+    bool AdvanceAnimation(float deltaTime, bool updateBones);
+    void EvaluatePose();
+    void FinishAnimationUpdate(float deltaTime);
+
+    // Updates a batch of meshes, evaluating their poses across the job system.
+    static void UpdateAnimations(const std::vector<AnimationUpdateRequest>& requests, float deltaTime);
+
     virtual Bounds GetLocalBounds() const override;
 
     int32_t FindBoneIndex(const std::string& name) const;
@@ -146,9 +182,16 @@ protected:
 
     void TickCommon(float deltaTime);
 
-    glm::vec3 InterpolateScale(float time, const Channel& channel);
-    glm::quat InterpolateRotation(float time, const Channel& channel);
-    glm::vec3 InterpolatePosition(float time, const Channel& channel);
+    glm::vec3 InterpolateScale(float time, const Channel& channel, uint32_t& cursor);
+    glm::quat InterpolateRotation(float time, const Channel& channel, uint32_t& cursor);
+    glm::vec3 InterpolatePosition(float time, const Channel& channel, uint32_t& cursor);
+    void SampleBakedChannel(
+        float time,
+        const Animation& animation,
+        const Channel& channel,
+        glm::vec3& outPosition,
+        glm::quat& outRotation,
+        glm::vec3& outScale);
     void DetectTriggeredAnimEvents(
         const Animation& animation,
         float prevTickTime,
@@ -156,10 +199,13 @@ protected:
         float animationSpeed,
         std::vector<AnimEvent>& outEvents);
 
-    uint32_t FindScaleIndex(float time, const Channel& channel);
-    uint32_t FindRotationIndex(float time, const Channel& channel);
-    uint32_t FindPositionIndex(float time, const Channel& channel);
+    uint32_t FindScaleIndex(float time, const Channel& channel, uint32_t& cursor);
+    uint32_t FindRotationIndex(float time, const Channel& channel, uint32_t& cursor);
+    uint32_t FindPositionIndex(float time, const Channel& channel, uint32_t& cursor);
 
+    void SamplePose(SkeletalMesh* mesh, std::vector<DecompTransform>& outPose);
+    float GetPoseSampleTime(const ActiveAnimation& activeAnim, const Animation& anim) const;
+    uint32_t ComputeLodInterval();
     void UpdateAttachedChildren(float deltaTime);
     void CpuSkinVertices();
 
@@ -172,6 +218,23 @@ protected:
     float mAnimationSpeed = 1.0f;
     std::vector<ActiveAnimation> mActiveAnimations;
     std::vector<QueuedAnimation> mQueuedAnimations;
+    std::vector<AnimEvent> mPendingAnimEvents;
+
+    // Local bone transforms from the latest pose sample, and the one before it.
+    // With distance LOD, the frames between samples interpolate from one to the other.
+    std::vector<DecompTransform> mPose;
+    std::vector<DecompTransform> mPrevPose;
+    float mAnimLodDistance = 20.0f;
+    int32_t mAnimLodMaxInterval = 4;
+    uint32_t mAnimLodInterval = 1;
+    uint32_t mFramesSincePoseSample = 0;
+    float mPoseLookahead = 0.0f; // Seconds ahead of the animation time that the latest pose was sampled.
+    bool mSamplePose = false;
+    bool mEvaluatePose = false;
+    bool mCpuSkinPending = false;
+    bool mUploadSkinnedVertices = false;
+    bool mUpdatingBones = false;
+
     float mBoundsRadiusOverride = 0.0f;
     bool mAnimationPaused;
     bool mRevertToBindPose;
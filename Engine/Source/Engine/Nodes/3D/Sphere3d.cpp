@@ -90,6 +90,7 @@ void Sphere3D::SetRadius(float radius)
     {
         mRadius = radius;
         UpdateRigidBody();
+        MarkBoundsDirty();
     }
 }
 
@@ -159,6 +159,7 @@ void StaticMesh3D::SetStaticMesh(StaticMesh* staticMesh)
         mStaticMesh = staticMesh;
         RecreateCollisionShape();
         ClearInstanceColors();
+        MarkBoundsDirty();
     }
 }
 
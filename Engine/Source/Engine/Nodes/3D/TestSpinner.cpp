@@ -96,6 +96,12 @@ void TestSpinner::EditorTick(float deltaTime)
     TickCommon(deltaTime);
 }
 
+bool TestSpinner::IsParallelTickSafe() const
+{
+    // Only spins itself and the child meshes it created.
+    return true;
+}
+
 void TestSpinner::TickCommon(float deltaTime)
 {
     if (!mSpin)
@@ -20,6 +20,7 @@ public:
     virtual void Destroy() override;
     virtual void Tick(float deltaTime) override;
     virtual void EditorTick(float deltaTime) override;
+    virtual bool IsParallelTickSafe() const override;
 
     virtual void GatherProperties(std::vector<Property>& props) override;
 
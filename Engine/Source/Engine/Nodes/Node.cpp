@@ -61,6 +61,9 @@ std::unordered_set<NodePtrWeak> Node::sPendingDestroySet;
 
 NodeId Node::sNextNodeId = NodeId(1);
 
+static const SignalId sOnDestroySignal = InternSignal("OnDestroy");
+static const SignalId sOnStopSignal = InternSignal("OnStop");
+
 
 #define ENABLE_SCRIPT_FUNCS 1
 
@@ -91,6 +94,13 @@ bool Node::HandlePropChange(Datum* datum, uint32_t index, const void* newValue)
         const std::string& newName = *((const std::string*)newValue);
         node->SetName(newName);
 
+        success = true;
+    }
+    else if (prop->mName == "Tags")
+    {
+        node->mTags[index] = *((const std::string*)newValue);
+        node->UpdateTagIndex();
+
         success = true;
     }
 #if EDITOR
@@ -212,9 +222,9 @@ void Node::Destroy()
     if (mDestroyed)
         return;
 
-    if (mSignalMap.size() > 0)
+    if (HasSignalConnections(sOnDestroySignal))
     {
-        EmitSignal("OnDestroy", { this });
+        EmitSignal(sOnDestroySignal, { this });
     }
 
     // Lock a shared pointer so we don't delete ourselves midway through destruction.
@@ -484,9 +494,9 @@ void Node::Stop()
         mScript->CallFunction("Stop");
     }
 
-    if (mSignalMap.size() > 0)
+    if (HasSignalConnections(sOnStopSignal))
     {
-        EmitSignal("OnStop", { this });
+        EmitSignal(sOnStopSignal, { this });
     }
 
     if (mNetId != INVALID_NET_ID)
@@ -582,7 +592,8 @@ void Node::GatherProperties(std::vector<Property>& outProps)
         outProps.push_back(Property(DatumType::Bool, "Replicate", this, &mReplicate));
         outProps.push_back(Property(DatumType::Bool, "Replicate Transform", this, &mReplicateTransform));
         outProps.push_back(Property(DatumType::Bool, "Always Relevant", this, &mAlwaysRelevant));
-        outProps.push_back(Property(DatumType::String, "Tags", this, &mTags).MakeVector());
+        outProps.push_back(Property(DatumType::Float, "Net Priority", this, &mNetPriority));
+        outProps.push_back(Property(DatumType::String, "Tags", this, &mTags, 1, HandlePropChange).MakeVector());
     }
 
     {
@@ -740,27 +751,86 @@ void Node::EmitSignal(const std::string& name, const std::vector<Datum>& args)
 {
     if (mSignalMap.size() > 0)
     {
-        auto it = mSignalMap.find(name);
-        if (it != mSignalMap.end())
-        {
-            it->second.Emit(args);
-        }
+        EmitSignal(FindSignal(name), args.data(), (uint32_t)args.size());
     }
 }
 
 void Node::ConnectSignal(const std::string& name, Node* listener, SignalHandlerFP func)
 {
-    mSignalMap[name].Connect(listener, func);
+    ConnectSignal(InternSignal(name), listener, func);
+}
+
+void Node::ConnectSignal(const std::string& name, Node* listener, LegacySignalHandlerFP func)
+{
+    ConnectSignal(InternSignal(name), listener, func);
 }
 
 void Node::ConnectSignal(const std::string& name, Node* listener, const ScriptFunc& func)
 {
-    mSignalMap[name].Connect(listener, func);
+    ConnectSignal(InternSignal(name), listener, func);
 }
 
 void Node::DisconnectSignal(const std::string& name, Node* listener)
 {
-    mSignalMap[name].Disconnect(listener);
+    DisconnectSignal(FindSignal(name), listener);
+}
+
+void Node::EmitSignal(SignalId id, std::initializer_list<Datum> args)
+{
+    EmitSignal(id, args.begin(), (uint32_t)args.size());
+}
+
+void Node::EmitSignal(SignalId id, const Datum* args, uint32_t numArgs)
+{
+    // Handlers can run arbitrary code (including scripts), so signals are main thread only.
+    OCT_ASSERT(!World::IsParallelTickThread());
+
+    if (mSignalMap.size() > 0)
+    {
+        auto it = mSignalMap.find(id);
+        if (it != mSignalMap.end())
+        {
+            it->second.Emit(args, numArgs);
+        }
+    }
+}
+
+bool Node::HasSignalConnections(SignalId id) const
+{
+    if (mSignalMap.size() > 0)
+    {
+        auto it = mSignalMap.find(id);
+        if (it != mSignalMap.end())
+        {
+            return it->second.HasConnections();
+        }
+    }
+
+    return false;
+}
+
+void Node::ConnectSignal(SignalId id, Node* listener, SignalHandlerFP func)
+{
+    mSignalMap[id].Connect(listener, func);
+}
+
+void Node::ConnectSignal(SignalId id, Node* listener, LegacySignalHandlerFP func)
+{
+    mSignalMap[id].Connect(listener, func);
+}
+
+void Node::ConnectSignal(SignalId id, Node* listener, const ScriptFunc& func)
+{
+    mSignalMap[id].Connect(listener, func);
+}
+
+void Node::DisconnectSignal(SignalId id, Node* listener)
+{
+    auto it = mSignalMap.find(id);
+    if (it != mSignalMap.end())
+    {
+        it->second.Disconnect(listener);
+    }
 }
 
 void Node::RenderShadow()
@@ -1240,7 +1310,27 @@ bool Node::IsAlwaysRelevant() const
 
 void Node::SetAlwaysRelevant(bool alwaysRelevant)
 {
-    mAlwaysRelevant = alwaysRelevant;
+    if (mAlwaysRelevant != alwaysRelevant)
+    {
+        mAlwaysRelevant = alwaysRelevant;
+        NetworkManager::Get()->UpdateRelevancyGridEntry(this);
+    }
+}
+
+float Node::GetNetPriorityScale(Node* playerNode)
+{
+    // Node3D will override this to scale by distance to the player
+    return 1.0f;
+}
+
+float Node::GetNetPriority() const
+{
+    return mNetPriority;
+}
+
+void Node::SetNetPriority(float priority)
+{
+    mNetPriority = glm::max(priority, 0.0f);
 }
 
 bool Node::HasTag(const std::string& tag)
@@ -1264,6 +1354,7 @@ void Node::AddTag(const std::string& tag)
     if (!HasTag(tag))
     {
         mTags.push_back(tag);
+        UpdateTagIndex();
     }
 }
 
@@ -1274,11 +1365,50 @@ void Node::RemoveTag(const std::string& tag)
         if (mTags[i] == tag)
         {
             mTags.erase(mTags.begin() + i);
+            UpdateTagIndex();
             break;
         }
     }
 }
 
+void Node::UpdateTagIndex()
+{
+    if (mWorld == nullptr)
+        return;
+
+    // Tags are only a handful of strings per node, so linear scans are fine here.
+    for (int32_t i = int32_t(mIndexedTags.size()) - 1; i >= 0; --i)
+    {
+        if (!HasTag(mIndexedTags[i]))
+        {
+            mWorld->RemoveFromTagIndex(this, mIndexedTags[i]);
+            mIndexedTags.erase(mIndexedTags.begin() + i);
+        }
+    }
+
+    for (uint32_t i = 0; i < mTags.size(); ++i)
+    {
+        if (std::find(mIndexedTags.begin(), mIndexedTags.end(), mTags[i]) == mIndexedTags.end())
+        {
+            mWorld->AddToTagIndex(this, mTags[i]);
+            mIndexedTags.push_back(mTags[i]);
+        }
+    }
+}
+
+void Node::ClearTagIndex()
+{
+    if (mWorld != nullptr)
+    {
+        for (uint32_t i = 0; i < mIndexedTags.size(); ++i)
+        {
+            mWorld->RemoveFromTagIndex(this, mIndexedTags[i]);
+        }
+    }
+
+    mIndexedTags.clear();
+}
+
 void Node::SetName(const std::string& newName)
 {
     if (mName != newName)
@@ -1290,6 +1420,11 @@ void Node::SetName(const std::string& newName)
             OCT_ASSERT(elemRemoved == 1);
         }
 
+        if (mWorld != nullptr)
+        {
+            mWorld->RemoveFromNameIndex(this, mName);
+        }
+
         mName = newName;
 
         if (mParent != nullptr)
@@ -1297,6 +1432,12 @@ void Node::SetName(const std::string& newName)
             mParent->ValidateUniqueChildName(this);
             mParent->mChildNameMap.insert({ mName, this });
         }
+
+        // Index the final name, after any uniqueness renaming.
+        if (mWorld != nullptr)
+        {
+            mWorld->AddToNameIndex(this, mName);
+        }
     }
 }
 
@@ -1753,6 +1894,16 @@ int32_t Node::FindParentNodeIndex() const
     return retIndex;
 }
 
+void Node::SetTreeOrder(uint32_t order)
+{
+    mTreeOrder = order;
+}
+
+uint32_t Node::GetTreeOrder() const
+{
+    return mTreeOrder;
+}
+
 void Node::SetHitCheckId(uint32_t id)
 {
 #if EDITOR
@@ -1779,6 +1930,18 @@ void Node::EnableLateTick(bool enable)
     mLateTick = enable;
 }
 
+bool Node::IsParallelTickSafe() const
+{
+    return false;
+}
+
+bool Node::CanTickInParallel() const
+{
+    return IsParallelTickSafe() &&
+        mScript == nullptr &&
+        !mLateTick;
+}
+
 Script* Node::GetScript()
 {
     return mScript;
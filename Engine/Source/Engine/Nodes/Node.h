@@ -120,9 +120,18 @@ public:
 
     void EmitSignal(const std::string& name, const std::vector<Datum>& args);
     void ConnectSignal(const std::string& name, Node* listener, SignalHandlerFP func);
+    void ConnectSignal(const std::string& name, Node* listener, LegacySignalHandlerFP func);
     void ConnectSignal(const std::string& name, Node* listener, const ScriptFunc& func);
     void DisconnectSignal(const std::string& name, Node* listener);
 
+    void EmitSignal(SignalId id, std::initializer_list<Datum> args);
+    void EmitSignal(SignalId id, const Datum* args, uint32_t numArgs);
+    bool HasSignalConnections(SignalId id) const;
+    void ConnectSignal(SignalId id, Node* listener, SignalHandlerFP func);
+    void ConnectSignal(SignalId id, Node* listener, LegacySignalHandlerFP func);
+    void ConnectSignal(SignalId id, Node* listener, const ScriptFunc& func);
+    void DisconnectSignal(SignalId id, Node* listener);
+
     void RenderShadow();
     void RenderSelected(bool renderChildren);
 
@@ -201,10 +210,19 @@ public:
     bool IsAlwaysRelevant() const;
     void SetAlwaysRelevant(bool alwaysRelevant);
 
+    // Used when the network bandwidth budget is enabled to decide which nodes replicate first.
+    virtual float GetNetPriorityScale(Node* playerNode);
+    float GetNetPriority() const;
+    void SetNetPriority(float priority);
+
     bool HasTag(const std::string& tag);
     void AddTag(const std::string& tag);
     void RemoveTag(const std::string& tag);
 
+    // Syncs the world's tag index with mTags. Called by the world on register/unregister.
+    void UpdateTagIndex();
+    void ClearTagIndex();
+
     void SetName(const std::string& newName);
     const std::string& GetName() const;
     virtual void SetActive(bool active);
@@ -267,9 +285,26 @@ public:
     void SetHitCheckId(uint32_t id);
     uint32_t GetHitCheckId() const;
 
+    // Position in a depth-first walk of the world's tree. Only kept up to date by World for its lookups.
+    void SetTreeOrder(uint32_t order);
+    uint32_t GetTreeOrder() const;
+
     bool IsLateTickEnabled() const;
     void EnableLateTick(bool enable);
 
+    // Native node types opt in to ticking on a worker thread by overriding IsParallelTickSafe().
+    // The result must not change while the node is in a world. A parallel-safe Tick() may:
+    // - read and write its own members and those of its own children,
+    // - set local position/rotation/scale (which only marks the transform dirty and queues it),
+    // - read world transforms of nodes it hasn't moved this tick (they are flushed beforehand).
+    // It must not create, destroy or reparent nodes, emit signals, call into scripts, resolve
+    // a dirty world transform (e.g. GetWorldPosition() after SetPosition()), set a world transform,
+    // or touch rigid bodies. Those assert that they aren't on a parallel tick thread.
+    // CanTickInParallel() adds the per-node conditions, e.g. nodes with a script or late tick
+    // always tick on the main thread.
+    virtual bool IsParallelTickSafe() const;
+    virtual bool CanTickInParallel() const;
+
     Script* GetScript();
     void SetScriptFile(const std::string& fileName);
 
@@ -446,9 +481,10 @@ protected:
     NodePtrWeak mSelf;
     std::vector<NodePtr> mChildren;
     std::unordered_map<std::string, Node*> mChildNameMap;
-    std::unordered_map<std::string, Signal> mSignalMap;
+    std::unordered_map<SignalId, Signal> mSignalMap;
     std::string mScriptFile;
     uint32_t mLastTickedFrame = 0;
+    uint32_t mTreeOrder = 0;
     bool mActive = true;
     bool mVisible = true;
     bool mTransient = false;
@@ -464,6 +500,7 @@ protected:
     // Merged from Actor
     SceneRef mScene;
     std::vector<std::string> mTags;
+    std::vector<std::string> mIndexedTags; // Tags currently in the world's tag index
     NodeId mNodeId = INVALID_NODE_ID;
 
     // Network Data
@@ -477,6 +514,7 @@ protected:
     bool mReplicateTransform = false;
     bool mForceReplicate = false;
     bool mAlwaysRelevant = true;
+    float mNetPriority = 1.0f;
 
     Script* mScript = nullptr;
     //NodeNetData* mNetData = nullptr;
@@ -21,6 +21,9 @@ bool Button::sHandleMouseInput = true;
 bool Button::sHandleGamepadInput = true;
 bool Button::sHandleKeyboardInput = true;
 
+static const SignalId sStateChangedSignal = InternSignal("StateChanged");
+static const SignalId sActivatedSignal = InternSignal("Activated");
+
 Button* Button::GetSelectedButton()
 {
     return sSelectedButton.Get();
@@ -356,7 +359,11 @@ void Button::SetState(ButtonState newState)
 
         if (!IsDestroyed())
         {
-            EmitSignal("StateChanged", { this });
+            if (HasSignalConnections(sStateChangedSignal))
+            {
+                EmitSignal(sStateChangedSignal, { this });
+            }
+
             CallFunction("OnStateChanged", { this });
         }
     }
@@ -571,6 +578,10 @@ Quad* Button::GetQuad()
 
 void Button::Activate()
 {
-    EmitSignal("Activated", { this });
+    if (HasSignalConnections(sActivatedSignal))
+    {
+        EmitSignal(sActivatedSignal, { this });
+    }
+
     CallFunction("OnActivated", { this });
 }
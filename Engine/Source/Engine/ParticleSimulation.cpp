@@ -0,0 +1,437 @@
+#include "ParticleSimulation.h"
+#include "Nodes/3D/Particle3d.h"
+#include "Assets/ParticleSystem.h"
+#include "Assets/ParticleSystemInstance.h"
+#include "World.h"
+#include "Engine.h"
+#include "JobSystem.h"
+#include "Log.h"
+#include "Assertion.h"
+
+#include "System/System.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#if SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// The SIMD kernel treats the vec3 arrays as flat float arrays.
+static_assert(sizeof(glm::vec3) == sizeof(float) * 3, "Particle kernels expect tightly packed vec3s");
+
+uint32_t ParticleArrays::GetCount() const
+{
+    return uint32_t(mPositions.size());
+}
+
+void ParticleArrays::Add(const Particle& particle)
+{
+    mPositions.push_back(particle.mPosition);
+    mVelocities.push_back(particle.mVelocity);
+    mSizes.push_back(particle.mSize);
+    mElapsedTimes.push_back(particle.mElapsedTime);
+    mLifetimes.push_back(particle.mLifetime);
+    mRotations.push_back(particle.mRotation);
+    mRotationSpeeds.push_back(particle.mRotationSpeed);
+}
+
+void ParticleArrays::Remove(uint32_t index)
+{
+    OCT_ASSERT(index < GetCount());
+    uint32_t last = GetCount() - 1;
+
+    if (index != last)
+    {
+        mPositions[index] = mPositions[last];
+        mVelocities[index] = mVelocities[last];
+        mSizes[index] = mSizes[last];
+        mElapsedTimes[index] = mElapsedTimes[last];
+        mLifetimes[index] = mLifetimes[last];
+        mRotations[index] = mRotations[last];
+        mRotationSpeeds[index] = mRotationSpeeds[last];
+    }
+
+    mPositions.pop_back();
+    mVelocities.pop_back();
+    mSizes.pop_back();
+    mElapsedTimes.pop_back();
+    mLifetimes.pop_back();
+    mRotations.pop_back();
+    mRotationSpeeds.pop_back();
+}
+
+Particle ParticleArrays::Get(uint32_t index) const
+{
+    OCT_ASSERT(index < GetCount());
+
+    Particle particle;
+    particle.mPosition = mPositions[index];
+    particle.mVelocity = mVelocities[index];
+    particle.mSize = mSizes[index];
+    particle.mElapsedTime = mElapsedTimes[index];
+    particle.mLifetime = mLifetimes[index];
+    particle.mRotation = mRotations[index];
+    particle.mRotationSpeed = mRotationSpeeds[index];
+    return particle;
+}
+
+void ParticleArrays::Reserve(uint32_t count)
+{
+    mPositions.reserve(count);
+    mVelocities.reserve(count);
+    mSizes.reserve(count);
+    mElapsedTimes.reserve(count);
+    mLifetimes.reserve(count);
+    mRotations.reserve(count);
+    mRotationSpeeds.reserve(count);
+}
+
+void ParticleArrays::Clear()
+{
+    mPositions.clear();
+    mVelocities.clear();
+    mSizes.clear();
+    mElapsedTimes.clear();
+    mLifetimes.clear();
+    mRotations.clear();
+    mRotationSpeeds.clear();
+}
+
+void ParticleArrays::ShrinkToFit()
+{
+    mPositions.shrink_to_fit();
+    mVelocities.shrink_to_fit();
+    mSizes.shrink_to_fit();
+    mElapsedTimes.shrink_to_fit();
+    mLifetimes.shrink_to_fit();
+    mRotations.shrink_to_fit();
+    mRotationSpeeds.shrink_to_fit();
+}
+
+static void IntegrateParticlesScalar(ParticleArrays& particles, const glm::vec3& acceleration, float deltaTime, uint32_t start, uint32_t end)
+{
+    const glm::vec3 deltaVelocity = acceleration * deltaTime;
+
+    for (uint32_t i = start; i < end; ++i)
+    {
+        particles.mElapsedTimes[i] += deltaTime;
+        particles.mVelocities[i] += deltaVelocity;
+        particles.mPositions[i] += (particles.mVelocities[i] * deltaTime);
+        particles.mRotations[i] += (particles.mRotationSpeeds[i] * deltaTime);
+    }
+}
+
+#if SIMD_SSE
+// Returns the number of particles integrated, always a multiple of 4.
+static uint32_t IntegrateParticlesSse(ParticleArrays& particles, const glm::vec3& acceleration, float deltaTime)
+{
+    const uint32_t count = particles.GetCount() & ~3u;
+    const glm::vec3 dv = acceleration * deltaTime;
+    const __m128 dt = _mm_set1_ps(deltaTime);
+
+    // 4 particles are 12 floats (3 registers) of xyz data, so the per-axis
+    // velocity delta repeats with a period of 3 registers.
+    const __m128 dv0 = _mm_setr_ps(dv.x, dv.y, dv.z, dv.x);
+    const __m128 dv1 = _mm_setr_ps(dv.y, dv.z, dv.x, dv.y);
+    const __m128 dv2 = _mm_setr_ps(dv.z, dv.x, dv.y, dv.z);
+
+    float* positions = &particles.mPositions[0].x;
+    float* velocities = &particles.mVelocities[0].x;
+
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        float* pos = positions + i * 3;
+        float* vel = velocities + i * 3;
+
+        __m128 v0 = _mm_add_ps(_mm_loadu_ps(vel + 0), dv0);
+        __m128 v1 = _mm_add_ps(_mm_loadu_ps(vel + 4), dv1);
+        __m128 v2 = _mm_add_ps(_mm_loadu_ps(vel + 8), dv2);
+        _mm_storeu_ps(vel + 0, v0);
+        _mm_storeu_ps(vel + 4, v1);
+        _mm_storeu_ps(vel + 8, v2);
+
+        _mm_storeu_ps(pos + 0, _mm_add_ps(_mm_loadu_ps(pos + 0), _mm_mul_ps(v0, dt)));
+        _mm_storeu_ps(pos + 4, _mm_add_ps(_mm_loadu_ps(pos + 4), _mm_mul_ps(v1, dt)));
+        _mm_storeu_ps(pos + 8, _mm_add_ps(_mm_loadu_ps(pos + 8), _mm_mul_ps(v2, dt)));
+    }
+
+    float* elapsedTimes = particles.mElapsedTimes.data();
+    float* rotations = particles.mRotations.data();
+    const float* rotationSpeeds = particles.mRotationSpeeds.data();
+
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        _mm_storeu_ps(elapsedTimes + i, _mm_add_ps(_mm_loadu_ps(elapsedTimes + i), dt));
+        _mm_storeu_ps(rotations + i, _mm_add_ps(_mm_loadu_ps(rotations + i), _mm_mul_ps(_mm_loadu_ps(rotationSpeeds + i), dt)));
+    }
+
+    return count;
+}
+#endif
+
+void IntegrateParticles(ParticleArrays& particles, const glm::vec3& acceleration, float deltaTime, bool allowSimd)
+{
+    uint32_t count = particles.GetCount();
+    uint32_t done = 0;
+
+#if SIMD_SSE
+    if (allowSimd && count > 0)
+    {
+        done = IntegrateParticlesSse(particles, acceleration, deltaTime);
+    }
+#endif
+
+    IntegrateParticlesScalar(particles, acceleration, deltaTime, done, count);
+}
+
+void BuildParticleVertices(const ParticleArrays& particles, const ParticleVertexParams& params, uint32_t start, uint32_t end, VertexParticle* outVertices)
+{
+    const ParticleParams& sysParams = *params.mParams;
+
+    const float alphaEase = sysParams.mAlphaEase;
+    const float scaleEase = sysParams.mScaleEase;
+
+    const float invAlphaEase2 = (alphaEase != 0.0f) ? (0.5f / alphaEase) : 1.0f;
+    const float invScaleEase2 = (scaleEase != 0.0f) ? (0.5f / scaleEase) : 1.0f;
+
+    // Color scale and the conversion to 0-255 are folded into the start/end colors.
+    const float colorScale = params.mInvColorScale * 255.0f;
+    const glm::vec4 colorStart = sysParams.mColorStart * colorScale;
+    const glm::vec4 colorDelta = (sysParams.mColorEnd * colorScale) - colorStart;
+    const glm::vec2 scaleStart = sysParams.mScaleStart * 0.5f;
+    const glm::vec2 scaleDelta = (sysParams.mScaleEnd * 0.5f) - scaleStart;
+
+    const glm::vec3* positions = particles.mPositions.data();
+    const glm::vec2* sizes = particles.mSizes.data();
+    const float* elapsedTimes = particles.mElapsedTimes.data();
+    const float* lifetimes = particles.mLifetimes.data();
+    const float* rotations = particles.mRotations.data();
+
+    for (uint32_t i = start; i < end; ++i)
+    {
+        VertexParticle* verts = outVertices + i * 4;
+
+        float life = elapsedTimes[i] / lifetimes[i];
+
+        glm::vec2 halfScale = scaleStart + scaleDelta * life;
+        glm::vec4 color = colorStart + colorDelta * life;
+
+        float easeX = 2 * fabsf(life - 0.5f);
+
+        if (scaleEase > 0.0f)
+        {
+            halfScale *= glm::clamp(invScaleEase2 * (1.0f - easeX), 0.0f, 1.0f);
+        }
+
+        if (alphaEase > 0.0f)
+        {
+            color.a *= glm::clamp(invAlphaEase2 * (1.0f - easeX), 0.0f, 1.0f);
+        }
+
+        color = glm::clamp(color, 0.0f, 255.0f);
+        uint32_t color32 =
+            (uint32_t(uint8_t(color.r))) |
+            (uint32_t(uint8_t(color.g)) << 8) |
+            (uint32_t(uint8_t(color.b)) << 16) |
+            (uint32_t(uint8_t(color.a)) << 24);
+
+        float sinRot = sinf(rotations[i]);
+        float cosRot = cosf(rotations[i]);
+        glm::vec2 halfSize = sizes[i] * halfScale;
+        glm::vec3 rightAxis = ((params.mRight * cosRot) + (params.mRightPerp * sinRot)) * halfSize.x;
+        glm::vec3 upAxis = ((params.mUp * cosRot) + (params.mUpPerp * sinRot)) * halfSize.y;
+        const glm::vec3& pos = positions[i];
+
+        //   0----2
+        //   |  / |
+        //   | /  |
+        //   1----3
+        verts[0].mPosition = pos - rightAxis + upAxis;
+        verts[0].mTexcoord = glm::vec2(0.0f, 0.0f);
+        verts[0].mColor = color32;
+
+        verts[1].mPosition = pos - rightAxis - upAxis;
+        verts[1].mTexcoord = glm::vec2(0.0f, 1.0f);
+        verts[1].mColor = color32;
+
+        verts[2].mPosition = pos + rightAxis + upAxis;
+        verts[2].mTexcoord = glm::vec2(1.0f, 0.0f);
+        verts[2].mColor = color32;
+
+        verts[3].mPosition = pos + rightAxis - upAxis;
+        verts[3].mTexcoord = glm::vec2(1.0f, 1.0f);
+        verts[3].mColor = color32;
+    }
+}
+
+static float MeasureIntegrateMs(const ParticleArrays& source, const glm::vec3& acceleration, float deltaTime, uint32_t frames, bool allowSimd)
+{
+    // Each pass starts from the same particles so the kernels see identical data.
+    ParticleArrays particles = source;
+
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        IntegrateParticles(particles, acceleration, deltaTime, allowSimd);
+    }
+
+    uint64_t elapsedUs = SYS_GetTimeMicroseconds() - startTime;
+    return float(elapsedUs) / 1000.0f / frames;
+}
+
+void RunParticleBenchmark(uint32_t numParticles, uint32_t frames, uint32_t numEmitters)
+{
+    const float kDeltaTime = 1.0f / 60.0f;
+
+    numEmitters = glm::max<uint32_t>(numEmitters, 1);
+    numParticles = glm::max<uint32_t>(numParticles, numEmitters);
+    frames = glm::max<uint32_t>(frames, 1);
+
+    World* world = GetWorld(0);
+
+    if (world == nullptr)
+    {
+        LogError("Particle benchmark needs a world");
+        return;
+    }
+
+    // Fixed seed so that runs are comparable.
+    Maths::SeedRand(1);
+
+    // Everything spawns in the first frame, then the spawn rate replaces particles
+    // as they expire so each emitter stays near capacity with constant turnover.
+    uint32_t particlesPerEmitter = numParticles / numEmitters;
+
+    ParticleSystemInstance* system = ParticleSystemInstance::New(nullptr);
+    ParticleParams& params = system->GetParams();
+    params.mLifetimeMin = 1.0f;
+    params.mLifetimeMax = 3.0f;
+    params.mPositionMin = glm::vec3(-20.0f, 0.0f, -20.0f);
+    params.mPositionMax = glm::vec3(20.0f, 2.0f, 20.0f);
+    params.mVelocityMin = glm::vec3(-1.0f, 2.0f, -1.0f);
+    params.mVelocityMax = glm::vec3(1.0f, 6.0f, 1.0f);
+    params.mRotationSpeedMin = -2.0f;
+    params.mRotationSpeedMax = 2.0f;
+    params.mAcceleration = glm::vec3(0.0f, -9.8f, 0.0f);
+    params.mScaleEase = 0.1f;
+    system->SetDuration(0.0f);
+    system->SetSpawnRate(float(particlesPerEmitter) / 2.0f);
+    system->SetBurstCount(particlesPerEmitter);
+    system->SetBurstWindow(kDeltaTime);
+    system->SetMaxParticles(particlesPerEmitter);
+
+    std::vector<Particle3D*> emitters;
+
+    for (uint32_t i = 0; i < numEmitters; ++i)
+    {
+        Particle3D* particle = world->SpawnNode<Particle3D>();
+        particle->SetName("ParticleBench");
+        particle->SetParticleSystem(system);
+        particle->SetParticleOrientation(ParticleOrientation::Z);
+        particle->EnableEmission(true);
+        emitters.push_back(particle);
+    }
+
+    // First pass updates the emitters one after another on this thread, timing the
+    // simulation and vertex building separately. The second pass goes through
+    // Particle3D::UpdateEmitters() like the renderer does.
+    uint64_t simulateUs = 0;
+    uint64_t verticesUs = 0;
+    uint64_t parallelUs = 0;
+    uint64_t totalParticles = 0;
+
+    for (uint32_t i = 0; i < frames * 2; ++i)
+    {
+        // Resets the once-per-frame guards on simulation and vertex updates.
+        for (uint32_t e = 0; e < numEmitters; ++e)
+        {
+            emitters[e]->Tick(kDeltaTime);
+            emitters[e]->SetInView(true);
+        }
+
+        if (i < frames)
+        {
+            for (uint32_t e = 0; e < numEmitters; ++e)
+            {
+                uint64_t startTime = SYS_GetTimeMicroseconds();
+                emitters[e]->Simulate(kDeltaTime);
+                uint64_t simulatedTime = SYS_GetTimeMicroseconds();
+                emitters[e]->UpdateVertexBuffer();
+                uint64_t endTime = SYS_GetTimeMicroseconds();
+
+                simulateUs += (simulatedTime - startTime);
+                verticesUs += (endTime - simulatedTime);
+                totalParticles += emitters[e]->GetNumParticles();
+            }
+        }
+        else
+        {
+            uint64_t startTime = SYS_GetTimeMicroseconds();
+            Particle3D::UpdateEmitters(emitters, kDeltaTime);
+            parallelUs += (SYS_GetTimeMicroseconds() - startTime);
+        }
+    }
+
+    // Integration kernel alone over every particle in one array, scalar vs SSE.
+    ParticleArrays integrateParticles;
+    integrateParticles.Reserve(particlesPerEmitter * numEmitters);
+
+    for (uint32_t i = 0; i < particlesPerEmitter * numEmitters; ++i)
+    {
+        Particle particle;
+        particle.mPosition = Maths::RandRange(params.mPositionMin, params.mPositionMax);
+        particle.mVelocity = Maths::RandRange(params.mVelocityMin, params.mVelocityMax);
+        particle.mLifetime = Maths::RandRange(params.mLifetimeMin, params.mLifetimeMax);
+        particle.mRotationSpeed = Maths::RandRange(params.mRotationSpeedMin, params.mRotationSpeedMax);
+        integrateParticles.Add(particle);
+    }
+
+    // Warm up the caches.
+    MeasureIntegrateMs(integrateParticles, params.mAcceleration, kDeltaTime, 1, true);
+
+    float integrateScalarMs = MeasureIntegrateMs(integrateParticles, params.mAcceleration, kDeltaTime, frames, false);
+    float integrateSimdMs = MeasureIntegrateMs(integrateParticles, params.mAcceleration, kDeltaTime, frames, true);
+
+    for (uint32_t e = 0; e < numEmitters; ++e)
+    {
+        emitters[e]->Doom();
+    }
+
+    JobSystem* jobSystem = JobSystem::Get();
+    uint32_t numWorkers = (jobSystem != nullptr) ? jobSystem->GetNumWorkers() : 0;
+
+    float simulateMs = float(simulateUs) / 1000.0f / frames;
+    float verticesMs = float(verticesUs) / 1000.0f / frames;
+    float parallelMs = float(parallelUs) / 1000.0f / frames;
+    float avgParticles = float(totalParticles) / frames;
+
+    LogDebug("---- Particle Benchmark (%u max particles, %u emitters, %u frames, %u workers, SSE %s) ----",
+        particlesPerEmitter * numEmitters, numEmitters, frames, numWorkers, SIMD_SSE ? "on" : "off");
+    LogDebug("Avg particles: %.0f  Simulate: %.3f ms/frame  Vertices: %.3f ms/frame  Parallel update: %.3f ms/frame",
+        avgParticles, simulateMs, verticesMs, parallelMs);
+    LogDebug("Integrate scalar: %.3f ms/frame  Integrate SIMD: %.3f ms/frame", integrateScalarMs, integrateSimdMs);
+
+    FILE* benchFile = fopen("ParticleBench.csv", "w");
+
+    if (benchFile != nullptr)
+    {
+        fprintf(benchFile, "MaxParticles, %u\n", particlesPerEmitter * numEmitters);
+        fprintf(benchFile, "Emitters, %u\n", numEmitters);
+        fprintf(benchFile, "Frames, %u\n", frames);
+        fprintf(benchFile, "Workers, %u\n", numWorkers);
+        fprintf(benchFile, "Sse, %d\n", SIMD_SSE);
+        fprintf(benchFile, "AvgParticles, %f\n", avgParticles);
+        fprintf(benchFile, "SimulateMsPerFrame, %f\n", simulateMs);
+        fprintf(benchFile, "VerticesMsPerFrame, %f\n", verticesMs);
+        fprintf(benchFile, "ParallelUpdateMsPerFrame, %f\n", parallelMs);
+        fprintf(benchFile, "IntegrateScalarMsPerFrame, %f\n", integrateScalarMs);
+        fprintf(benchFile, "IntegrateSimdMsPerFrame, %f\n", integrateSimdMs);
+        fclose(benchFile);
+    }
+    else
+    {
+        LogError("Failed to write ParticleBench.csv");
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "Constants.h"
+#include "Maths.h"
+#include "Vertex.h"
+
+struct ParticleParams;
+
+struct Particle
+{
+    glm::vec3 mPosition = {};
+    float mElapsedTime = 0.0f;
+
+    glm::vec3 mVelocity = {};
+    float mLifetime = 1.0f;
+
+    glm::vec2 mSize = {};
+    float mRotationSpeed = 0.0f;
+    float mRotation = 0.0f;
+};
+
+// Live particles of an emitter, stored as a structure of arrays so that each kernel only
+// streams through the fields it needs. Particles are removed by swapping the last one into
+// their slot, so the order of particles is not preserved.
+struct ParticleArrays
+{
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::vec3> mVelocities;
+    std::vector<glm::vec2> mSizes;
+    std::vector<float> mElapsedTimes;
+    std::vector<float> mLifetimes;
+    std::vector<float> mRotations;
+    std::vector<float> mRotationSpeeds;
+
+    uint32_t GetCount() const;
+    void Add(const Particle& particle);
+    void Remove(uint32_t index);
+    Particle Get(uint32_t index) const;
+    void Reserve(uint32_t count);
+    void Clear();
+    void ShrinkToFit();
+};
+
+// Per-frame inputs for building particle quads. The axes are the quad's right/up directions
+// and those same directions rotated 90 degrees around the facing axis, which lets each
+// particle's rotation be applied with a single sin/cos.
+struct ParticleVertexParams
+{
+    const ParticleParams* mParams = nullptr;
+    glm::vec3 mRight = { 1.0f, 0.0f, 0.0f };
+    glm::vec3 mUp = { 0.0f, 1.0f, 0.0f };
+    glm::vec3 mRightPerp = { 0.0f, 1.0f, 0.0f };
+    glm::vec3 mUpPerp = { -1.0f, 0.0f, 0.0f };
+    float mInvColorScale = 1.0f;
+};
+
+// Advances elapsed time, velocity, position and rotation of every particle.
+// Uses the SSE kernel when available unless allowSimd is false.
+void IntegrateParticles(ParticleArrays& particles, const glm::vec3& acceleration, float deltaTime, bool allowSimd = true);
+
+// Writes 4 vertices per particle for particles [start, end) starting at outVertices[start * 4].
+void BuildParticleVertices(const ParticleArrays& particles, const ParticleVertexParams& params, uint32_t start, uint32_t end, VertexParticle* outVertices);
+
+// Spreads numParticles live particles over numEmitters emitters and updates them for the
+// given number of frames, first serially and then across the job system. Also times the
+// integration kernel with and without SIMD. Logs the timings and writes them to ParticleBench.csv.
+void RunParticleBenchmark(uint32_t numParticles, uint32_t frames, uint32_t numEmitters);
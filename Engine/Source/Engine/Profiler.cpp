@@ -10,6 +10,34 @@
 
 static Profiler* sProfiler = nullptr;
 
+// Set on the thread that creates the profiler. Frame/persistent stats are only tracked on this thread.
+static thread_local bool sMainThread = false;
+static thread_local ThreadTrace* sThreadTrace = nullptr;
+
+static uint32_t HashStatName(const char* name)
+{
+    // FNV-1a over the same characters that are stored in the stat name buffer.
+    uint32_t hash = 2166136261u;
+
+    for (uint32_t i = 0; i < STAT_NAME_LENGTH && name[i] != 0; ++i)
+    {
+        hash ^= uint8_t(name[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+Profiler::~Profiler()
+{
+    for (uint32_t i = 0; i < mThreadTraces.size(); ++i)
+    {
+        delete mThreadTraces[i];
+    }
+
+    mThreadTraces.clear();
+}
+
 void Profiler::BeginFrame()
 {
 #if PROFILING_ENABLED
@@ -44,6 +72,14 @@ void Profiler::EndFrame()
 void Profiler::BeginCpuStat(const char* name, bool persistent)
 {
 #if PROFILING_ENABLED
+    if (mTraceEnabled)
+    {
+        BeginTraceScope();
+    }
+
+    if (!sMainThread)
+        return;
+
     CpuStat* stat = FindCpuStat(name, persistent);
 
     if (stat == nullptr)
@@ -51,16 +87,13 @@ void Profiler::BeginCpuStat(const char* name, bool persistent)
         CpuStat newStat;
         strncpy(newStat.mName, name, STAT_NAME_LENGTH);
 
-        if (persistent)
-        {
-            mCpuPersistentStats.push_back(newStat);
-            stat = &mCpuPersistentStats.back();
-        }
-        else
-        {
-            mCpuFrameStats.push_back(newStat);
-            stat = &mCpuFrameStats.back();
-        }
+        std::vector<CpuStat>& stats = persistent ? mCpuPersistentStats : mCpuFrameStats;
+        std::unordered_map<uint32_t, uint32_t>& statMap = persistent ? mCpuPersistentStatMap : mCpuFrameStatMap;
+
+        // On a hash collision, the first stat keeps the map entry and FindCpuStat() falls back to a search.
+        statMap.insert({ HashStatName(newStat.mName), (uint32_t)stats.size() });
+        stats.push_back(newStat);
+        stat = &stats.back();
     }
 
     stat->mStartTime = SYS_GetTimeMicroseconds();
@@ -70,6 +103,14 @@ void Profiler::BeginCpuStat(const char* name, bool persistent)
 void Profiler::EndCpuStat(const char* name, bool persistent)
 {
 #if PROFILING_ENABLED
+    if (mTraceEnabled)
+    {
+        EndTraceScope(name);
+    }
+
+    if (!sMainThread)
+        return;
+
     CpuStat* stat = FindCpuStat(name, persistent);
     OCT_ASSERT(stat);
 
@@ -123,15 +164,29 @@ void Profiler::SetGpuStatTime(const char* name, float time)
 CpuStat* Profiler::FindCpuStat(const char* name, bool persistent)
 {
     std::vector<CpuStat>& stats = persistent ? mCpuPersistentStats : mCpuFrameStats;
+    std::unordered_map<uint32_t, uint32_t>& statMap = persistent ? mCpuPersistentStatMap : mCpuFrameStatMap;
     CpuStat* retStat = nullptr;
 
 #if PROFILING_ENABLED
-    for (uint32_t i = 0; i < stats.size(); ++i)
+    auto it = statMap.find(HashStatName(name));
+
+    if (it != statMap.end())
     {
-        if (strncmp(stats[i].mName, name, STAT_NAME_LENGTH) == 0)
+        if (strncmp(stats[it->second].mName, name, STAT_NAME_LENGTH) == 0)
         {
-            retStat = &stats[i];
-            break;
+            retStat = &stats[it->second];
+        }
+        else
+        {
+            // Hash collision
+            for (uint32_t i = 0; i < stats.size(); ++i)
+            {
+                if (strncmp(stats[i].mName, name, STAT_NAME_LENGTH) == 0)
+                {
+                    retStat = &stats[i];
+                    break;
+                }
+            }
         }
     }
 #endif
@@ -182,11 +237,197 @@ void Profiler::DumpPersistentStats()
     }
 }
 
+void Profiler::EnableTrace(bool enable)
+{
+    if (enable && !mTraceEnabled)
+    {
+        // Scopes that were opened before this point are ignored when they end.
+        mTraceGeneration++;
+
+        std::lock_guard<std::mutex> lock(mThreadTraceMutex);
+        for (uint32_t i = 0; i < mThreadTraces.size(); ++i)
+        {
+            ThreadTrace* trace = mThreadTraces[i];
+            std::lock_guard<std::mutex> traceLock(trace->mMutex);
+            trace->mNextEvent = 0;
+            trace->mNumEvents = 0;
+        }
+    }
+
+    mTraceEnabled = enable;
+}
+
+bool Profiler::IsTraceEnabled() const
+{
+    return mTraceEnabled;
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadTrace* trace = GetThreadTrace();
+    std::lock_guard<std::mutex> lock(trace->mMutex);
+    trace->mName = name;
+}
+
+ThreadTrace* Profiler::GetThreadTrace()
+{
+    if (sThreadTrace == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mThreadTraceMutex);
+
+        ThreadTrace* trace = new ThreadTrace();
+        trace->mThreadIndex = (uint32_t)mThreadTraces.size();
+        trace->mName = sMainThread ? "Main" : ("Thread " + std::to_string(trace->mThreadIndex));
+        trace->mEvents.resize(TRACE_EVENT_CAPACITY);
+        mThreadTraces.push_back(trace);
+
+        sThreadTrace = trace;
+    }
+
+    return sThreadTrace;
+}
+
+void Profiler::BeginTraceScope()
+{
+    ThreadTrace* trace = GetThreadTrace();
+
+    uint32_t generation = mTraceGeneration;
+    if (trace->mGeneration != generation)
+    {
+        trace->mGeneration = generation;
+        trace->mDepth = 0;
+    }
+
+    if (trace->mDepth < TRACE_MAX_SCOPE_DEPTH)
+    {
+        trace->mScopeStartTimes[trace->mDepth] = SYS_GetTimeMicroseconds();
+    }
+
+    trace->mDepth++;
+}
+
+void Profiler::EndTraceScope(const char* name)
+{
+    ThreadTrace* trace = GetThreadTrace();
+
+    // Ignore scopes that began before tracing was (re)enabled.
+    if (trace->mGeneration != mTraceGeneration ||
+        trace->mDepth == 0)
+    {
+        return;
+    }
+
+    trace->mDepth--;
+
+    if (trace->mDepth < TRACE_MAX_SCOPE_DEPTH)
+    {
+        std::lock_guard<std::mutex> lock(trace->mMutex);
+
+        TraceEvent& event = trace->mEvents[trace->mNextEvent];
+        strncpy(event.mName, name, STAT_NAME_LENGTH);
+        event.mStartTime = trace->mScopeStartTimes[trace->mDepth];
+        event.mEndTime = SYS_GetTimeMicroseconds();
+        event.mDepth = trace->mDepth;
+
+        trace->mNextEvent = (trace->mNextEvent + 1) % TRACE_EVENT_CAPACITY;
+        trace->mNumEvents = glm::min<uint32_t>(trace->mNumEvents + 1, TRACE_EVENT_CAPACITY);
+    }
+}
+
+static void WriteJsonString(FILE* file, const char* str)
+{
+    fputc('"', file);
+
+    for (const char* c = str; *c != 0; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', file);
+            fputc(*c, file);
+        }
+        else if (uint8_t(*c) >= 0x20)
+        {
+            fputc(*c, file);
+        }
+    }
+
+    fputc('"', file);
+}
+
+bool Profiler::WriteTrace(const char* path)
+{
+    FILE* traceFile = fopen(path, "w");
+
+    if (traceFile == nullptr)
+    {
+        LogError("Failed to open trace file %s", path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mThreadTraceMutex);
+
+    // Offset timestamps so the trace starts near zero.
+    uint64_t baseTime = UINT64_MAX;
+    for (uint32_t t = 0; t < mThreadTraces.size(); ++t)
+    {
+        ThreadTrace* trace = mThreadTraces[t];
+        std::lock_guard<std::mutex> traceLock(trace->mMutex);
+
+        for (uint32_t i = 0; i < trace->mNumEvents; ++i)
+        {
+            baseTime = glm::min(baseTime, trace->mEvents[i].mStartTime);
+        }
+    }
+
+    if (baseTime == UINT64_MAX)
+    {
+        baseTime = 0;
+    }
+
+    fprintf(traceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool firstEvent = true;
+
+    for (uint32_t t = 0; t < mThreadTraces.size(); ++t)
+    {
+        ThreadTrace* trace = mThreadTraces[t];
+        std::lock_guard<std::mutex> traceLock(trace->mMutex);
+
+        fprintf(traceFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":",
+            firstEvent ? "" : ",\n", trace->mThreadIndex);
+        WriteJsonString(traceFile, trace->mName.c_str());
+        fprintf(traceFile, "}}");
+        firstEvent = false;
+
+        // Oldest event first
+        uint32_t firstIndex = (trace->mNextEvent + TRACE_EVENT_CAPACITY - trace->mNumEvents) % TRACE_EVENT_CAPACITY;
+
+        for (uint32_t i = 0; i < trace->mNumEvents; ++i)
+        {
+            const TraceEvent& event = trace->mEvents[(firstIndex + i) % TRACE_EVENT_CAPACITY];
+
+            fprintf(traceFile, ",\n{\"name\":");
+            WriteJsonString(traceFile, event.mName);
+            fprintf(traceFile, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%llu,\"dur\":%llu}",
+                trace->mThreadIndex,
+                (unsigned long long)(event.mStartTime - baseTime),
+                (unsigned long long)(event.mEndTime - event.mStartTime));
+        }
+    }
+
+    fprintf(traceFile, "\n]}\n");
+    fclose(traceFile);
+    traceFile = nullptr;
+
+    LogDebug("Wrote profiler trace to %s", path);
+    return true;
+}
+
 void CreateProfiler()
 {
 #if PROFILING_ENABLED
     if (sProfiler == nullptr)
     {
+        sMainThread = true;
         sProfiler = new Profiler();
     }
 #endif
@@ -2,14 +2,22 @@
 
 #include <stdint.h>
 #include <vector>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
 
 #include <string.h>
 
 #define PROFILING_ENABLED 1
 
-#define STAT_NAME_LENGTH 31
+#define STAT_NAME_LENGTH 63
 #define STAT_NAME_BUFFER_LENGTH (STAT_NAME_LENGTH + 1)
 
+// Number of completed scopes each thread keeps while tracing. Oldest events are overwritten.
+#define TRACE_EVENT_CAPACITY 16384
+#define TRACE_MAX_SCOPE_DEPTH 64
+
 struct CpuStat
 {
     char mName[STAT_NAME_BUFFER_LENGTH] = {};
@@ -26,10 +34,37 @@ struct GpuStat
     float mSmoothedTime = 0.0f;
 };
 
+struct TraceEvent
+{
+    char mName[STAT_NAME_BUFFER_LENGTH] = {};
+    uint64_t mStartTime = 0;
+    uint64_t mEndTime = 0;
+    uint32_t mDepth = 0;
+};
+
+// Per-thread ring buffer of completed scopes. Only the owning thread writes events,
+// the mutex is there so that the trace can be exported while other threads are running.
+struct ThreadTrace
+{
+    std::mutex mMutex;
+    std::string mName;
+    uint32_t mThreadIndex = 0;
+    uint32_t mGeneration = 0;
+    std::vector<TraceEvent> mEvents;
+    uint32_t mNextEvent = 0;
+    uint32_t mNumEvents = 0;
+    uint32_t mDepth = 0;
+    uint64_t mScopeStartTimes[TRACE_MAX_SCOPE_DEPTH] = {};
+};
+
+// Frame / persistent stats are only accumulated on the main thread. Every thread
+// records its nested scopes into its own trace buffer while tracing is enabled.
 class Profiler
 {
 public:
 
+    ~Profiler();
+
     void BeginFrame();
     void EndFrame();
 
@@ -49,11 +84,30 @@ public:
     void LogPersistentStats();
     void DumpPersistentStats();
 
+    void EnableTrace(bool enable);
+    bool IsTraceEnabled() const;
+    void SetThreadName(const char* name);
+
+    // Writes the recorded scopes of every thread in the Chrome trace event format,
+    // which can be opened in chrome://tracing or ui.perfetto.dev.
+    bool WriteTrace(const char* path);
+
 protected:
 
+    ThreadTrace* GetThreadTrace();
+    void BeginTraceScope();
+    void EndTraceScope(const char* name);
+
     std::vector<CpuStat> mCpuFrameStats;
     std::vector<CpuStat> mCpuPersistentStats;
     std::vector<GpuStat> mGpuStats;
+    std::unordered_map<uint32_t, uint32_t> mCpuFrameStatMap;
+    std::unordered_map<uint32_t, uint32_t> mCpuPersistentStatMap;
+
+    std::mutex mThreadTraceMutex;
+    std::vector<ThreadTrace*> mThreadTraces;
+    std::atomic<bool> mTraceEnabled{ false };
+    std::atomic<uint32_t> mTraceGeneration{ 0 };
 };
 
 void CreateProfiler();
@@ -62,9 +116,10 @@ Profiler* GetProfiler();
 
 struct ScopedCpuStat
 {
+    // The name must outlive the scope (string literals are the common case).
     ScopedCpuStat(const char* name, bool persistent)
     {
-        strncpy(mName, name, STAT_NAME_LENGTH);
+        mName = name;
         mPersistent = persistent;
         GetProfiler()->BeginCpuStat(mName, mPersistent);
     }
@@ -74,7 +129,7 @@ struct ScopedCpuStat
         GetProfiler()->EndCpuStat(mName, mPersistent);
     }
 
-    char mName[STAT_NAME_BUFFER_LENGTH] = {};
+    const char* mName = nullptr;
     bool mPersistent = false;
 };
 
@@ -37,6 +37,8 @@
 
 #include "Assertion.h"
 #include <stdlib.h>
+#include <algorithm>
+#include <unordered_set>
 #include <stdio.h>
 #include <vector>
 #include <set>
@@ -495,14 +497,15 @@ void Renderer::GatherDrawData(World* world)
     }
 #endif
 
-    mShadowDraws.clear();
-    mOpaqueDraws.clear();
-    mSimpleShadowDraws.clear();
-    mPostShadowOpaqueDraws.clear();
-    mTranslucentDraws.clear();
-    mWireframeDraws.clear();
+    mShadowDraws.Clear();
+    mOpaqueDraws.Clear();
+    mSimpleShadowDraws.Clear();
+    mPostShadowOpaqueDraws.Clear();
+    mTranslucentDraws.Clear();
+    mWireframeDraws.Clear();
     mCollisionDraws.clear();
-    mWidgetDraws.clear();
+    mWidgetDraws.Clear();
+    mParticleUpdates.clear();
 
     Camera3D* camera = world ? world->GetActiveCamera() : nullptr;
 
@@ -510,90 +513,225 @@ void Renderer::GatherDrawData(World* world)
     {
         glm::vec3 cameraPos = camera ? camera->GetWorldPosition() : glm::vec3(0.0f, 0.0f, 0.0f);
 
-        auto gatherDrawData = [&](Node* node) -> bool
+        auto isDistanceCulled = [&](Primitive3D* prim, DrawData& data) -> bool
         {
-            if (!node->IsVisible())
+            data.mDistance2 = glm::distance2(cameraPos, data.mBounds.mCenter);
+            const float cullDist = prim->GetCullDistance();
+            return (cullDist > 0.0f && data.mDistance2 > (cullDist * cullDist));
+        };
+
+        auto gatherPrimitive = [&](Primitive3D* prim, bool gatherShadow)
+        {
+            DrawData data = prim->GetDrawData();
+            data.mNodeType = prim->GetType();
+
+            bool simpleShadow = (data.mNodeType == ShadowMesh3D::GetStaticType());
+            bool distanceCulled = isDistanceCulled(prim, data);
+
+            if (data.mNode != nullptr &&
+                !distanceCulled)
+            {
+                Particle3D* particle = prim->As<Particle3D>();
+                if (particle != nullptr)
+                {
+                    particle->SetInView(true);
+                }
+
+                if (simpleShadow)
+                {
+                    mSimpleShadowDraws.Add(data);
+                }
+                else
+                {
+                    switch (data.mBlendMode)
+                    {
+                    case BlendMode::Opaque:
+                    case BlendMode::Masked:
+                        if (prim->ShouldReceiveSimpleShadows())
+                        {
+                            mOpaqueDraws.Add(data, DrawList::MakeOpaqueKey(data));
+                        }
+                        else
+                        {
+                            mPostShadowOpaqueDraws.Add(data, DrawList::MakeOpaqueKey(data));
+                        }
+                        break;
+                    case BlendMode::Translucent:
+                    case BlendMode::Additive:
+                        mTranslucentDraws.Add(data, DrawList::MakeTranslucentKey(data, glm::distance2(data.mPosition, cameraPos)));
+                        break;
+                    default:
+                        break;
+                    }
+
+                    if (gatherShadow && prim->ShouldCastShadows())
+                    {
+                        mShadowDraws.Add(data);
+                    }
+
+                    if (mDebugMode == DEBUG_WIREFRAME)
+                    {
+                        mWireframeDraws.Add(data);
+                    }
+                }
+            }
+        };
+
+        auto shouldGatherPrimitive = [&](Primitive3D* prim) -> bool
+        {
+            // Nodes gathered from the bounds tree weren't reached by walking down from the root,
+            // so we need to check the visibility of all of their ancestors.
+            if (!prim->IsVisible(true))
             {
-                // If this node is not visible, then return false so we don't
-                // traverse farther down the tree. Might have to add a new variable
-                // on Node if we want to tread child visibility independent of the parent.
                 return false;
             }
 
 #if EDITOR
             if (onlySelected &&
-                !GetEditorState()->IsNodeSelected(node))
+                !GetEditorState()->IsNodeSelected(prim))
             {
-                // Return true since a child may be selected
-                return true;
+                return false;
             }
 #endif
 
-            if (enable3D &&
-                camera != nullptr &&
-                node->IsPrimitive3D())
-            {
-                DrawData data = node->GetDrawData();
-                data.mNodeType = node->GetType();
-
-                Primitive3D* prim = (Primitive3D*)node;
-                bool simpleShadow = (data.mNodeType == ShadowMesh3D::GetStaticType());
+            return true;
+        };
 
-                bool distanceCulled = false;
-                data.mDistance2 = glm::distance2(cameraPos, data.mBounds.mCenter);
-                const float cullDist = prim ? prim->GetCullDistance() : 0.0f;
-                if (cullDist > 0.0f)
+        if (enable3D &&
+            camera != nullptr)
+        {
+            // Primitives are gathered from the world's bounds tree so that only primitives that
+            // can be in view are visited. Skeletal meshes and particles are kept out of the tree
+            // since they need to be updated by FrustumCull() even when they are out of view.
+            world->UpdatePrimitiveTree();
+
+            static std::vector<Node3D*> sTreeNodes;
+            sTreeNodes.clear();
+
+            // A caster outside the camera frustum can still shadow geometry that is in view,
+            // so when the frustum query is used, shadow casters get their own query against
+            // the volume covered by each shadow casting light's shadow map.
+            uint32_t numShadowLights = 0;
+            if (mFrustumCulling)
+            {
+                const std::vector<Light3D*>& dirLights = world->GetDirectionalLights();
+                for (uint32_t i = 0; i < dirLights.size(); ++i)
                 {
-                    const float cullDist2 = cullDist * cullDist;
-                    if (data.mDistance2 > cullDist2)
+                    if (dirLights[i]->ShouldCastShadows())
                     {
-                        distanceCulled = true;
+                        ++numShadowLights;
                     }
                 }
+            }
+
+            bool separateShadowPass = (numShadowLights > 0);
+
+            if (mFrustumCulling)
+            {
+                CameraFrustum frustum;
+                BuildCameraFrustum(camera, frustum);
+                world->GetPrimitiveTree().QueryFrustum(frustum, sTreeNodes);
+            }
+            else
+            {
+                world->GetPrimitiveTree().GatherAll(sTreeNodes);
+            }
+
+            for (uint32_t i = 0; i < sTreeNodes.size(); ++i)
+            {
+                Primitive3D* prim = static_cast<Primitive3D*>(sTreeNodes[i]);
+
+                if (shouldGatherPrimitive(prim))
+                {
+                    gatherPrimitive(prim, !separateShadowPass);
+                }
+            }
+
+            if (separateShadowPass)
+            {
+                sTreeNodes.clear();
 
-                if (data.mNode != nullptr &&
-                    !distanceCulled)
+                const std::vector<Light3D*>& dirLights = world->GetDirectionalLights();
+                for (uint32_t i = 0; i < dirLights.size(); ++i)
                 {
-                    if (simpleShadow)
+                    if (dirLights[i]->ShouldCastShadows())
                     {
-                        mSimpleShadowDraws.push_back(data);
+                        CameraFrustum shadowFrustum;
+                        BuildShadowFrustum(dirLights[i], camera, shadowFrustum);
+                        world->GetPrimitiveTree().QueryFrustum(shadowFrustum, sTreeNodes);
                     }
-                    else
-                    {
-                        switch (data.mBlendMode)
-                        {
-                        case BlendMode::Opaque:
-                        case BlendMode::Masked:
-                            if (prim->ShouldReceiveSimpleShadows())
-                            {
-                                mOpaqueDraws.push_back(data);
-                            }
-                            else
-                            {
-                                mPostShadowOpaqueDraws.push_back(data);
-                            }
-                            break;
-                        case BlendMode::Translucent:
-                        case BlendMode::Additive:
-                            mTranslucentDraws.push_back(data);
-                            break;
-                        default:
-                            break;
-                        }
+                }
 
-                        if (prim->ShouldCastShadows())
-                        {
-                            mShadowDraws.push_back(data);
-                        }
+                // Overlapping shadow volumes return the same caster more than once.
+                if (numShadowLights > 1)
+                {
+                    std::sort(sTreeNodes.begin(), sTreeNodes.end());
+                    sTreeNodes.erase(std::unique(sTreeNodes.begin(), sTreeNodes.end()), sTreeNodes.end());
+                }
+
+                for (uint32_t i = 0; i < sTreeNodes.size(); ++i)
+                {
+                    Primitive3D* prim = static_cast<Primitive3D*>(sTreeNodes[i]);
 
-                        if (mDebugMode == DEBUG_WIREFRAME)
+                    if (prim->ShouldCastShadows() &&
+                        prim->GetType() != ShadowMesh3D::GetStaticType() &&
+                        shouldGatherPrimitive(prim))
+                    {
+                        DrawData data = prim->GetDrawData();
+                        data.mNodeType = prim->GetType();
+
+                        if (data.mNode != nullptr &&
+                            !isDistanceCulled(prim, data))
                         {
-                            mWireframeDraws.push_back(data);
+                            mShadowDraws.Add(data);
                         }
                     }
                 }
             }
-            else if (enable2D && node->IsWidget())
+
+            const std::vector<SkeletalMesh3D*>& skeletalMeshes = world->GetSkeletalMeshes();
+            for (uint32_t i = 0; i < skeletalMeshes.size(); ++i)
+            {
+                if (shouldGatherPrimitive(skeletalMeshes[i]))
+                {
+                    gatherPrimitive(skeletalMeshes[i], true);
+                }
+            }
+
+            const std::vector<Particle3D*>& particles = world->GetParticles();
+            for (uint32_t i = 0; i < particles.size(); ++i)
+            {
+                if (shouldGatherPrimitive(particles[i]))
+                {
+                    // Distance and frustum culled emitters are still simulated later if they always simulate.
+                    particles[i]->SetInView(false);
+                    gatherPrimitive(particles[i], true);
+                    mParticleUpdates.push_back(particles[i]);
+                }
+            }
+        }
+
+        // Widgets and debug draws still need to walk the node tree, but only when there is something to gather.
+        auto gatherDrawData = [&](Node* node) -> bool
+        {
+            if (!node->IsVisible())
+            {
+                // If this node is not visible, then return false so we don't
+                // traverse farther down the tree. Might have to add a new variable
+                // on Node if we want to tread child visibility independent of the parent.
+                return false;
+            }
+
+#if EDITOR
+            if (onlySelected &&
+                !GetEditorState()->IsNodeSelected(node))
+            {
+                // Return true since a child may be selected
+                return true;
+            }
+#endif
+
+            if (enable2D && node->IsWidget())
             {
                 Widget* widget = (Widget*)node;
                 widget->PreRender();
@@ -604,7 +742,7 @@ void Renderer::GatherDrawData(World* world)
 
                 if (data.mNode != nullptr)
                 {
-                    mWidgetDraws.push_back(data);
+                    mWidgetDraws.Add(data);
                 }
             }
 
@@ -634,81 +772,40 @@ void Renderer::GatherDrawData(World* world)
             return true;
         };
 
-        if (world != nullptr)
-        {
-            if (world->GetRootNode() != nullptr)
-            {
-                world->GetRootNode()->Traverse(gatherDrawData);
-            }
-
-            // Need to render these widgets even if in 3D mode.
-            enable2D = true;
+        bool traverseWorld = (enable2D && world->GetNumWidgets() > 0);
 
-            if (mStatsWidget != nullptr && mStatsWidget->IsVisible()) { mStatsWidget->Traverse(gatherDrawData); }
-            if (mConsoleWidget != nullptr && mConsoleWidget->IsVisible()) { mConsoleWidget->Traverse(gatherDrawData); }
-
-#if EDITOR
-            // Kinda hacky but doing this to draw overlay text when in editor.
-            if (GetEditorState()->mOverlayText)
-            {
-                GetEditorState()->mOverlayText->Traverse(gatherDrawData);
-            }
+#if DEBUG_DRAW_ENABLED
+        traverseWorld = traverseWorld ||
+            mEnableProxyRendering ||
+            Spline3D::IsSplineLinesVisible() ||
+            mDebugMode == DEBUG_COLLISION;
 #endif
-        }
 
-        auto materialSort = [](const DrawData& l, const DrawData& r)
+        if (traverseWorld &&
+            world->GetRootNode() != nullptr)
         {
-            // Depthless materials should render last.
-            if (l.mDepthless != r.mDepthless)
-            {
-                return r.mDepthless;
-            }
-
-            // Sort by blend mode. Render opaque first, then masked.
-            if (l.mBlendMode != r.mBlendMode)
-            {
-                return l.mBlendMode > r.mBlendMode;
-            }
-
-            // Sort by material first (just use address)
-            if (l.mMaterial != r.mMaterial)
-            {
-                return l.mMaterial < r.mMaterial;
-            }
-
-            // Then sort by distance, render closer objects first to get
-            // more early depth testing kills.
-            return l.mDistance2 < r.mDistance2;
-        };
-
-        // Sort opaque draw and masked draws by material
-        std::sort(mOpaqueDraws.begin(),
-                    mOpaqueDraws.end(),
-                    materialSort);
+            world->GetRootNode()->Traverse(gatherDrawData);
+        }
 
-        std::sort(mPostShadowOpaqueDraws.begin(),
-                    mPostShadowOpaqueDraws.end(),
-                    materialSort);
+        // Need to render these widgets even if in 3D mode.
+        enable2D = true;
 
-        // Sort translucent draws by distance
-        std::sort(mTranslucentDraws.begin(), 
-                    mTranslucentDraws.end(),
-                    [cameraPos](const DrawData& l, const DrawData& r)
-                    {
-                        if (l.mDepthless != r.mDepthless)
-                        {
-                            return r.mDepthless;
-                        }
+        if (mStatsWidget != nullptr && mStatsWidget->IsVisible()) { mStatsWidget->Traverse(gatherDrawData); }
+        if (mConsoleWidget != nullptr && mConsoleWidget->IsVisible()) { mConsoleWidget->Traverse(gatherDrawData); }
 
-                        if (l.mSortPriority != r.mSortPriority)
-                        {
-                            return l.mSortPriority < r.mSortPriority;
-                        }
+#if EDITOR
+        // Kinda hacky but doing this to draw overlay text when in editor.
+        if (GetEditorState()->mOverlayText)
+        {
+            GetEditorState()->mOverlayText->Traverse(gatherDrawData);
+        }
+#endif
 
-                        float distL = glm::distance2(l.mPosition, cameraPos);
-                        float distR = glm::distance2(r.mPosition, cameraPos);
-                        return distL > distR;
-                    });
+        // Opaque and masked draws are grouped by pipeline and material, then sorted front to back.
+        // Translucent draws are sorted back to front. See DrawList for the key layouts.
+        mOpaqueDraws.Sort();
+        mPostShadowOpaqueDraws.Sort();
+        mTranslucentDraws.Sort();
     }
 }
 
@@ -742,87 +839,105 @@ static void SetLightData(LightData& lightData, Light3D* comp)
 void Renderer::GatherLightData(World* world)
 {
     static std::vector<LightDistance2> sClosestLights;
+    static std::vector<Node3D*> sPointLights;
+    static std::unordered_map<Light3D*, uint32_t> sClosestLightMap;
+    static std::unordered_set<Light3D*> sFadingLightSet;
     sClosestLights.clear();
+    sPointLights.clear();
 
     mLightData.clear();
-    const std::vector<Light3D*>& lights = world->GetLights();
     std::vector<FadingLight>& fadingLights = world->GetFadingLights();
 
-    if (mEnableLightFade)
+    Camera3D* camera = world->GetActiveCamera();
+    glm::vec3 camPos = camera ? camera->GetWorldPosition() : glm::vec3(0.0f, 0.0f, 0.0f);
+
+    // Step 1 - Gather candidates. Directional lights always apply, point lights are
+    // queried from the world's light tree so that lights outside of the view are never visited.
+    world->UpdateLightTree();
+
+    if (camera != nullptr && mFrustumCulling)
     {
-        float deltaTime = GetEngineState()->mGameDeltaTime;
-        uint32_t lightLimit = glm::min<uint32_t>(mLightFadeLimit, MAX_LIGHTS_PER_DRAW);
-        Camera3D* camera = world->GetActiveCamera();
-        glm::vec3 camPos = camera ? camera->GetWorldPosition() : glm::vec3(0.0f, 0.0f, 0.0f);
+        CameraFrustum frustum;
+        BuildCameraFrustum(camera, frustum);
+        world->GetLightTree().QueryFrustum(frustum, sPointLights);
+    }
+    else
+    {
+        world->GetLightTree().GatherAll(sPointLights);
+    }
 
-        // Step 1 - Determine the closest N lights
-        for (uint32_t i = 0; i < lights.size(); ++i)
-        {
-            if (!lights[i]->IsVisible()
+    // Step 2 - Keep the closest N lights in a max-heap (farthest light on top).
+    // Each draw then picks its own most relevant lights from this set.
+    uint32_t lightLimit = mEnableLightFade ? glm::min<uint32_t>(mLightFadeLimit, MAX_LIGHTS_PER_FRAME) : MAX_LIGHTS_PER_FRAME;
+
+    auto fartherLight = [](const LightDistance2& l, const LightDistance2& r)
+    {
+        return l.mDistance2 < r.mDistance2;
+    };
+
+    auto considerLight = [&](Light3D* light, float dist2)
+    {
+        if (!light->IsVisible()
 #if !EDITOR
-                || lights[i]->GetLightingDomain() == LightingDomain::Static
+            || light->GetLightingDomain() == LightingDomain::Static
 #endif
-                )
-            {
-                continue;
-            }
+            )
+        {
+            return;
+        }
 
-            glm::vec3 lightPos = lights[i]->GetWorldPosition();
-            bool directional = lights[i]->IsDirectionalLight3D();
+        if (sClosestLights.size() < lightLimit)
+        {
+            sClosestLights.push_back({ light, dist2 });
+            std::push_heap(sClosestLights.begin(), sClosestLights.end(), fartherLight);
+        }
+        else if (lightLimit > 0 && dist2 < sClosestLights.front().mDistance2)
+        {
+            // Evict the farthest light
+            std::pop_heap(sClosestLights.begin(), sClosestLights.end(), fartherLight);
+            sClosestLights.back() = { light, dist2 };
+            std::push_heap(sClosestLights.begin(), sClosestLights.end(), fartherLight);
+        }
+    };
 
-            float dist2 = directional ? 0.0f : glm::distance2(lightPos, camPos);
+    const std::vector<Light3D*>& dirLights = world->GetDirectionalLights();
+    for (uint32_t i = 0; i < dirLights.size(); ++i)
+    {
+        considerLight(dirLights[i], 0.0f);
+    }
 
-            if (sClosestLights.size() < lightLimit)
-            {
-                sClosestLights.push_back({ lights[i], dist2 });
-            }
-            else
-            {
-                // We need to evict the farthest light (if it is farther than this cur light)
-                int32_t farthestIdx = -1;
-                float farthestDist = 0.0f;
+    for (uint32_t i = 0; i < sPointLights.size(); ++i)
+    {
+        Light3D* light = static_cast<Light3D*>(sPointLights[i]);
+        considerLight(light, glm::distance2(light->GetWorldPosition(), camPos));
+    }
 
-                for (uint32_t j = 0; j < sClosestLights.size(); ++j)
-                {
-                    if (sClosestLights[j].mDistance2 > dist2 &&
-                        sClosestLights[j].mDistance2 > farthestDist)
-                    {
-                        farthestIdx = (int32_t)j;
-                        farthestDist = sClosestLights[j].mDistance2;
-                    }
-                }
+    // Closest first
+    std::sort_heap(sClosestLights.begin(), sClosestLights.end(), fartherLight);
 
-                // We found a light to evict.
-                if (farthestIdx >= 0)
-                {
-                    sClosestLights[farthestIdx] = { lights[i], dist2 };
-                }
-            }
+    if (mEnableLightFade)
+    {
+        float deltaTime = GetEngineState()->mGameDeltaTime;
+
+        sClosestLightMap.clear();
+        sFadingLightSet.clear();
+
+        for (uint32_t i = 0; i < sClosestLights.size(); ++i)
+        {
+            sClosestLightMap.insert({ sClosestLights[i].mComponent, i });
         }
 
-        // Step 2 - If there is space, add the closest lights to the fading light list (if not already in it).
-        std::sort(sClosestLights.begin(),
-            sClosestLights.end(),
-            [](const LightDistance2& l, const LightDistance2& r)
-            {
-                return l.mDistance2 < r.mDistance2;
-            });
+        for (uint32_t i = 0; i < fadingLights.size(); ++i)
+        {
+            sFadingLightSet.insert(fadingLights[i].mComponent);
+        }
 
+        // Step 3 - If there is space, add the closest lights to the fading light list (if not already in it).
         for (uint32_t i = 0; i < sClosestLights.size(); ++i)
         {
             if (fadingLights.size() < lightLimit)
             {
-                bool alreadyFading = false;
-                for (uint32_t j = 0; j < fadingLights.size(); ++j)
-                {
-                    if (fadingLights[j].mComponent == sClosestLights[i].mComponent)
-                    {
-                        alreadyFading = true;
-                        break;
-                    }
-                }
-
-                if (!alreadyFading)
+                if (sFadingLightSet.insert(sClosestLights[i].mComponent).second)
                 {
                     fadingLights.push_back(FadingLight(sClosestLights[i].mComponent));
                 }
@@ -836,25 +951,19 @@ void Renderer::GatherLightData(World* world)
 
         for (int32_t i = int32_t(fadingLights.size()) - 1; i >= 0; --i)
         {
-            // Step 3 - Determine which of the persistent N lights need to be faded out.
-            bool active = false;
+            // Step 4 - Determine which of the persistent N lights need to be faded out.
             FadingLight& fadingLight = fadingLights[i];
+            auto closestIt = sClosestLightMap.find(fadingLight.mComponent);
+            bool active = (closestIt != sClosestLightMap.end());
 
-            for (uint32_t j = 0; j < sClosestLights.size(); ++j)
+            if (active)
             {
-                if (fadingLight.mComponent == sClosestLights[j].mComponent)
-                {
-                    Light3D* light = sClosestLights[j].mComponent;
-
-                    // Ok, this light is still in the closest N lights.
-                    active = true;
-                    SetLightData(fadingLight.mData, light);
-                    fadingLight.mColor = fadingLight.mData.mColor;
-                    break;
-                }
+                // Ok, this light is still in the closest N lights.
+                SetLightData(fadingLight.mData, sClosestLights[closestIt->second].mComponent);
+                fadingLight.mColor = fadingLight.mData.mColor;
             }
 
-            // Step 4 - Fade in/out lights. Adjust alpha and update light color based on alpha.
+            // Step 5 - Fade in/out lights. Adjust alpha and update light color based on alpha.
             if (active)
             {
                 fadingLight.mAlpha += mLightFadeSpeed * deltaTime;
@@ -868,7 +977,7 @@ void Renderer::GatherLightData(World* world)
 
             fadingLight.mData.mColor = glm::mix(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f), fadingLight.mColor, fadingLight.mAlpha);
 
-            // Step 5 - Copy persistent light data to mLightData if alpha > 0, otherwise remove it from fading light vector
+            // Step 6 - Copy persistent light data to mLightData if alpha > 0, otherwise remove it from fading light vector
             if (fadingLight.mAlpha <= 0.0f)
             {
                 fadingLights.erase(fadingLights.begin() + i);
@@ -878,21 +987,23 @@ void Renderer::GatherLightData(World* world)
                 mLightData.push_back(fadingLight.mData);
             }
         }
+
+        // Keep the closest lights first for platforms that only use the first few lights.
+        std::sort(mLightData.begin(), mLightData.end(),
+            [camPos](const LightData& l, const LightData& r)
+            {
+                float lDist2 = (l.mType == LightType::Directional) ? 0.0f : glm::distance2(l.mPosition, camPos);
+                float rDist2 = (r.mType == LightType::Directional) ? 0.0f : glm::distance2(r.mPosition, camPos);
+                return lDist2 < rDist2;
+            });
     }
     else
     {
-        for (uint32_t i = 0; i < lights.size(); ++i)
+        for (uint32_t i = 0; i < sClosestLights.size(); ++i)
         {
-            if (lights[i]->IsVisible()
-#if !EDITOR
-                && lights[i]->GetLightingDomain() != LightingDomain::Static
-#endif
-                )
-            {
-                LightData lightData;
-                SetLightData(lightData, lights[i]);
-                mLightData.push_back(lightData);
-            }
+            LightData lightData;
+            SetLightData(lightData, sClosestLights[i].mComponent);
+            mLightData.push_back(lightData);
         }
     }
 
@@ -927,20 +1038,20 @@ void Renderer::GatherLightData(World* world)
 #endif
 }
 
-void Renderer::RenderDraws(const std::vector<DrawData>& drawData)
+void Renderer::RenderDraws(const DrawList& drawList)
 {
-    for (uint32_t i = 0; i < drawData.size(); ++i)
+    for (uint32_t i = 0; i < drawList.GetNumDraws(); ++i)
     {
-        drawData[i].mNode->Render();
+        drawList.GetDraw(i).mNode->Render();
     }
 }
 
-void Renderer::RenderDraws(const std::vector<DrawData>& drawData, PipelineConfig pipelineConfig)
+void Renderer::RenderDraws(const DrawList& drawList, PipelineConfig pipelineConfig)
 {
-    for (uint32_t i = 0; i < drawData.size(); ++i)
+    for (uint32_t i = 0; i < drawList.GetNumDraws(); ++i)
     {
         GFX_SetPipelineState(pipelineConfig);
-        drawData[i].mNode->Render();
+        drawList.GetDraw(i).mNode->Render();
     }
 }
 
@@ -965,14 +1076,23 @@ void Renderer::RenderDebugDraws(const std::vector<DebugDraw>& draws, PipelineCon
 #endif
 }
 
-void Renderer::FrustumCull(Camera3D* camera)
+void Renderer::BuildShadowFrustum(Light3D* light, Camera3D* camera, CameraFrustum& outFrustum)
 {
-    if (camera == nullptr)
-        return;
+    // Matches the orthographic projection in DirectionalLight3D::GenerateViewProjectionMatrix().
+    glm::vec3 direction = light->GetForwardVector();
+    glm::vec3 upVector = fabs(direction.y) > 0.5f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 right = glm::normalize(glm::cross(direction, upVector));
+    glm::vec3 up = glm::cross(right, direction);
 
-    CameraFrustum frustum;
-    frustum.SetPosition(camera->GetWorldPosition());
-    frustum.SetBasis(
+    outFrustum.SetPosition(camera->GetWorldPosition());
+    outFrustum.SetBasis(direction, up, right);
+    outFrustum.SetOrthographic(SHADOW_RANGE, SHADOW_RANGE, -SHADOW_RANGE_Z, SHADOW_RANGE_Z);
+}
+
+void Renderer::BuildCameraFrustum(Camera3D* camera, CameraFrustum& outFrustum)
+{
+    outFrustum.SetPosition(camera->GetWorldPosition());
+    outFrustum.SetBasis(
         camera->GetForwardVector(),
         camera->GetUpVector(),
         camera->GetRightVector());
@@ -986,7 +1106,7 @@ void Renderer::FrustumCull(Camera3D* camera)
         float fovY = camera->GetFieldOfViewY();
         float aspectRatio = camera->GetAspectRatio();
 
-        frustum.SetPerspective(
+        outFrustum.SetPerspective(
             fovY,
             aspectRatio,
             nearZ,
@@ -997,11 +1117,20 @@ void Renderer::FrustumCull(Camera3D* camera)
         float orthoWidth = camera->GetOrthoWidth();
         float orthoHeight = camera->GetOrthoHeight();
 
-        frustum.SetOrthographic(orthoWidth,
+        outFrustum.SetOrthographic(orthoWidth,
             orthoHeight,
             nearZ,
             farZ);
     }
+}
+
+void Renderer::FrustumCull(Camera3D* camera)
+{
+    if (camera == nullptr)
+        return;
+
+    CameraFrustum frustum;
+    BuildCameraFrustum(camera, frustum);
 
     int32_t drawsCulled = 0;
     drawsCulled += FrustumCullDraws(frustum, mOpaqueDraws);
@@ -1011,6 +1140,9 @@ void Renderer::FrustumCull(Camera3D* camera)
     drawsCulled += FrustumCullDraws(frustum, mWireframeDraws);
     //LogDebug("Draws culled: %d", drawsCulled);
 
+    SkeletalMesh3D::UpdateAnimations(mAnimationUpdates, GetEngineState()->mGameDeltaTime);
+    mAnimationUpdates.clear();
+
     int32_t lightsCulled = 0;
     if (GFX_ShouldCullLights())
     {
@@ -1026,79 +1158,85 @@ void Renderer::FrustumCull(Camera3D* camera)
 #endif
 }
 
-static inline void HandleCullResult(DrawData& drawData, bool inFrustum)
+static inline void HandleCullResult(DrawData& drawData, bool inFrustum, std::vector<AnimationUpdateRequest>& animUpdates)
 {
-    if (drawData.mNodeType == SkeletalMesh3D::GetStaticType())
+    SkeletalMesh3D* skNode = drawData.mNode->As<SkeletalMesh3D>();
+    Particle3D* pNode = (skNode == nullptr) ? drawData.mNode->As<Particle3D>() : nullptr;
+
+    if (skNode != nullptr)
     {
-        SkeletalMesh3D* skNode = static_cast<SkeletalMesh3D*>(drawData.mNode);
 
+        // Animations are collected here and updated together at the end of FrustumCull()
+        // so that their poses can be evaluated in parallel.
         if (inFrustum)
         {
-            skNode->UpdateAnimation(GetEngineState()->mGameDeltaTime, true);
+            animUpdates.push_back({ skNode, true });
         }
         else
         {
             AnimationUpdateMode animMode = skNode->GetAnimationUpdateMode();
             if (animMode == AnimationUpdateMode::AlwaysUpdateTimeAndBones)
             {
-                skNode->UpdateAnimation(GetEngineState()->mGameDeltaTime, true);
+                animUpdates.push_back({ skNode, true });
             }
             else if (animMode == AnimationUpdateMode::AlwaysUpdateTime)
             {
-                skNode->UpdateAnimation(GetEngineState()->mGameDeltaTime, false);
+                animUpdates.push_back({ skNode, false });
             }
         }
     }
-    else if (drawData.mNodeType == Particle3D::GetStaticType())
+    else if (pNode != nullptr)
     {
-        Particle3D* pNode = static_cast<Particle3D*>(drawData.mNode);
-
-        if (inFrustum)
-        {
-            pNode->Simulate(GetEngineState()->mGameDeltaTime);
-            pNode->UpdateVertexBuffer();
-        }
-        else if (pNode->ShouldAlwaysSimulate())
+        // Simulated afterwards by Particle3D::UpdateEmitters().
+        if (!inFrustum)
         {
-            pNode->Simulate(GetEngineState()->mGameDeltaTime);
+            pNode->SetInView(false);
         }
     }
 }
 
-int32_t Renderer::FrustumCullDraws(const CameraFrustum& frustum, std::vector<DrawData>& drawData)
+int32_t Renderer::FrustumCullDraws(const CameraFrustum& frustum, DrawList& drawList)
 {
     int32_t drawsCulled = 0;
+    uint32_t numDraws = drawList.GetNumDraws();
 
     // Some code duplication below, but I'm doing this to make sure the branching on ortho doesn't impact performance so much.
     if (frustum.mOrtho)
     {
-        for (int32_t i = int32_t(drawData.size()) - 1; i >= 0; --i)
+        for (uint32_t i = 0; i < numDraws; ++i)
         {
-            bool inFrustum = frustum.IsSphereInFrustumOrtho(drawData[i].mBounds.mCenter, drawData[i].mBounds.mRadius);
-            HandleCullResult(drawData[i], inFrustum);
+            DrawData& drawData = drawList.GetDraw(i);
+            bool inFrustum = frustum.IsSphereInFrustumOrtho(drawData.mBounds.mCenter, drawData.mBounds.mRadius);
+            HandleCullResult(drawData, inFrustum, mAnimationUpdates);
 
             if (!inFrustum)
             {
-                drawData.erase(drawData.begin() + i);
+                drawList.MarkRemoved(i);
                 drawsCulled++;
             }
         }
     }
     else
     {
-        for (int32_t i = int32_t(drawData.size()) - 1; i >= 0; --i)
+        for (uint32_t i = 0; i < numDraws; ++i)
         {
-            bool inFrustum = frustum.IsSphereInFrustum(drawData[i].mBounds.mCenter, drawData[i].mBounds.mRadius);
-            HandleCullResult(drawData[i], inFrustum);
+            DrawData& drawData = drawList.GetDraw(i);
+            bool inFrustum = frustum.IsSphereInFrustum(drawData.mBounds.mCenter, drawData.mBounds.mRadius);
+            HandleCullResult(drawData, inFrustum, mAnimationUpdates);
 
             if (!inFrustum)
             {
-                drawData.erase(drawData.begin() + i);
+                drawList.MarkRemoved(i);
                 drawsCulled++;
             }
         }
     }
 
+    if (drawsCulled > 0)
+    {
+        drawList.Compact();
+    }
+
     return drawsCulled;
 }
 
@@ -1250,6 +1388,11 @@ void Renderer::Render(World* world, int32_t screenIndex)
                 FrustumCull(activeCamera);
             }
         }
+
+        // Emitters simulate in parallel once culling has decided which of them are in view.
+        // This has to finish before rendering since it writes the particle vertex buffers.
+        Particle3D::UpdateEmitters(mParticleUpdates, GetEngineState()->mGameDeltaTime);
+        mParticleUpdates.clear();
     }
 
     // Still update UI and cull when minimized (to update animation and particle simulation)
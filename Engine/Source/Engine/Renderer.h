@@ -5,6 +5,7 @@
 #include <array>
 
 #include "EngineTypes.h"
+#include "DrawList.h"
 #include "Assets/Texture.h"
 #include "Assets/StaticMesh.h"
 #include "Assets/MaterialLite.h"
@@ -18,6 +19,7 @@ class Widget;
 class Console;
 class StatsOverlay;
 class CameraFrustum;
+class Particle3D;
 
 struct EngineState;
 
@@ -183,11 +185,13 @@ private:
 
     void GatherDrawData(World* world);
     void GatherLightData(World* world);
-    void RenderDraws(const std::vector<DrawData>& drawData);
-    void RenderDraws(const std::vector<DrawData>& drawData, PipelineConfig pipelineConfig);
+    void RenderDraws(const DrawList& drawList);
+    void RenderDraws(const DrawList& drawList, PipelineConfig pipelineConfig);
     void RenderDebugDraws(const std::vector<DebugDraw>& draws, PipelineConfig pipelineConfig = PipelineConfig::Count);
+    void BuildCameraFrustum(Camera3D* camera, CameraFrustum& outFrustum);
+    void BuildShadowFrustum(Light3D* light, Camera3D* camera, CameraFrustum& outFrustum);
     void FrustumCull(Camera3D* camera);
-    int32_t FrustumCullDraws(const CameraFrustum& frustum, std::vector<DrawData>& drawData);
+    int32_t FrustumCullDraws(const CameraFrustum& frustum, DrawList& drawList);
     int32_t FrustumCullDraws(const CameraFrustum& frustum, std::vector<DebugDraw>& drawData);
     int32_t FrustumCullLights(const CameraFrustum& frustum, std::vector<LightData>& lightData);
 
@@ -203,15 +207,17 @@ private:
 
     bool mInitialized = false;
 
-    std::vector<DrawData> mShadowDraws;
-    std::vector<DrawData> mOpaqueDraws;
-    std::vector<DrawData> mSimpleShadowDraws;
-    std::vector<DrawData> mPostShadowOpaqueDraws; // (post-simple-shadow opaques. not talking about shadow mapping)
-    std::vector<DrawData> mTranslucentDraws;
-    std::vector<DrawData> mWireframeDraws;
-    std::vector<DrawData> mWidgetDraws;
+    DrawList mShadowDraws;
+    DrawList mOpaqueDraws;
+    DrawList mSimpleShadowDraws;
+    DrawList mPostShadowOpaqueDraws; // (post-simple-shadow opaques. not talking about shadow mapping)
+    DrawList mTranslucentDraws;
+    DrawList mWireframeDraws;
+    DrawList mWidgetDraws;
 
     std::vector<LightData> mLightData;
+    std::vector<AnimationUpdateRequest> mAnimationUpdates;
+    std::vector<Particle3D*> mParticleUpdates;
 
     std::vector<DebugDraw> mDebugDraws;
     std::vector<DebugDraw> mCollisionDraws;
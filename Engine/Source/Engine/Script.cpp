@@ -5,6 +5,7 @@
 #include "Assets/SkeletalMesh.h"
 #include "Engine.h"
 #include "Log.h"
+#include "Utilities.h"
 
 #include "LuaBindings/LuaUtils.h"
 #include "LuaBindings/Vector_Lua.h"
@@ -18,6 +19,7 @@
 DEFINE_OBJECT(Script);
 
 std::unordered_map<std::string, ScriptNetFuncMap> Script::sScriptNetFuncMap;
+std::unordered_map<std::string, ScriptCallbacks> Script::sScriptCallbackMap;
 
 bool Script::HandleScriptPropChange(Datum* datum, uint32_t index, const void* newValue)
 {
@@ -662,6 +664,19 @@ void Script::GatherReplicatedData()
                             newDatum.mOnRepFuncName = onRep;
                             lua_pop(L, 1);
 
+                            // Optional range for replicating floats/vectors/colors with fewer bits.
+                            lua_getfield(L, propIdx, "min");
+                            lua_getfield(L, propIdx, "max");
+                            lua_getfield(L, propIdx, "bits");
+                            if (lua_isnumber(L, -3) && lua_isnumber(L, -2))
+                            {
+                                float minValue = (float)lua_tonumber(L, -3);
+                                float maxValue = (float)lua_tonumber(L, -2);
+                                uint32_t bits = lua_isinteger(L, -1) ? (uint32_t)lua_tointeger(L, -1) : 16;
+                                newDatum.SetBoundedQuantization(minValue, maxValue, bits);
+                            }
+                            lua_pop(L, 3);
+
                             // TODO: Handle array data
                             //lua_getfield(L, propIdx, "count");
                             //int32_t count= lua_isinteger(L, -1) ? lua_tointeger(L, -1) : 1;
@@ -1336,6 +1351,8 @@ bool Script::ReloadScriptFile(const std::string& fileName, bool restartScript)
         sScriptNetFuncMap.erase(it);
     }
 
+    InvalidateCallbacks(className);
+
     if (success && restartScript)
     {
         RestartScript();
@@ -1344,6 +1361,73 @@ bool Script::ReloadScriptFile(const std::string& fileName, bool restartScript)
     return success;
 }
 
+void Script::InvalidateCallbacks(const std::string& className)
+{
+#if LUA_ENABLED
+    auto it = sScriptCallbackMap.find(className);
+    if (it != sScriptCallbackMap.end())
+    {
+        // Keep the entry itself alive since running instances point at it.
+        lua_State* L = GetLua();
+        ScriptCallbacks& callbacks = it->second;
+        int* refs[] = { &callbacks.mTick, &callbacks.mEditorTick, &callbacks.mBeginOverlap, &callbacks.mEndOverlap, &callbacks.mOnCollision };
+
+        for (int32_t i = 0; i < OCT_ARRAY_SIZE(refs); ++i)
+        {
+            if (L != nullptr && *refs[i] != LUA_REFNIL)
+            {
+                luaL_unref(L, LUA_REGISTRYINDEX, *refs[i]);
+            }
+
+            *refs[i] = LUA_REFNIL;
+        }
+
+        callbacks.mResolved = false;
+
+        // Resolve against the reloaded class table right away. Instances that are not
+        // restarted keep pointing at this entry and would otherwise stop receiving callbacks.
+        if (L != nullptr && ScriptUtils::IsScriptLoaded(className))
+        {
+            lua_getglobal(L, className.c_str());
+
+            if (lua_istable(L, -1))
+            {
+                int classTableIdx = lua_gettop(L);
+                const char* funcNames[] = { "Tick", "EditorTick", "BeginOverlap", "EndOverlap", "OnCollision" };
+
+                for (int32_t i = 0; i < OCT_ARRAY_SIZE(refs); ++i)
+                {
+                    lua_getfield(L, classTableIdx, funcNames[i]);
+
+                    if (lua_isfunction(L, -1))
+                    {
+                        *refs[i] = luaL_ref(L, LUA_REGISTRYINDEX); // Pops function
+                    }
+                    else
+                    {
+                        lua_pop(L, 1);
+                    }
+                }
+
+                callbacks.mResolved = true;
+            }
+
+            lua_pop(L, 1);
+        }
+    }
+#endif
+}
+
+void Script::InvalidateAllCallbacks()
+{
+#if LUA_ENABLED
+    for (auto& it : sScriptCallbackMap)
+    {
+        InvalidateCallbacks(it.first);
+    }
+#endif
+}
+
 std::vector<ScriptNetDatum>& Script::GetReplicatedData()
 {
     return mReplicatedData;
@@ -1392,36 +1476,22 @@ bool Script::InvokeNetFunc(const char* name, uint32_t numParams, const Datum** p
 void Script::BeginOverlap(Primitive3D* thisNode, Primitive3D* otherNode)
 {
 #if LUA_ENABLED
-    if (mHandleBeginOverlap && IsActive())
+    if (IsActive() && mCallbacks != nullptr && mCallbacks->mBeginOverlap != LUA_REFNIL)
     {
         lua_State* L = GetLua();
 
-        // Grab the ud
-        Node_Lua::Create(L, mOwner);
-
-        OCT_ASSERT(lua_isuserdata(L, -1));
-        int udIdx = lua_gettop(L);
-        lua_getfield(L, udIdx, "BeginOverlap");
-
-        if (lua_isfunction(L, -1))
-        {
-            lua_pushvalue(L, udIdx);
-            Node_Lua::Create(L, thisNode);
-            Node_Lua::Create(L, otherNode);
-
-            // Instance table at -5
-            // Func at -4
-            // Instance table (as arg1) at -3
-            // thisComp (as arg2) at -2
-            // othercomp as (arg3) at -1
-            LuaFuncCall(3);
-        }
-        else
-        {
-            lua_pop(L, 1); // pop nil function
-        }
+        lua_rawgeti(L, LUA_REGISTRYINDEX, mCallbacks->mBeginOverlap);
+        OCT_ASSERT(lua_isfunction(L, -1));
 
-        lua_pop(L, 1); // pop instance table
+        Node_Lua::Create(L, mOwner);
+        Node_Lua::Create(L, thisNode);
+        Node_Lua::Create(L, otherNode);
+
+        // Func at -4
+        // Instance table (as arg1) at -3
+        // thisComp (as arg2) at -2
+        // othercomp as (arg3) at -1
+        LuaFuncCall(3);
     }
 #endif
 }
@@ -1429,35 +1499,22 @@ void Script::BeginOverlap(Primitive3D* thisNode, Primitive3D* otherNode)
 void Script::EndOverlap(Primitive3D* thisNode, Primitive3D* otherNode)
 {
 #if LUA_ENABLED
-    if (mHandleEndOverlap && IsActive())
+    if (IsActive() && mCallbacks != nullptr && mCallbacks->mEndOverlap != LUA_REFNIL)
     {
         lua_State* L = GetLua();
 
-        Node_Lua::Create(L, mOwner);
-
-        OCT_ASSERT(lua_isuserdata(L, -1));
-        int udIdx = lua_gettop(L);
-        lua_getfield(L, udIdx, "EndOverlap");
+        lua_rawgeti(L, LUA_REGISTRYINDEX, mCallbacks->mEndOverlap);
+        OCT_ASSERT(lua_isfunction(L, -1));
 
-        if (lua_isfunction(L, -1))
-        {
-            lua_pushvalue(L, udIdx);
-            Node_Lua::Create(L, thisNode);
-            Node_Lua::Create(L, otherNode);
-
-            // Instance table at -5
-            // Func at -4
-            // Instance table (as arg1) at -3
-            // thisNode (as arg2) at -2
-            // otherNode as (arg3) at -1
-            LuaFuncCall(3);
-        }
-        else
-        {
-            lua_pop(L, 1); // pop nil function
-        }
-
-        lua_pop(L, 1); // pop instance table
+        Node_Lua::Create(L, mOwner);
+        Node_Lua::Create(L, thisNode);
+        Node_Lua::Create(L, otherNode);
+
+        // Func at -4
+        // Instance table (as arg1) at -3
+        // thisNode (as arg2) at -2
+        // otherNode as (arg3) at -1
+        LuaFuncCall(3);
     }
 #endif
 }
@@ -1470,32 +1527,21 @@ void Script::OnCollision(
     btPersistentManifold* manifold)
 {
 #if LUA_ENABLED
-    if (mHandleOnCollision && IsActive())
+    if (IsActive() && mCallbacks != nullptr && mCallbacks->mOnCollision != LUA_REFNIL)
     {
         lua_State* L = GetLua();
 
-        Node_Lua::Create(L, mOwner);
-        OCT_ASSERT(lua_isuserdata(L, -1));
-        int udIdx = lua_gettop(L);
-        lua_getfield(L, udIdx, "OnCollision");
+        lua_rawgeti(L, LUA_REGISTRYINDEX, mCallbacks->mOnCollision);
+        OCT_ASSERT(lua_isfunction(L, -1));
 
-        if (lua_isfunction(L, -1))
-        {
-            lua_pushvalue(L, udIdx);                                // arg1 - self
-            Node_Lua::Create(L, thisNode);                          // arg2 - thisNode
-            Node_Lua::Create(L, otherNode);                         // arg3 - otherNode
-            Vector_Lua::Create(L, glm::vec4(impactPoint, 0.0f));    // arg4 - impactPoint
-            Vector_Lua::Create(L, glm::vec4(impactNormal, 0.0f));   // arg5 - impactNormal
-            // TODO: Do we want to handle manifold points?
-
-            LuaFuncCall(5);
-        }
-        else
-        {
-            lua_pop(L, 1); // pop nil function
-        }
+        Node_Lua::Create(L, mOwner);                            // arg1 - self
+        Node_Lua::Create(L, thisNode);                          // arg2 - thisNode
+        Node_Lua::Create(L, otherNode);                         // arg3 - otherNode
+        Vector_Lua::Create(L, glm::vec4(impactPoint, 0.0f));    // arg4 - impactPoint
+        Vector_Lua::Create(L, glm::vec4(impactNormal, 0.0f));   // arg5 - impactNormal
+        // TODO: Do we want to handle manifold points?
 
-        lua_pop(L, 1); // pop instance table
+        LuaFuncCall(5);
     }
 #endif
 }
@@ -1812,10 +1858,7 @@ void Script::CreateScriptInstance()
             OCT_ASSERT(lua_gettop(L) == classTableIdx);
             lua_setfield(L, uvIdx, OCT_CLASS_TABLE_KEY); // Pops script class metatable
 
-            mTickEnabled = CheckIfFunctionExists("Tick");
-            mHandleBeginOverlap = CheckIfFunctionExists("BeginOverlap");
-            mHandleEndOverlap = CheckIfFunctionExists("EndOverlap");
-            mHandleOnCollision = CheckIfFunctionExists("OnCollision");
+            ResolveCallbacks();
 
             SetWorld(mOwner->GetWorld());
 
@@ -1907,10 +1950,7 @@ void Script::DestroyScriptInstance()
         mActive = false;
     }
 
-    mTickEnabled = false;
-    mHandleBeginOverlap = false;
-    mHandleEndOverlap = false;
-    mHandleOnCollision = false;
+    mCallbacks = nullptr;
 #endif
 }
 
@@ -1925,55 +1965,59 @@ void Script::CallTick(float deltaTime)
 {
 #if LUA_ENABLED
 
-#if EDITOR
-    if (IsActive())
+    if (IsActive() && mCallbacks != nullptr)
     {
-        if (IsGameTickEnabled())
-        {
-            CallFunction("Tick", deltaTime);
-        }
-        else
-        {
-            CallFunction("EditorTick", deltaTime);
-        }
-    }
+#if EDITOR
+        int funcRef = IsGameTickEnabled() ? mCallbacks->mTick : mCallbacks->mEditorTick;
 #else
-    if (IsActive() && mTickEnabled)
-    {
-        lua_State* L = GetLua();
+        int funcRef = mCallbacks->mTick;
+#endif
 
-        Node_Lua::Create(L, mOwner);
-        OCT_ASSERT(lua_isuserdata(L, -1));
+        // Scripts without a tick function don't need to enter Lua at all.
+        if (funcRef != LUA_REFNIL)
+        {
+            lua_State* L = GetLua();
 
-        lua_getfield(L, -1, "Tick");
+            lua_rawgeti(L, LUA_REGISTRYINDEX, funcRef);
+            OCT_ASSERT(lua_isfunction(L, -1));
 
-        if (lua_isfunction(L, -1))
-        {
-            lua_pushvalue(L, -2);
+            Node_Lua::Create(L, mOwner);
             lua_pushnumber(L, deltaTime);
 
-            // Instance table at -4
             // Func at -3
             // Instance table (as arg0) at -2
             // deltaTime as (arg1) at -1
             LuaFuncCall(2);
         }
-        else
-        {
-            lua_pop(L, 1);
-        }
-
-        lua_pop(L, 1);
     }
-#endif // EDITOR
 
 #endif // LUA_ENABLED
 
 }
 
-bool Script::CheckIfFunctionExists(const char* funcName)
+void Script::ResolveCallbacks()
 {
-    bool exists = false;
+#if LUA_ENABLED
+    ScriptCallbacks& callbacks = sScriptCallbackMap[mClassName];
+
+    if (!callbacks.mResolved)
+    {
+        callbacks.mTick = RefFunction("Tick");
+        callbacks.mEditorTick = RefFunction("EditorTick");
+        callbacks.mBeginOverlap = RefFunction("BeginOverlap");
+        callbacks.mEndOverlap = RefFunction("EndOverlap");
+        callbacks.mOnCollision = RefFunction("OnCollision");
+        callbacks.mResolved = true;
+    }
+
+    // Instances read the shared entry on every call, so reloading the class updates them all.
+    mCallbacks = &callbacks;
+#endif
+}
+
+int Script::RefFunction(const char* funcName)
+{
+    int ref = LUA_REFNIL;
 
 #if LUA_ENABLED
     if (IsActive())
@@ -1987,14 +2031,18 @@ bool Script::CheckIfFunctionExists(const char* funcName)
 
         if (lua_isfunction(L, -1))
         {
-            exists = true;
+            ref = luaL_ref(L, LUA_REGISTRYINDEX); // Pops function
+        }
+        else
+        {
+            lua_pop(L, 1);
         }
 
-        lua_pop(L, 2);
+        lua_pop(L, 1);
     }
 #endif
 
-    return exists;
+    return ref;
 }
 
 
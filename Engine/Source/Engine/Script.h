@@ -25,6 +25,18 @@ struct AutoProperty
 
 typedef std::unordered_map<std::string, ScriptNetFunc> ScriptNetFuncMap;
 
+// Registry refs to the lifecycle callbacks of a script class, so they don't need to be
+// looked up by name every time they are invoked. LUA_REFNIL if the class doesn't define one.
+struct ScriptCallbacks
+{
+    int mTick = LUA_REFNIL;
+    int mEditorTick = LUA_REFNIL;
+    int mBeginOverlap = LUA_REFNIL;
+    int mEndOverlap = LUA_REFNIL;
+    int mOnCollision = LUA_REFNIL;
+    bool mResolved = false;
+};
+
 class Script : public Object
 {
 public:
@@ -53,6 +65,8 @@ public:
     void SetWorld(World* world);
 
     bool ReloadScriptFile(const std::string& fileName, bool restartScript = true);
+    static void InvalidateCallbacks(const std::string& className);
+    static void InvalidateAllCallbacks();
 
     std::vector<ScriptNetDatum>& GetReplicatedData();
 
@@ -131,9 +145,11 @@ protected:
 
     void CallTick(float deltaTime);
 
-    bool CheckIfFunctionExists(const char* funcName);
+    void ResolveCallbacks();
+    int RefFunction(const char* funcName);
 
     static std::unordered_map<std::string, ScriptNetFuncMap> sScriptNetFuncMap;
+    static std::unordered_map<std::string, ScriptCallbacks> sScriptCallbackMap;
 
     Node* mOwner = nullptr;
     std::string mFileName;
@@ -141,10 +157,7 @@ protected:
     std::vector<Property> mScriptProps;
     std::vector<ScriptNetDatum> mReplicatedData;
     std::vector<AutoProperty> mAutoProperties;
+    const ScriptCallbacks* mCallbacks = nullptr;
     bool mActive = false;
-    bool mTickEnabled = false;
-    bool mHandleBeginOverlap = false;
-    bool mHandleEndOverlap = false;
-    bool mHandleOnCollision = false;
 };
 
@@ -98,6 +98,31 @@ void ScriptFunc::Call(uint32_t numParams, Datum* params) const
     }
 }
 
+void ScriptFunc::CallMethod(const Datum& self, uint32_t numParams, const Datum* params) const
+{
+    lua_State* L = GetLua();
+    if (L != nullptr &&
+        mRef != LUA_REFNIL)
+    {
+        lua_getfield(L, LUA_REGISTRYINDEX, REF_TABLE_NAME);
+        OCT_ASSERT(lua_istable(L, -1));
+
+        // Push function
+        lua_geti(L, -1, mRef);
+
+        // Push self followed by the params
+        LuaPushDatum(L, self);
+
+        OCT_ASSERT(numParams == 0 || params != nullptr);
+        for (uint32_t i = 0; i < numParams; ++i)
+        {
+            LuaPushDatum(L, params[i]);
+        }
+
+        ScriptUtils::CallLuaFunc(numParams + 1, 0);
+    }
+}
+
 Datum ScriptFunc::CallR(uint32_t numParams, Datum* params) const
 {
     Datum retDatum;
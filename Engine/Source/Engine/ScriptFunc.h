@@ -20,6 +20,7 @@ public:
     bool operator!=(const ScriptFunc& other) const;
 
     void Call(uint32_t numParams = 0, Datum* params = nullptr) const;
+    void CallMethod(const Datum& self, uint32_t numParams, const Datum* params) const;
     Datum CallR(uint32_t numParams = 0, Datum* params = nullptr) const;
 
     void Push(lua_State* L) const;
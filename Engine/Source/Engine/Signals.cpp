@@ -2,7 +2,49 @@
 #include "Script.h"
 #include "Nodes/Node.h"
 
-void Signal::Emit(const std::vector<Datum>& args)
+#include <mutex>
+
+struct SignalRegistry
+{
+    std::unordered_map<std::string, SignalId> mIdMap;
+    std::vector<std::string> mNames;
+    std::mutex mMutex;
+};
+
+static SignalRegistry& GetSignalRegistry()
+{
+    // Function-local so that signals can be interned during static initialization.
+    static SignalRegistry sRegistry;
+    return sRegistry;
+}
+
+SignalId InternSignal(const std::string& name)
+{
+    SignalRegistry& registry = GetSignalRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    auto it = registry.mIdMap.find(name);
+    if (it != registry.mIdMap.end())
+    {
+        return it->second;
+    }
+
+    SignalId id = (SignalId)registry.mNames.size();
+    registry.mNames.push_back(name);
+    registry.mIdMap.insert({ name, id });
+    return id;
+}
+
+SignalId FindSignal(const std::string& name)
+{
+    SignalRegistry& registry = GetSignalRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    auto it = registry.mIdMap.find(name);
+    return (it != registry.mIdMap.end()) ? it->second : INVALID_SIGNAL_ID;
+}
+
+void Signal::Emit(const Datum* args, uint32_t numArgs)
 {
     mEmitting = true;
 
@@ -19,21 +61,19 @@ void Signal::Emit(const std::vector<Datum>& args)
             if (it->second.mFuncPointer != nullptr)
             {
                 SignalHandlerFP handler = it->second.mFuncPointer;
-                handler(node, args);
+                handler(node, args, numArgs);
+            }
+
+            if (it->second.mLegacyFuncPointer != nullptr)
+            {
+                std::vector<Datum> argVector(args, args + numArgs);
+                it->second.mLegacyFuncPointer(node, argVector);
             }
 
             if (it->second.mScriptFunc.IsValid())
             {
                 // Call the function as a member function (prepend self)
-                std::vector<Datum> selfArgs;
-                selfArgs.push_back(node);
-
-                if (args.size() > 0)
-                {
-                    selfArgs.insert(selfArgs.end(), args.begin(), args.end());
-                }
-
-                it->second.mScriptFunc.Call((uint32_t)selfArgs.size(), selfArgs.data());
+                it->second.mScriptFunc.CallMethod(node, numArgs, args);
             }
 
             it++;
@@ -51,45 +91,40 @@ void Signal::Emit(const std::vector<Datum>& args)
     {
         mConnectionMap.insert({ mPendingConnects[i] });
     }
+
+    mPendingDisconnects.clear();
+    mPendingConnects.clear();
+}
+
+bool Signal::HasConnections() const
+{
+    return (mConnectionMap.size() > 0 || mPendingConnects.size() > 0);
 }
 
 void Signal::Connect(Node* node, SignalHandlerFP func)
 {
-    if (node != nullptr)
+    SignalHandlerFunc* handler = GetConnectHandler(node);
+    if (handler != nullptr)
     {
-        CleanupDeadConnections();
-        NodePtrWeak nodePtrWeak = ResolveWeakPtr(node);
+        handler->mFuncPointer = func;
+    }
+}
 
-        if (mEmitting)
-        {
-            SignalHandlerFunc handler;
-            handler.mFuncPointer = func;
-            mPendingConnects.push_back({ nodePtrWeak, handler });
-        }
-        else
-        {
-            mConnectionMap[nodePtrWeak].mFuncPointer = func;
-        }
+void Signal::Connect(Node* node, LegacySignalHandlerFP func)
+{
+    SignalHandlerFunc* handler = GetConnectHandler(node);
+    if (handler != nullptr)
+    {
+        handler->mLegacyFuncPointer = func;
     }
 }
 
 void Signal::Connect(Node* node, const ScriptFunc& func)
 {
-    if (node != nullptr)
+    SignalHandlerFunc* handler = GetConnectHandler(node);
+    if (handler != nullptr)
     {
-        CleanupDeadConnections();
-        NodePtrWeak nodePtrWeak = ResolveWeakPtr(node);
-
-        if (mEmitting)
-        {
-            SignalHandlerFunc handler;
-            handler.mScriptFunc = func;
-            mPendingConnects.push_back({ nodePtrWeak, handler });
-        }
-        else
-        {
-            mConnectionMap[nodePtrWeak].mScriptFunc = func;
-        }
+        handler->mScriptFunc = func;
     }
 }
 
@@ -110,6 +145,24 @@ void Signal::Disconnect(Node* node)
     }
 }
 
+SignalHandlerFunc* Signal::GetConnectHandler(Node* node)
+{
+    if (node == nullptr)
+        return nullptr;
+
+    CleanupDeadConnections();
+    NodePtrWeak nodePtrWeak = ResolveWeakPtr(node);
+
+    if (mEmitting)
+    {
+        // Connections made while emitting are added once the emit finishes.
+        mPendingConnects.push_back({ nodePtrWeak, SignalHandlerFunc() });
+        return &mPendingConnects.back().second;
+    }
+
+    return &mConnectionMap[nodePtrWeak];
+}
+
 void Signal::CleanupDeadConnections()
 {
     if (mEmitting)
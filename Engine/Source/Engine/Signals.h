@@ -8,11 +8,26 @@
 
 class Node;
 
-typedef void (*SignalHandlerFP)(Node*, const std::vector<Datum>&);
+typedef uint32_t SignalId;
+typedef void (*SignalHandlerFP)(Node*, const Datum* args, uint32_t numArgs);
+
+// The handler signature from before signals took an argument span. Still accepted so existing
+// native handlers keep working, but each emit copies the arguments into a vector for them.
+typedef void (*LegacySignalHandlerFP)(Node*, const std::vector<Datum>& args);
+
+#define INVALID_SIGNAL_ID 0xffffffff
+
+// Signal names are interned once so that emitting/connecting doesn't need to hash strings.
+SignalId InternSignal(const std::string& name);
+
+// Returns INVALID_SIGNAL_ID if the name was never interned, which means nothing can be connected to it.
+// Takes the registry lock, so prefer interning once and emitting by id in hot code.
+SignalId FindSignal(const std::string& name);
 
 struct SignalHandlerFunc
 {
     SignalHandlerFP mFuncPointer = nullptr;
+    LegacySignalHandlerFP mLegacyFuncPointer = nullptr;
     mutable ScriptFunc mScriptFunc;
 };
 
@@ -20,13 +35,16 @@ class Signal
 {
 public:
 
-    void Emit(const std::vector<Datum>& args);
+    void Emit(const Datum* args, uint32_t numArgs);
+    bool HasConnections() const;
     void Connect(Node* node, SignalHandlerFP func);
+    void Connect(Node* node, LegacySignalHandlerFP func);
     void Connect(Node* node, const ScriptFunc& func);
     void Disconnect(Node* node);
 
 private:
 
+    SignalHandlerFunc* GetConnectHandler(Node* node);
     void CleanupDeadConnections();
 
     std::unordered_map<NodePtrWeak, SignalHandlerFunc> mConnectionMap;
@@ -0,0 +1,286 @@
+#include "Skinning.h"
+#include "JobSystem.h"
+#include "Log.h"
+#include "Utilities.h"
+#include "Assertion.h"
+
+#include "System/System.h"
+
+#include <stdio.h>
+#include <vector>
+
+#if SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// Vertices per job. Small enough that a single large mesh spreads over every worker,
+// large enough that the job overhead stays negligible.
+static const uint32_t kSkinningBatchSize = 2048;
+static const uint32_t kMaxSkinningJobs = 64;
+
+static void SkinVerticesScalar(const SkinningParams& params, uint32_t start, uint32_t end)
+{
+    const glm::mat4* bones = params.mBoneMatrices;
+
+    for (uint32_t i = start; i < end; ++i)
+    {
+        const VertexSkinned& srcVert = params.mVertices[i];
+        Vertex& dstVert = params.mOutVertices[i];
+
+        glm::mat4 transform;
+
+        if (params.mNumInfluences == 1)
+        {
+            transform = bones[srcVert.mBoneIndices[0]];
+        }
+        else
+        {
+            static_assert(MAX_BONE_INFLUENCES == 4, "Need to adjust this code or convert to loop.");
+            transform = bones[srcVert.mBoneIndices[0]] * srcVert.mBoneWeights[0];
+            transform += bones[srcVert.mBoneIndices[1]] * srcVert.mBoneWeights[1];
+            transform += bones[srcVert.mBoneIndices[2]] * srcVert.mBoneWeights[2];
+            transform += bones[srcVert.mBoneIndices[3]] * srcVert.mBoneWeights[3];
+        }
+
+        dstVert.mPosition = transform * glm::vec4(srcVert.mPosition, 1.0f);
+        dstVert.mNormal = transform * glm::vec4(srcVert.mNormal, 0.0f);
+        dstVert.mTexcoord0 = srcVert.mTexcoord0;
+        dstVert.mTexcoord1 = srcVert.mTexcoord1;
+    }
+}
+
+#if SIMD_SSE
+static void SkinVerticesSse(const SkinningParams& params, uint32_t start, uint32_t end)
+{
+    const glm::mat4* bones = params.mBoneMatrices;
+    const bool singleInfluence = (params.mNumInfluences == 1);
+
+    for (uint32_t i = start; i < end; ++i)
+    {
+        const VertexSkinned& srcVert = params.mVertices[i];
+        Vertex& dstVert = params.mOutVertices[i];
+
+        // Blend the bone matrices one column at a time.
+        const float* m0 = &bones[srcVert.mBoneIndices[0]][0][0];
+        __m128 col0 = _mm_loadu_ps(m0 + 0);
+        __m128 col1 = _mm_loadu_ps(m0 + 4);
+        __m128 col2 = _mm_loadu_ps(m0 + 8);
+        __m128 col3 = _mm_loadu_ps(m0 + 12);
+
+        if (!singleInfluence)
+        {
+            __m128 weight = _mm_set1_ps(srcVert.mBoneWeights[0]);
+            col0 = _mm_mul_ps(col0, weight);
+            col1 = _mm_mul_ps(col1, weight);
+            col2 = _mm_mul_ps(col2, weight);
+            col3 = _mm_mul_ps(col3, weight);
+
+            for (uint32_t b = 1; b < MAX_BONE_INFLUENCES; ++b)
+            {
+                const float* m = &bones[srcVert.mBoneIndices[b]][0][0];
+                weight = _mm_set1_ps(srcVert.mBoneWeights[b]);
+                col0 = _mm_add_ps(col0, _mm_mul_ps(_mm_loadu_ps(m + 0), weight));
+                col1 = _mm_add_ps(col1, _mm_mul_ps(_mm_loadu_ps(m + 4), weight));
+                col2 = _mm_add_ps(col2, _mm_mul_ps(_mm_loadu_ps(m + 8), weight));
+                col3 = _mm_add_ps(col3, _mm_mul_ps(_mm_loadu_ps(m + 12), weight));
+            }
+        }
+
+        __m128 pos = _mm_loadu_ps(&params.mPositions[i].x);
+        __m128 nrm = _mm_loadu_ps(&params.mNormals[i].x);
+
+        __m128 outPos = _mm_add_ps(col3, _mm_mul_ps(col0, _mm_shuffle_ps(pos, pos, _MM_SHUFFLE(0, 0, 0, 0))));
+        outPos = _mm_add_ps(outPos, _mm_mul_ps(col1, _mm_shuffle_ps(pos, pos, _MM_SHUFFLE(1, 1, 1, 1))));
+        outPos = _mm_add_ps(outPos, _mm_mul_ps(col2, _mm_shuffle_ps(pos, pos, _MM_SHUFFLE(2, 2, 2, 2))));
+
+        __m128 outNrm = _mm_mul_ps(col0, _mm_shuffle_ps(nrm, nrm, _MM_SHUFFLE(0, 0, 0, 0)));
+        outNrm = _mm_add_ps(outNrm, _mm_mul_ps(col1, _mm_shuffle_ps(nrm, nrm, _MM_SHUFFLE(1, 1, 1, 1))));
+        outNrm = _mm_add_ps(outNrm, _mm_mul_ps(col2, _mm_shuffle_ps(nrm, nrm, _MM_SHUFFLE(2, 2, 2, 2))));
+
+        // A 16 byte store would spill past the vec3, and into the next batch for the last vertex.
+        alignas(16) float result[8];
+        _mm_store_ps(result + 0, outPos);
+        _mm_store_ps(result + 4, outNrm);
+        dstVert.mPosition = glm::vec3(result[0], result[1], result[2]);
+        dstVert.mNormal = glm::vec3(result[4], result[5], result[6]);
+        dstVert.mTexcoord0 = srcVert.mTexcoord0;
+        dstVert.mTexcoord1 = srcVert.mTexcoord1;
+    }
+}
+#endif
+
+void SkinVertices(const SkinningParams& params, uint32_t start, uint32_t end, bool allowSimd)
+{
+    OCT_ASSERT(end <= params.mNumVertices);
+
+#if SIMD_SSE
+    if (allowSimd &&
+        params.mPositions != nullptr &&
+        params.mNormals != nullptr)
+    {
+        SkinVerticesSse(params, start, end);
+        return;
+    }
+#endif
+
+    SkinVerticesScalar(params, start, end);
+}
+
+struct SkinningBatch
+{
+    const SkinningParams* mParams = nullptr;
+    uint32_t mStart = 0;
+    uint32_t mEnd = 0;
+};
+
+static void SkinningJob(void* arg)
+{
+    SkinningBatch* batch = (SkinningBatch*)arg;
+    SkinVertices(*batch->mParams, batch->mStart, batch->mEnd);
+}
+
+void SkinVerticesParallel(const SkinningParams& params)
+{
+    JobSystem* jobSystem = JobSystem::Get();
+    uint32_t numVertices = params.mNumVertices;
+    uint32_t numBatches = (numVertices + kSkinningBatchSize - 1) / kSkinningBatchSize;
+
+    if (jobSystem == nullptr ||
+        jobSystem->GetNumWorkers() == 0 ||
+        numBatches <= 1)
+    {
+        SkinVertices(params, 0, numVertices);
+        return;
+    }
+
+    // Huge meshes get bigger batches instead of more jobs.
+    numBatches = glm::min(numBatches, kMaxSkinningJobs);
+    uint32_t batchSize = (numVertices + numBatches - 1) / numBatches;
+
+    SkinningBatch batches[kMaxSkinningJobs];
+    Job jobs[kMaxSkinningJobs];
+    uint32_t numJobs = 0;
+
+    for (uint32_t start = 0; start < numVertices; start += batchSize)
+    {
+        batches[numJobs].mParams = &params;
+        batches[numJobs].mStart = start;
+        batches[numJobs].mEnd = glm::min(start + batchSize, numVertices);
+        jobs[numJobs].mFunc = SkinningJob;
+        jobs[numJobs].mArg = &batches[numJobs];
+        ++numJobs;
+    }
+
+    jobSystem->RunJobs(jobs, numJobs);
+}
+
+static float MeasureVertsPerMs(const SkinningParams& params, uint32_t iterations, bool simd, bool parallel)
+{
+    uint64_t startTime = SYS_GetTimeMicroseconds();
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        if (parallel)
+        {
+            SkinVerticesParallel(params);
+        }
+        else
+        {
+            SkinVertices(params, 0, params.mNumVertices, simd);
+        }
+    }
+
+    float elapsedMs = float(SYS_GetTimeMicroseconds() - startTime) / 1000.0f;
+    elapsedMs = glm::max(elapsedMs, 0.001f);
+    return float(params.mNumVertices) * float(iterations) / elapsedMs;
+}
+
+void RunSkinningBenchmark(uint32_t numVertices, uint32_t iterations)
+{
+    const uint32_t kNumBones = 64;
+
+    numVertices = glm::max<uint32_t>(numVertices, 1);
+    iterations = glm::max<uint32_t>(iterations, 1);
+
+    // Fixed seed so that runs are comparable.
+    Maths::SeedRand(1);
+
+    std::vector<glm::mat4> bones(kNumBones);
+    for (uint32_t i = 0; i < kNumBones; ++i)
+    {
+        glm::vec3 rotation = Maths::RandRange(glm::vec3(-180.0f), glm::vec3(180.0f));
+        glm::vec3 translation = Maths::RandRange(glm::vec3(-1.0f), glm::vec3(1.0f));
+        bones[i] = MakeTransform(translation, rotation, glm::vec3(1.0f));
+    }
+
+    std::vector<VertexSkinned> vertices(numVertices);
+    std::vector<glm::vec4> positions(numVertices);
+    std::vector<glm::vec4> normals(numVertices);
+    std::vector<Vertex> outVertices(numVertices);
+
+    for (uint32_t i = 0; i < numVertices; ++i)
+    {
+        VertexSkinned& vert = vertices[i];
+        vert.mPosition = Maths::RandRange(glm::vec3(-1.0f), glm::vec3(1.0f));
+        vert.mNormal = glm::normalize(Maths::RandRange(glm::vec3(-1.0f), glm::vec3(1.0f)) + glm::vec3(0.0f, 0.0f, 0.01f));
+        vert.mTexcoord0 = { 0.0f, 0.0f };
+        vert.mTexcoord1 = { 0.0f, 0.0f };
+
+        float totalWeight = 0.0f;
+        for (uint32_t b = 0; b < MAX_BONE_INFLUENCES; ++b)
+        {
+            vert.mBoneIndices[b] = uint8_t(Maths::RandRange(0.0f, float(kNumBones - 1)));
+            vert.mBoneWeights[b] = Maths::RandRange(0.1f, 1.0f);
+            totalWeight += vert.mBoneWeights[b];
+        }
+
+        for (uint32_t b = 0; b < MAX_BONE_INFLUENCES; ++b)
+        {
+            vert.mBoneWeights[b] /= totalWeight;
+        }
+
+        positions[i] = glm::vec4(vert.mPosition, 1.0f);
+        normals[i] = glm::vec4(vert.mNormal, 0.0f);
+    }
+
+    SkinningParams params;
+    params.mBoneMatrices = bones.data();
+    params.mVertices = vertices.data();
+    params.mPositions = positions.data();
+    params.mNormals = normals.data();
+    params.mOutVertices = outVertices.data();
+    params.mNumVertices = numVertices;
+    params.mNumInfluences = MAX_BONE_INFLUENCES;
+
+    // Warm up the caches and the worker threads.
+    SkinVerticesParallel(params);
+
+    float scalarRate = MeasureVertsPerMs(params, iterations, false, false);
+    float simdRate = MeasureVertsPerMs(params, iterations, true, false);
+    float parallelRate = MeasureVertsPerMs(params, iterations, true, true);
+
+    JobSystem* jobSystem = JobSystem::Get();
+    uint32_t numWorkers = (jobSystem != nullptr) ? jobSystem->GetNumWorkers() : 0;
+
+    LogDebug("---- Skinning Benchmark (%u verts, %u iterations, %u workers, SSE %s) ----",
+        numVertices, iterations, numWorkers, SIMD_SSE ? "on" : "off");
+    LogDebug("Scalar: %.0f verts/ms  SIMD: %.0f verts/ms  Parallel: %.0f verts/ms", scalarRate, simdRate, parallelRate);
+
+    FILE* benchFile = fopen("SkinBench.csv", "w");
+
+    if (benchFile != nullptr)
+    {
+        fprintf(benchFile, "Vertices, %u\n", numVertices);
+        fprintf(benchFile, "Iterations, %u\n", iterations);
+        fprintf(benchFile, "Workers, %u\n", numWorkers);
+        fprintf(benchFile, "Sse, %d\n", SIMD_SSE);
+        fprintf(benchFile, "ScalarVertsPerMs, %f\n", scalarRate);
+        fprintf(benchFile, "SimdVertsPerMs, %f\n", simdRate);
+        fprintf(benchFile, "ParallelVertsPerMs, %f\n", parallelRate);
+        fclose(benchFile);
+    }
+    else
+    {
+        LogError("Failed to write SkinBench.csv");
+    }
+}
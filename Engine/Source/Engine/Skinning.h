@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Constants.h"
+#include "Maths.h"
+#include "Vertex.h"
+
+// Everything the CPU skinning kernel reads and writes. Positions and normals come from the
+// mesh's skinning streams (see SkeletalMesh::GetSkinningPositions()), which store them as
+// padded vec4s in their own arrays so each one is a single SIMD load. Bone indices, weights
+// and texcoords are still read from the interleaved source vertices.
+struct SkinningParams
+{
+    const glm::mat4* mBoneMatrices = nullptr;
+    const VertexSkinned* mVertices = nullptr;
+    const glm::vec4* mPositions = nullptr;
+    const glm::vec4* mNormals = nullptr;
+    Vertex* mOutVertices = nullptr;
+    uint32_t mNumVertices = 0;
+    uint32_t mNumInfluences = MAX_BONE_INFLUENCES; // 1 or MAX_BONE_INFLUENCES
+};
+
+// Skins vertices [start, end). Uses the SSE kernel when available unless allowSimd is false.
+void SkinVertices(const SkinningParams& params, uint32_t start, uint32_t end, bool allowSimd = true);
+
+// Skins every vertex, splitting large meshes into batches that run on the job system.
+void SkinVerticesParallel(const SkinningParams& params);
+
+// Skins a synthetic mesh with the scalar, SIMD and parallel paths, then logs vertices
+// skinned per millisecond for each and writes them to SkinBench.csv.
+void RunSkinningBenchmark(uint32_t numVertices, uint32_t iterations);
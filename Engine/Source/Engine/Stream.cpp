@@ -9,11 +9,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <unordered_set>
+#include <mutex>
 
 #define ACQUIRE_FILE_DIRECTLY 1
 
-// Track UUIDs we've already warned about to reduce log spam
+// Track UUIDs we've already warned about to reduce log spam.
+// Assets are read on several async load threads, so the set is guarded.
 static std::unordered_set<uint64_t> sWarnedUuids;
+static std::mutex sWarnedUuidsMutex;
+
+static bool ShouldWarnAboutUuid(uint64_t uuid)
+{
+    std::lock_guard<std::mutex> lock(sWarnedUuidsMutex);
+    return sWarnedUuids.insert(uuid).second;
+}
 
 #define MAX_FILE_SIZE (1024 * 1024 * 1024)
 #define MAX_STRING_SIZE (1024 * 16)
@@ -215,12 +224,8 @@ void Stream::ReadAsset(AssetRef& asset)
         }
         else if (mAsyncRequest != nullptr)
         {
-            Asset* reqAsset = FetchAsset(assetName);
-            if (reqAsset != nullptr)
-            {
-                asset = reqAsset;
-            }
-            else
+            // Takes the ref under the asset manager lock so the sweep can't unload it first.
+            if (!AssetManager::Get()->FetchAssetRef(assetName, asset))
             {
                 AssetStub* stub = AssetManager::Get()->GetAssetStub(assetName);
                 if (stub != nullptr)
@@ -268,12 +273,7 @@ void Stream::ReadAsset(AssetRef& asset)
             }
             else if (mAsyncRequest != nullptr)
             {
-                Asset* reqAsset = FetchAsset(assetName);
-                if (reqAsset != nullptr)
-                {
-                    asset = reqAsset;
-                }
-                else
+                if (!AssetManager::Get()->FetchAssetRef(assetName, asset))
                 {
                     AssetStub* stub = AssetManager::Get()->GetAssetStub(assetName);
                     if (stub != nullptr)
@@ -322,21 +322,15 @@ void Stream::ReadAsset(AssetRef& asset)
             }
             else if (mAsyncRequest != nullptr)
             {
-                Asset* reqAsset = FetchAssetByUuid(uuid);
-                if (reqAsset != nullptr)
-                {
-                    asset = reqAsset;
-                }
-                else
+                if (!AssetManager::Get()->FetchAssetRefByUuid(uuid, asset))
                 {
                     AssetStub* stub = AssetManager::Get()->GetAssetStubByUuid(uuid);
                     if (stub == nullptr && !assetName.empty())
                     {
                         // Fallback to name-based lookup if UUID not found (version 13+)
                         stub = AssetManager::Get()->GetAssetStub(assetName);
-                        if (stub != nullptr && sWarnedUuids.find(uuid) == sWarnedUuids.end())
+                        if (stub != nullptr && ShouldWarnAboutUuid(uuid))
                         {
-                            sWarnedUuids.insert(uuid);
                             LogWarning("Asset UUID 0x%llx not found, falling back to name: %s", (unsigned long long)uuid, assetName.c_str());
                         }
                     }
@@ -364,9 +358,8 @@ void Stream::ReadAsset(AssetRef& asset)
                             mAsyncRequest->mDependentAssets.push_back(stub);
                         }
                     }
-                    else if (sWarnedUuids.find(uuid) == sWarnedUuids.end())
+                    else if (ShouldWarnAboutUuid(uuid))
                     {
-                        sWarnedUuids.insert(uuid);
                         LogWarning("Could not find asset with UUID 0x%llx%s", (unsigned long long)uuid,
                             assetName.empty() ? "" : (std::string(" or name '") + assetName + "'").c_str());
                     }
@@ -381,18 +374,16 @@ void Stream::ReadAsset(AssetRef& asset)
                     asset = LoadAsset(assetName);
 
                     // Only warn once per UUID to reduce log spam
-                    if (sWarnedUuids.find(uuid) == sWarnedUuids.end())
+                    if (ShouldWarnAboutUuid(uuid))
                     {
-                        sWarnedUuids.insert(uuid);
                         LogWarning("Asset UUID 0x%llx not found, falling back to name: %s", (unsigned long long)uuid, assetName.c_str());
                     }
                 }
                 else if (asset == nullptr)
                 {
                     // Only warn once per UUID
-                    if (sWarnedUuids.find(uuid) == sWarnedUuids.end())
+                    if (ShouldWarnAboutUuid(uuid))
                     {
-                        sWarnedUuids.insert(uuid);
                         LogWarning("Could not find asset with UUID 0x%llx", (unsigned long long)uuid);
                     }
                 }
@@ -514,6 +505,23 @@ void Stream::WriteBytes(const uint8_t* src, uint32_t length)
     }
 }
 
+void Stream::AlignRead(uint32_t alignment)
+{
+    uint32_t alignedPos = (mPos + alignment - 1) / alignment * alignment;
+    OCT_ASSERT(alignedPos <= mSize);
+    mPos = alignedPos;
+}
+
+void Stream::AlignWrite(uint32_t alignment)
+{
+    uint32_t alignedPos = (mPos + alignment - 1) / alignment * alignment;
+
+    while (mPos < alignedPos)
+    {
+        WriteUint8(0);
+    }
+}
+
 int32_t Stream::ReadInt32()
 {
     int32_t ret = 0;
@@ -51,6 +51,10 @@ public:
 
     uint32_t ReadBytesMax(uint8_t* dst, uint32_t length);
 
+    // Skip (or zero pad) to the next multiple of alignment from the start of the stream.
+    void AlignRead(uint32_t alignment);
+    void AlignWrite(uint32_t alignment);
+
     int32_t ReadInt32();
     uint32_t ReadUint32();
     int64_t ReadInt64();
@@ -3,6 +3,7 @@
 #include "Constants.h"
 #include "Renderer.h"
 #include "Profiler.h"
+#include "JobSystem.h"
 #include "Utilities.h"
 #include "AudioManager.h"
 #include "AssetManager.h"
@@ -15,6 +16,7 @@
 #include "Nodes/3D/NavMesh3d.h"
 #include "Nodes/3D/PointLight3d.h"
 #include "Nodes/3D/Particle3d.h"
+#include "Nodes/3D/SkeletalMesh3d.h"
 #include "Nodes/3D/Audio3d.h"
 
 #if EDITOR
@@ -41,6 +43,10 @@
 
 using namespace std;
 
+static const SignalId sOnCollisionSignal = InternSignal("OnCollision");
+static const SignalId sBeginOverlapSignal = InternSignal("BeginOverlap");
+static const SignalId sEndOverlapSignal = InternSignal("EndOverlap");
+
 namespace
 {
     struct RecastNavData
@@ -638,15 +644,25 @@ Node* World::FindNode(const std::string& name)
 {
     Node* ret = nullptr;
 
-    if (mRootNode != nullptr)
+    auto it = mNameIndex.find(name);
+    if (it != mNameIndex.end() &&
+        it->second.size() > 0)
     {
-        if (mRootNode->GetName() == name)
+        if (it->second.size() == 1)
         {
-            ret = mRootNode.Get();
+            ret = it->second[0];
         }
-        else
+        else if (mRootNode != nullptr)
         {
-            ret = mRootNode->FindChild(name, true);
+            // With duplicate names, search the tree so the match is the same one a full search finds.
+            if (mRootNode->GetName() == name)
+            {
+                ret = mRootNode.Get();
+            }
+            else
+            {
+                ret = mRootNode->FindChild(name, true);
+            }
         }
     }
 
@@ -670,45 +686,76 @@ Node* World::GetNetNode(NetId netId)
 std::vector<Node*> World::FindNodesWithTag(const char* tag)
 {
     std::vector<Node*> retNodes;
+    FindNodesWithTag(tag, retNodes);
+    return retNodes;
+}
 
-    if (mRootNode != nullptr)
+std::vector<Node*> World::FindNodesWithName(const char* name)
+{
+    std::vector<Node*> retNodes;
+    FindNodesWithName(name, retNodes);
+    return retNodes;
+}
+
+void World::SortNodesByTreeOrder(std::vector<Node*>& nodes, size_t start)
+{
+    if (nodes.size() - start <= 1)
+        return;
+
+    // Renumber the tree once after it changes, so sorting doesn't have to walk up from each node.
+    if (mTreeOrderDirty)
     {
-        auto gatherNodesWithTag = [&](Node* node) -> bool
-        {
-            if (node->HasTag(tag))
-            {
-                retNodes.push_back(node);
-            }
+        uint32_t order = 0;
 
-            return true;
-        };
+        if (mRootNode != nullptr)
+        {
+            mRootNode->Traverse([&](Node* node) -> bool
+                {
+                    node->SetTreeOrder(order++);
+                    return true;
+                });
+        }
 
-        mRootNode->Traverse(gatherNodesWithTag);
+        mTreeOrderDirty = false;
     }
 
-    return retNodes;
+    std::sort(nodes.begin() + start, nodes.end(), [](const Node* a, const Node* b)
+        {
+            return a->GetTreeOrder() < b->GetTreeOrder();
+        });
 }
 
-std::vector<Node*> World::FindNodesWithName(const char* name)
+void World::FindNodesWithTag(const char* tag, std::vector<Node*>& outNodes)
 {
-    std::vector<Node*> retNodes;
-
-    if (mRootNode != nullptr)
+    auto it = mTagIndex.find(tag);
+    if (it != mTagIndex.end())
     {
-        auto gatherNodesWithName = [&](Node* node) -> bool
+        const std::vector<Node*>& bucket = it->second;
+        size_t start = outNodes.size();
+        outNodes.reserve(start + bucket.size());
+
+        for (uint32_t i = 0; i < bucket.size(); ++i)
         {
-            if (node->GetName() == name)
+            // The Tags property can shrink without notifying us, so confirm the tag is still there.
+            if (bucket[i]->HasTag(it->first))
             {
-                retNodes.push_back(node);
+                outNodes.push_back(bucket[i]);
             }
+        }
 
-            return true;
-        };
-
-        mRootNode->Traverse(gatherNodesWithName);
+        SortNodesByTreeOrder(outNodes, start);
     }
+}
 
-    return retNodes;
+void World::FindNodesWithName(const char* name, std::vector<Node*>& outNodes)
+{
+    auto it = mNameIndex.find(name);
+    if (it != mNameIndex.end())
+    {
+        size_t start = outNodes.size();
+        outNodes.insert(outNodes.end(), it->second.begin(), it->second.end());
+        SortNodesByTreeOrder(outNodes, start);
+    }
 }
 
 std::vector<Node*> World::GatherNodes()
@@ -1020,18 +1067,26 @@ btDbvtBroadphase* World::GetBroadphase()
 
 void World::PurgeOverlaps(Primitive3D* prim)
 {
-    for (int32_t i = (int32_t)mCurrentOverlaps.size() - 1; i >= 0; --i)
+    // Gather first, since EndOverlap() may end up modifying the overlap set.
+    std::vector<PrimitivePair> purgedOverlaps;
+
+    for (int32_t i = (int32_t)mCurrentOverlapList.size() - 1; i >= 0; --i)
     {
-        Primitive3D* primA = mCurrentOverlaps[i].mPrimitiveA;
-        Primitive3D* primB = mCurrentOverlaps[i].mPrimitiveB;
+        const PrimitivePair& pair = mCurrentOverlapList[i];
 
-        if (primA == prim ||
-            primB == prim)
+        if (pair.mPrimitiveA == prim ||
+            pair.mPrimitiveB == prim)
         {
-            primA->EndOverlap(primA, primB);
-            mCurrentOverlaps.erase(mCurrentOverlaps.begin() + i);
+            purgedOverlaps.push_back(pair);
+            mCurrentOverlaps.erase(pair);
+            mCurrentOverlapList.erase(mCurrentOverlapList.begin() + i);
         }
     }
+
+    for (const PrimitivePair& pair : purgedOverlaps)
+    {
+        pair.mPrimitiveA->EndOverlap(pair.mPrimitiveA, pair.mPrimitiveB);
+    }
 }
 
 void World::RayTest(glm::vec3 start, glm::vec3 end, uint8_t collisionMask, RayTestResult& outResult, uint32_t numIgnoredObjects, btCollisionObject** ignoreObjects, bool ignorePureOverlap)
@@ -1166,8 +1221,18 @@ void World::SweepTest(
     }
 }
 
+// Skeletal meshes and particles are animated/simulated as part of culling, so the renderer
+// gathers them directly from their lists. Every other primitive goes in the bounds tree.
+static bool UsesPrimitiveTree(Primitive3D* prim)
+{
+    return (prim->As<SkeletalMesh3D>() == nullptr &&
+        prim->As<Particle3D>() == nullptr);
+}
+
 void World::RegisterNode(Node* node, bool subRoot)
 {
+    mTreeOrderDirty = true;
+
     if (mAutoNavRebuild && node && (node->As<StaticMesh3D>() != nullptr || node->As<NavMesh3D>() != nullptr))
     {
         InvalidateWorldNavCache(this);
@@ -1190,6 +1255,15 @@ void World::RegisterNode(Node* node, bool subRoot)
         OCT_ASSERT(std::find(mLights.begin(), mLights.end(), (Light3D*)node) == mLights.end());
 #endif
         mLights.push_back((Light3D*)node);
+
+        if (((Light3D*)node)->IsPointLight3D())
+        {
+            MarkLightBoundsDirty((PointLight3D*)node);
+        }
+        else
+        {
+            mDirectionalLights.push_back((Light3D*)node);
+        }
     }
     else if (nodeType == Camera3D::GetStaticType())
     {
@@ -1199,6 +1273,38 @@ void World::RegisterNode(Node* node, bool subRoot)
             mActiveCamera = node->As<Camera3D>();
         }
     }
+    else if (node->As<SkeletalMesh3D>() != nullptr)
+    {
+        mSkeletalMeshes.push_back((SkeletalMesh3D*)node);
+    }
+    else if (node->As<Particle3D>() != nullptr)
+    {
+        mParticles.push_back((Particle3D*)node);
+    }
+    else if (node->IsWidget())
+    {
+        mNumWidgets++;
+    }
+
+    if (node->IsParallelTickSafe())
+    {
+        mNumParallelTickNodes++;
+    }
+
+    if (node->IsNode3D() &&
+        static_cast<Node3D*>(node)->IsTransformDirty())
+    {
+        QueueTransformUpdate(static_cast<Node3D*>(node));
+    }
+
+    if (node->IsPrimitive3D() &&
+        UsesPrimitiveTree((Primitive3D*)node))
+    {
+        MarkPrimitiveBoundsDirty((Primitive3D*)node);
+    }
+
+    AddToNameIndex(node, node->GetName());
+    node->UpdateTagIndex();
 
     if (subRoot)
     {
@@ -1208,6 +1314,8 @@ void World::RegisterNode(Node* node, bool subRoot)
 
 void World::UnregisterNode(Node* node, bool subRoot)
 {
+    mTreeOrderDirty = true;
+
     if (mAutoNavRebuild && node && (node->As<StaticMesh3D>() != nullptr || node->As<NavMesh3D>() != nullptr))
     {
         InvalidateWorldNavCache(this);
@@ -1226,6 +1334,79 @@ void World::UnregisterNode(Node* node, bool subRoot)
         auto it = std::find(mLights.begin(), mLights.end(), (Light3D*)node);
         OCT_ASSERT(it != mLights.end());
         mLights.erase(it);
+
+        if (((Light3D*)node)->IsPointLight3D())
+        {
+            PointLight3D* pointLight = (PointLight3D*)node;
+            mLightTree.Remove(pointLight);
+
+            if (pointLight->IsLightBoundsDirty())
+            {
+                auto dirtyIt = std::find(mDirtyLights.begin(), mDirtyLights.end(), pointLight);
+                OCT_ASSERT(dirtyIt != mDirtyLights.end());
+                mDirtyLights.erase(dirtyIt);
+                pointLight->SetLightBoundsDirty(false);
+            }
+        }
+        else
+        {
+            auto dirIt = std::find(mDirectionalLights.begin(), mDirectionalLights.end(), (Light3D*)node);
+            OCT_ASSERT(dirIt != mDirectionalLights.end());
+            mDirectionalLights.erase(dirIt);
+        }
+    }
+
+    else if (node->As<SkeletalMesh3D>() != nullptr)
+    {
+        auto it = std::find(mSkeletalMeshes.begin(), mSkeletalMeshes.end(), (SkeletalMesh3D*)node);
+        OCT_ASSERT(it != mSkeletalMeshes.end());
+        mSkeletalMeshes.erase(it);
+    }
+    else if (node->As<Particle3D>() != nullptr)
+    {
+        auto it = std::find(mParticles.begin(), mParticles.end(), (Particle3D*)node);
+        OCT_ASSERT(it != mParticles.end());
+        mParticles.erase(it);
+    }
+    else if (node->IsWidget())
+    {
+        OCT_ASSERT(mNumWidgets > 0);
+        mNumWidgets--;
+    }
+
+    if (node->IsParallelTickSafe())
+    {
+        OCT_ASSERT(mNumParallelTickNodes > 0);
+        mNumParallelTickNodes--;
+    }
+
+    if (node->IsNode3D() &&
+        static_cast<Node3D*>(node)->IsTransformQueued())
+    {
+        Node3D* node3d = static_cast<Node3D*>(node);
+        uint32_t index = node3d->GetTransformQueueIndex();
+        OCT_ASSERT(index < mDirtyTransforms.size() && mDirtyTransforms[index] == node3d);
+        mDirtyTransforms[index] = mDirtyTransforms.back();
+        mDirtyTransforms[index]->SetTransformQueueIndex(index);
+        mDirtyTransforms.pop_back();
+        node3d->SetTransformQueued(false);
+    }
+
+    if (node->IsPrimitive3D())
+    {
+        Primitive3D* prim = (Primitive3D*)node;
+        mPrimitiveTree.Remove(prim);
+
+        if (prim->IsRenderBoundsDirty())
+        {
+            // Order doesn't matter for the dirty list, so swap the last entry into this slot.
+            uint32_t index = prim->GetDirtyBoundsIndex();
+            OCT_ASSERT(index < mDirtyPrimitives.size() && mDirtyPrimitives[index] == prim);
+            mDirtyPrimitives[index] = mDirtyPrimitives.back();
+            mDirtyPrimitives[index]->SetDirtyBoundsIndex(index);
+            mDirtyPrimitives.pop_back();
+            prim->SetRenderBoundsDirty(false);
+        }
     }
 
     if (node == mAudioReceiver)
@@ -1238,6 +1419,9 @@ void World::UnregisterNode(Node* node, bool subRoot)
         SetActiveCamera(nullptr);
     }
 
+    RemoveFromNameIndex(node, node->GetName());
+    node->ClearTagIndex();
+
     if (subRoot)
     {
         sNewlyRegisteredNodes.erase(ResolveWeakPtr(node));
@@ -1249,6 +1433,448 @@ const std::vector<Audio3D*>& World::GetAudios() const
     return mAudios;
 }
 
+const std::vector<SkeletalMesh3D*>& World::GetSkeletalMeshes() const
+{
+    return mSkeletalMeshes;
+}
+
+const std::vector<Particle3D*>& World::GetParticles() const
+{
+    return mParticles;
+}
+
+uint32_t World::GetNumWidgets() const
+{
+    return mNumWidgets;
+}
+
+static void AddToIndex(std::unordered_map<std::string, std::vector<Node*>>& index, Node* node, const std::string& key)
+{
+    std::vector<Node*>& bucket = index[key];
+#if _DEBUG
+    OCT_ASSERT(std::find(bucket.begin(), bucket.end(), node) == bucket.end());
+#endif
+    bucket.push_back(node);
+}
+
+static void RemoveFromIndex(std::unordered_map<std::string, std::vector<Node*>>& index, Node* node, const std::string& key)
+{
+    auto it = index.find(key);
+    OCT_ASSERT(it != index.end());
+
+    if (it != index.end())
+    {
+        std::vector<Node*>& bucket = it->second;
+        auto nodeIt = std::find(bucket.begin(), bucket.end(), node);
+        OCT_ASSERT(nodeIt != bucket.end());
+
+        if (nodeIt != bucket.end())
+        {
+            // Lookups order their results by tree position, so the bucket order doesn't matter.
+            *nodeIt = bucket.back();
+            bucket.pop_back();
+        }
+
+        if (bucket.empty())
+        {
+            index.erase(it);
+        }
+    }
+}
+
+void World::AddToNameIndex(Node* node, const std::string& name)
+{
+    AddToIndex(mNameIndex, node, name);
+}
+
+void World::RemoveFromNameIndex(Node* node, const std::string& name)
+{
+    RemoveFromIndex(mNameIndex, node, name);
+}
+
+void World::AddToTagIndex(Node* node, const std::string& tag)
+{
+    AddToIndex(mTagIndex, node, tag);
+}
+
+void World::RemoveFromTagIndex(Node* node, const std::string& tag)
+{
+    RemoveFromIndex(mTagIndex, node, tag);
+}
+
+void World::QueueTransformUpdate(Node3D* node)
+{
+    // Parallel-safe nodes may move themselves from worker threads.
+    std::unique_lock<std::mutex> lock(mParallelTickMutex, std::defer_lock);
+    if (mParallelTicking)
+    {
+        lock.lock();
+    }
+
+    if (!node->IsTransformQueued())
+    {
+        node->SetTransformQueued(true);
+        node->SetTransformQueueIndex(uint32_t(mDirtyTransforms.size()));
+        mDirtyTransforms.push_back(node);
+    }
+}
+
+void World::MarkPrimitiveBoundsDirty(Primitive3D* prim)
+{
+    std::unique_lock<std::mutex> lock(mParallelTickMutex, std::defer_lock);
+    if (mParallelTicking)
+    {
+        lock.lock();
+    }
+
+    if (!prim->IsRenderBoundsDirty())
+    {
+        if (UsesPrimitiveTree(prim))
+        {
+            prim->SetRenderBoundsDirty(true);
+            prim->SetDirtyBoundsIndex(uint32_t(mDirtyPrimitives.size()));
+            mDirtyPrimitives.push_back(prim);
+        }
+    }
+}
+
+void World::UpdatePrimitiveTree()
+{
+    SCOPED_FRAME_STAT("BoundsTree");
+
+    // Iterate by index because updating a primitive's transform will dirty its children,
+    // which may append more primitives to the list.
+    for (uint32_t i = 0; i < mDirtyPrimitives.size(); ++i)
+    {
+        Primitive3D* prim = mDirtyPrimitives[i];
+        prim->UpdateTransform(false);
+        prim->SetRenderBoundsDirty(false);
+        mPrimitiveTree.Update(prim, prim->GetBounds());
+    }
+
+    mDirtyPrimitives.clear();
+}
+
+const BoundsTree& World::GetPrimitiveTree() const
+{
+    return mPrimitiveTree;
+}
+
+void World::MarkLightBoundsDirty(PointLight3D* light)
+{
+    std::unique_lock<std::mutex> lock(mParallelTickMutex, std::defer_lock);
+    if (mParallelTicking)
+    {
+        lock.lock();
+    }
+
+    if (!light->IsLightBoundsDirty())
+    {
+        light->SetLightBoundsDirty(true);
+        mDirtyLights.push_back(light);
+    }
+}
+
+void World::UpdateLightTree()
+{
+    for (uint32_t i = 0; i < mDirtyLights.size(); ++i)
+    {
+        PointLight3D* light = mDirtyLights[i];
+        light->UpdateTransform(false);
+        light->SetLightBoundsDirty(false);
+
+        Bounds bounds;
+        bounds.mCenter = light->GetWorldPosition();
+        bounds.mRadius = light->GetRadius();
+        mLightTree.Update(light, bounds);
+    }
+
+    mDirtyLights.clear();
+}
+
+const BoundsTree& World::GetLightTree() const
+{
+    return mLightTree;
+}
+
+const std::vector<Light3D*>& World::GetDirectionalLights() const
+{
+    return mDirectionalLights;
+}
+
+static uint32_t GetNodeDepth(Node* node)
+{
+    uint32_t depth = 0;
+    Node* parent = node->GetParent();
+
+    while (parent != nullptr)
+    {
+        depth++;
+        parent = parent->GetParent();
+    }
+
+    return depth;
+}
+
+void World::UpdateDirtyTransforms()
+{
+    struct DirtyTransform
+    {
+        uint32_t mDepth;
+        Node3D* mNode;
+    };
+
+    static std::vector<DirtyTransform> sDirtyTransforms;
+
+    // Updating a node marks its children dirty, which queues them up again.
+    // Keep going until no more nodes have been queued.
+    while (mDirtyTransforms.size() > 0)
+    {
+        sDirtyTransforms.clear();
+
+        for (uint32_t i = 0; i < mDirtyTransforms.size(); ++i)
+        {
+            sDirtyTransforms.push_back({ GetNodeDepth(mDirtyTransforms[i]), mDirtyTransforms[i] });
+        }
+
+        mDirtyTransforms.clear();
+
+        // Update parents before children so that each child only recomputes its transform once.
+        std::sort(sDirtyTransforms.begin(), sDirtyTransforms.end(),
+            [](const DirtyTransform& l, const DirtyTransform& r)
+            {
+                return l.mDepth < r.mDepth;
+            });
+
+        for (uint32_t i = 0; i < sDirtyTransforms.size(); ++i)
+        {
+            Node3D* node3d = sDirtyTransforms[i].mNode;
+            node3d->SetTransformQueued(false);
+
+            if (node3d->IsTransformDirty())
+            {
+                node3d->UpdateTransform(false);
+            }
+        }
+    }
+}
+
+static thread_local bool sParallelTickThread = false;
+
+bool World::IsParallelTickThread()
+{
+    return sParallelTickThread;
+}
+
+struct ParallelTickGroup
+{
+    // Indices into the tick list, since serial nodes that tick first may destroy nodes in the group.
+    std::vector<uint32_t> mNodes;
+    const std::vector<NodePtrWeak>* mTickList = nullptr;
+    World* mWorld = nullptr;
+    float mDeltaTime = 0.0f;
+};
+
+static void ParallelTickJob(void* arg)
+{
+    SCOPED_FRAME_STAT("TickGroup");
+    ParallelTickGroup* group = (ParallelTickGroup*)arg;
+
+    // The main thread helps run these jobs too, so the flag is per job rather than per worker.
+    sParallelTickThread = true;
+
+    for (uint32_t i = 0; i < group->mNodes.size(); ++i)
+    {
+        Node* node = (*group->mTickList)[group->mNodes[i]].Get();
+
+        if (node != nullptr &&
+            node->GetWorld() == group->mWorld)
+        {
+            node->Tick(group->mDeltaTime);
+        }
+    }
+
+    sParallelTickThread = false;
+}
+
+static void TickSerialNode(World* world, Node* node, uint32_t currentFrame, float deltaTime, bool gameTickEnabled)
+{
+    // Node may have been destroyed or removed from the world
+    if (node &&
+        node->GetWorld() == world &&
+        node->GetLastTickedFrame() != currentFrame)
+    {
+        if (gameTickEnabled)
+        {
+            node->Tick(deltaTime);
+        }
+        else
+        {
+            node->EditorTick(deltaTime);
+        }
+    }
+}
+
+static void TickSerialNodes(World* world, const std::vector<NodePtrWeak>& nodes, const std::vector<uint32_t>& indices, float deltaTime)
+{
+    uint32_t currentFrame = GetEngineState()->mFrameNumber;
+
+    for (uint32_t i = 0; i < indices.size(); ++i)
+    {
+        TickSerialNode(world, nodes[indices[i]].Get(), currentFrame, deltaTime, true);
+    }
+}
+
+void World::TickNodes(const std::vector<NodePtrWeak>& nodes, float deltaTime, bool gameTickEnabled)
+{
+    JobSystem* jobSystem = JobSystem::Get();
+
+    // Only split the tick list into phases when some node in the world has opted in.
+    if (gameTickEnabled &&
+        mNumParallelTickNodes > 0 &&
+        jobSystem != nullptr &&
+        jobSystem->GetNumWorkers() > 0)
+    {
+        TickNodesParallel(nodes, deltaTime);
+        return;
+    }
+
+    uint32_t currentFrame = GetEngineState()->mFrameNumber;
+
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        TickSerialNode(this, nodes[i].Get(), currentFrame, deltaTime, gameTickEnabled);
+    }
+}
+
+void World::TickNodesParallel(const std::vector<NodePtrWeak>& nodes, float deltaTime)
+{
+    uint32_t currentFrame = GetEngineState()->mFrameNumber;
+
+    // Values in sPhaseMap that aren't a parallel group index.
+    const uint32_t kPreParallel = 0xffffffff;
+    const uint32_t kPostParallel = 0xfffffffe;
+
+    static std::vector<uint32_t> sPreNodes;
+    static std::vector<uint32_t> sPostNodes;
+    static std::vector<ParallelTickGroup> sParallelGroups;
+    static std::unordered_map<Node*, uint32_t> sPhaseMap;
+    uint32_t numGroups = 0;
+
+    sPreNodes.clear();
+    sPostNodes.clear();
+    sPhaseMap.clear();
+
+    // Serial nodes tick in their usual order either before or after the parallel groups, so that
+    // every node still ticks after its ancestors. A parallel node joins its nearest ticking ancestor's
+    // group, or starts a new group if that ancestor ticks before the parallel phase. Anything below a
+    // node that ticks after the parallel phase also ticks after it, and so do late tick nodes.
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        Node* node = nodes[i].Get();
+
+        if (node == nullptr ||
+            node->GetWorld() != this ||
+            node->GetLastTickedFrame() == currentFrame)
+        {
+            continue;
+        }
+
+        // Late tick parents come after their children in the list, so they are skipped here.
+        uint32_t parentPhase = kPreParallel;
+        for (Node* parent = node->GetParent(); parent != nullptr; parent = parent->GetParent())
+        {
+            auto it = sPhaseMap.find(parent);
+            if (it != sPhaseMap.end())
+            {
+                parentPhase = it->second;
+                break;
+            }
+        }
+
+        uint32_t phase = kPreParallel;
+
+        if (node->IsLateTickEnabled() || parentPhase == kPostParallel)
+        {
+            phase = kPostParallel;
+        }
+        else if (node->CanTickInParallel())
+        {
+            if (parentPhase == kPreParallel)
+            {
+                phase = numGroups++;
+
+                if (sParallelGroups.size() < numGroups)
+                {
+                    sParallelGroups.resize(numGroups);
+                }
+
+                sParallelGroups[phase].mNodes.clear();
+                sParallelGroups[phase].mTickList = &nodes;
+                sParallelGroups[phase].mWorld = this;
+                sParallelGroups[phase].mDeltaTime = deltaTime;
+            }
+            else
+            {
+                phase = parentPhase;
+            }
+
+            sParallelGroups[phase].mNodes.push_back(i);
+        }
+        else if (parentPhase != kPreParallel)
+        {
+            phase = kPostParallel;
+        }
+
+        if (phase == kPreParallel)
+        {
+            sPreNodes.push_back(i);
+        }
+        else if (phase == kPostParallel)
+        {
+            sPostNodes.push_back(i);
+        }
+
+        sPhaseMap.insert({ node, phase });
+    }
+
+    if (numGroups == 0)
+    {
+        // None of the opted in nodes could tick in parallel this frame (e.g. they have scripts),
+        // so tick everything in the usual order instead of moving late tick nodes to the end.
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            TickSerialNode(this, nodes[i].Get(), currentFrame, deltaTime, true);
+        }
+
+        return;
+    }
+
+    TickSerialNodes(this, nodes, sPreNodes, deltaTime);
+
+    {
+        SCOPED_FRAME_STAT("ParallelTick");
+
+        // Flush pending transform updates so that nodes outside of a group are only read during the jobs.
+        UpdateDirtyTransforms();
+
+        static std::vector<Job> sJobs;
+        sJobs.resize(numGroups);
+
+        for (uint32_t i = 0; i < numGroups; ++i)
+        {
+            sJobs[i].mFunc = ParallelTickJob;
+            sJobs[i].mArg = &sParallelGroups[i];
+        }
+
+        mParallelTicking = true;
+        JobSystem::Get()->RunJobs(sJobs.data(), numGroups);
+        mParallelTicking = false;
+    }
+
+    TickSerialNodes(this, nodes, sPostNodes, deltaTime);
+}
+
 void World::UpdateLines(float deltaTime)
 {
     for (int32_t i = (int32_t)mLines.size() - 1; i >= 0; --i)
@@ -1299,6 +1925,11 @@ void World::Update(float deltaTime)
         SetRootNode(mQueuedRootNode.Get());
 
         mQueuedRootNode.Reset();
+
+#if !EDITOR
+        // Unload what the old level was using a little at a time instead of in one hitch.
+        AssetManager::Get()->RefSweep(false);
+#endif
     }
 
     // Ensure world root node is set to replicate. (Otherwise clients will see nothing)
@@ -1328,8 +1959,10 @@ void World::Update(float deltaTime)
             mCollisionDispatcher);
 
         // Update collisions
-        mPreviousOverlaps = mCurrentOverlaps;
+        mPreviousOverlaps.swap(mCurrentOverlaps);
         mCurrentOverlaps.clear();
+        mPreviousOverlapList.swap(mCurrentOverlapList);
+        mCurrentOverlapList.clear();
 
         // Check the number of manifolds each loop iteration, since an overlap/collision callbacks
         // may reduce the number of manifolds if an collision object gets removed from the dynamics world.
@@ -1377,39 +2010,73 @@ void World::Update(float deltaTime)
                 prim0->OnCollision(prim0, prim1, avgContactPoint0, avgNormal, manifold);
                 prim1->OnCollision(prim1, prim0, avgContactPoint1, -avgNormal, manifold);
 
-                prim0->EmitSignal("OnCollision", {prim0, prim1, avgContactPoint0, avgNormal});
-                prim1->EmitSignal("OnCollision", {prim1, prim0, avgContactPoint1, -avgNormal});
+                // Only build the signal args if someone is actually listening.
+                if (prim0->HasSignalConnections(sOnCollisionSignal))
+                {
+                    prim0->EmitSignal(sOnCollisionSignal, { prim0, prim1, avgContactPoint0, avgNormal });
+                }
+
+                if (prim1->HasSignalConnections(sOnCollisionSignal))
+                {
+                    prim1->EmitSignal(sOnCollisionSignal, { prim1, prim0, avgContactPoint1, -avgNormal });
+                }
             }
 
             if (prim0->AreOverlapsEnabled() && prim1->AreOverlapsEnabled() &&
-                std::find(mCurrentOverlaps.begin(), mCurrentOverlaps.end(), PrimitivePair(prim0, prim1)) == mCurrentOverlaps.end())
+                mCurrentOverlaps.insert({ prim0, prim1 }).second)
             {
-                mCurrentOverlaps.push_back({ prim0, prim1 });
-                mCurrentOverlaps.push_back({ prim1, prim0 });
+                mCurrentOverlaps.insert({ prim1, prim0 });
+                mCurrentOverlapList.push_back({ prim0, prim1 });
+                mCurrentOverlapList.push_back({ prim1, prim0 });
             }
         }
 
-        // Call Begin Overlaps
-        for (auto& pair : mCurrentOverlaps)
+        // Diff the current overlaps against the previous frame's overlaps. The begin/end lists
+        // are gathered before calling any handlers because handlers may remove primitives from
+        // the world, which purges them from mCurrentOverlaps. Walk the lists rather than the sets
+        // so handlers are called in manifold order, and use the sets only for membership.
+        mBeginOverlaps.clear();
+        mEndOverlaps.clear();
+
+        for (const PrimitivePair& pair : mCurrentOverlapList)
         {
-            bool beginOverlap = std::find(mPreviousOverlaps.begin(), mPreviousOverlaps.end(), pair) == mPreviousOverlaps.end();
+            if (mPreviousOverlaps.find(pair) == mPreviousOverlaps.end())
+            {
+                mBeginOverlaps.push_back(pair);
+            }
+        }
 
-            if (beginOverlap)
+        for (const PrimitivePair& pair : mPreviousOverlapList)
+        {
+            if (mCurrentOverlaps.find(pair) == mCurrentOverlaps.end())
+            {
+                mEndOverlaps.push_back(pair);
+            }
+        }
+
+        // Call Begin Overlaps
+        for (const PrimitivePair& pair : mBeginOverlaps)
+        {
+            // Skip overlaps that were purged by an earlier handler this frame.
+            if (mCurrentOverlaps.find(pair) != mCurrentOverlaps.end())
             {
                 pair.mPrimitiveA->BeginOverlap(pair.mPrimitiveA, pair.mPrimitiveB);
-                pair.mPrimitiveA->EmitSignal("BeginOverlap", {pair.mPrimitiveA, pair.mPrimitiveB});
+
+                if (pair.mPrimitiveA->HasSignalConnections(sBeginOverlapSignal))
+                {
+                    pair.mPrimitiveA->EmitSignal(sBeginOverlapSignal, { pair.mPrimitiveA, pair.mPrimitiveB });
+                }
             }
         }
 
         // Call End Overlaps
-        for (auto& pair : mPreviousOverlaps)
+        for (const PrimitivePair& pair : mEndOverlaps)
         {
-            bool endOverlap = std::find(mCurrentOverlaps.begin(), mCurrentOverlaps.end(), pair) == mCurrentOverlaps.end();
+            pair.mPrimitiveA->EndOverlap(pair.mPrimitiveA, pair.mPrimitiveB);
 
-            if (endOverlap)
+            if (pair.mPrimitiveA->HasSignalConnections(sEndOverlapSignal))
             {
-                pair.mPrimitiveA->EndOverlap(pair.mPrimitiveA, pair.mPrimitiveB);
-                pair.mPrimitiveA->EmitSignal("EndOverlap", {pair.mPrimitiveA, pair.mPrimitiveB});
+                pair.mPrimitiveA->EmitSignal(sEndOverlapSignal, { pair.mPrimitiveA, pair.mPrimitiveB });
             }
         }
     }
@@ -1437,25 +2104,7 @@ void World::Update(float deltaTime)
             // until all newly spawned nodes / added nodes have ticked (and maybe start)
             while (sNodesToTick.size() > 0 && tickIteration < kMaxTickIterations)
             {
-                for (uint32_t i = 0; i < sNodesToTick.size(); ++i)
-                {
-                    Node* node = sNodesToTick[i].Get();
-
-                    // Node may have been destroyed or removed from the world
-                    if (node &&
-                        node->GetWorld() == this &&
-                        node->GetLastTickedFrame() != currentFrame)
-                    {
-                        if (gameTickEnabled)
-                        {
-                            node->Tick(deltaTime);
-                        }
-                        else
-                        {
-                            node->EditorTick(deltaTime);
-                        }
-                    }
-                }
+                TickNodes(sNodesToTick, deltaTime, gameTickEnabled);
 
                 tickIteration++;
                 sNodesToTick.clear();
@@ -1494,24 +2143,7 @@ void World::Update(float deltaTime)
         // make sure transforms are updated so that the bullet dynamics world is in sync.
         // But maybe not and we only need to update transforms when getting world pos/rot/scale/transform
         SCOPED_FRAME_STAT("Transforms");
-        if (mRootNode != nullptr)
-        {
-            auto update3dTransform = [](Node* node) -> bool
-            {
-                if (node->IsNode3D())
-                {
-                    Node3D* node3d = (Node3D*)node;
-                    if (node3d->IsTransformDirty())
-                    {
-                        node3d->UpdateTransform(false);
-                    }
-                }
-
-                return true;
-            };
-
-            mRootNode->Traverse(update3dTransform);
-        }
+        UpdateDirtyTransforms();
     }
 }
 
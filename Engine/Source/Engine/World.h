@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <mutex>
 
 #include "Assets/StaticMesh.h"
 #include "Assets/Material.h"
@@ -13,12 +14,16 @@
 #include "Clock.h"
 #include "Line.h"
 #include "EngineTypes.h"
+#include "BoundsTree.h"
 #include "Nodes/3D/Camera3d.h"
 #include "Nodes/3D/DirectionalLight3d.h"
 
 class Node;
 class Audio3D;
 class Particle3D;
+class SkeletalMesh3D;
+class Light3D;
+class PointLight3D;
 
 class World
 {
@@ -59,6 +64,8 @@ public:
     Node* GetNetNode(NetId netId);
     std::vector<Node*> FindNodesWithTag(const char* tag);
     std::vector<Node*> FindNodesWithName(const char* name);
+    void FindNodesWithTag(const char* tag, std::vector<Node*>& outNodes);
+    void FindNodesWithName(const char* name, std::vector<Node*>& outNodes);
     std::vector<Node*> GatherNodes();
     void GatherNodes(std::vector<Node*>& outNodes);
 
@@ -132,7 +139,31 @@ public:
 
     void RegisterNode(Node* node, bool subRoot);
     void UnregisterNode(Node* node, bool subRoot);
+
+    // Name/tag lookups are served from these indices rather than traversing the node tree.
+    void AddToNameIndex(Node* node, const std::string& name);
+    void RemoveFromNameIndex(Node* node, const std::string& name);
+    void AddToTagIndex(Node* node, const std::string& tag);
+    void RemoveFromTagIndex(Node* node, const std::string& tag);
+
     const std::vector<Audio3D*>& GetAudios() const;
+    const std::vector<SkeletalMesh3D*>& GetSkeletalMeshes() const;
+    const std::vector<Particle3D*>& GetParticles() const;
+    uint32_t GetNumWidgets() const;
+
+    void QueueTransformUpdate(Node3D* node);
+
+    // True while the calling thread is running a parallel node Tick() (see Node::IsParallelTickSafe()).
+    static bool IsParallelTickThread();
+    void MarkPrimitiveBoundsDirty(Primitive3D* prim);
+    void UpdatePrimitiveTree();
+    const BoundsTree& GetPrimitiveTree() const;
+
+    // Point lights are kept in their own bounds tree (by radius) so light selection can query by view.
+    void MarkLightBoundsDirty(PointLight3D* light);
+    void UpdateLightTree();
+    const BoundsTree& GetLightTree() const;
+    const std::vector<Light3D*>& GetDirectionalLights() const;
 
     void LoadScene(const char* name, bool instant);
     void QueueRootScene(const char* name);
@@ -199,6 +230,10 @@ public:
 private:
 
     void UpdateLines(float deltaTime);
+    void UpdateDirtyTransforms();
+    void SortNodesByTreeOrder(std::vector<Node*>& nodes, size_t start);
+    void TickNodes(const std::vector<NodePtrWeak>& nodes, float deltaTime, bool gameTickEnabled);
+    void TickNodesParallel(const std::vector<NodePtrWeak>& nodes, float deltaTime);
     void ExtractPersistingNodes();
 
 private:
@@ -210,6 +245,21 @@ private:
     std::vector<Line> mLines;
     std::vector<class Light3D*> mLights;
     std::vector<class Audio3D*> mAudios;
+    std::vector<SkeletalMesh3D*> mSkeletalMeshes;
+    std::vector<Particle3D*> mParticles;
+    uint32_t mNumWidgets = 0;
+    uint32_t mNumParallelTickNodes = 0;
+    BoundsTree mPrimitiveTree;
+    std::vector<Primitive3D*> mDirtyPrimitives;
+    std::vector<Node3D*> mDirtyTransforms;
+    BoundsTree mLightTree;
+    std::vector<PointLight3D*> mDirtyLights;
+    std::vector<Light3D*> mDirectionalLights;
+    std::unordered_map<std::string, std::vector<Node*>> mNameIndex;
+    std::unordered_map<std::string, std::vector<Node*>> mTagIndex;
+    bool mTreeOrderDirty = true; // Set when nodes are added or removed, cleared by renumbering the tree
+    std::mutex mParallelTickMutex;
+    bool mParallelTicking = false;
     std::vector<FadingLight> mFadingLights;
     NodePtr mQueuedRootNode;
     glm::vec4 mAmbientLightColor;
@@ -227,8 +277,12 @@ private:
     btSequentialImpulseConstraintSolver* mSolver = nullptr;
     btDiscreteDynamicsWorld* mDynamicsWorld = nullptr;
     btDiscreteDynamicsWorld* mDefaultDynamicsWorld = nullptr;;
-    std::vector<PrimitivePair> mCurrentOverlaps;
-    std::vector<PrimitivePair> mPreviousOverlaps;
+    std::unordered_set<PrimitivePair, PrimitivePair> mCurrentOverlaps;
+    std::unordered_set<PrimitivePair, PrimitivePair> mPreviousOverlaps;
+    std::vector<PrimitivePair> mCurrentOverlapList; // Same pairs as mCurrentOverlaps, in manifold order
+    std::vector<PrimitivePair> mPreviousOverlapList;
+    std::vector<PrimitivePair> mBeginOverlaps;
+    std::vector<PrimitivePair> mEndOverlaps;
 
 };
 
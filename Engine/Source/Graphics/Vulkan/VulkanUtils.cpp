@@ -899,9 +899,12 @@ void GatherGeometryLightUniformData(GeometryData& outData, Primitive3D* primitiv
         (!material->IsLite() || ((MaterialLite*)material)->GetShadingModel() != ShadingModel::Unlit))
     {
         const std::vector<LightData>& lights = Renderer::Get()->GetLightData();
+
+        // Pick the lights that matter most for this draw: directional lights first, then the local
+        // lights closest to the geometry relative to their radius. Kept sorted by insertion.
         uint32_t lightIndices[MAX_LIGHTS_PER_DRAW] = {};
+        float lightScores[MAX_LIGHTS_PER_DRAW] = {};
 
-        // Don't worry about sorting for now. Just choose the first X overlapping lights.
         for (uint32_t i = 0; i < lights.size() && i < MAX_LIGHTS_PER_FRAME; ++i)
         {
             LightingDomain domain = lights[i].mDomain;
@@ -913,54 +916,56 @@ void GatherGeometryLightUniformData(GeometryData& outData, Primitive3D* primitiv
                 continue;
             }
 
-            bool overlaps = false;
-            if (lights[i].mType == LightType::Directional)
-            {
-                // Global light always overlaps.
-                overlaps = true;
-            }
-            else
+            float score = 0.0f;
+            if (lights[i].mType != LightType::Directional)
             {
-                // If the local light is overlapping the geometry bounds, then just add it to the list.
+                // If the local light is overlapping the geometry bounds, then consider it.
                 float dist2 = glm::distance2(lights[i].mPosition, bounds.mCenter);
 
                 float maxDist = (bounds.mRadius + lights[i].mRadius);
                 float maxDist2 = maxDist * maxDist;
 
-                // Overlap!
-                if (dist2 < maxDist2)
+                if (dist2 >= maxDist2)
                 {
-                    overlaps = true;
+                    continue;
                 }
-            }
 
-            if (overlaps)
+                // 0 = touching the light's center, 1 = barely overlapping
+                score = (maxDist2 > 0.0f) ? (dist2 / maxDist2) : 0.0f;
+            }
+            else
             {
-                // Light indices are packed as bytes into 32-bit uints.
-                // Lights0 contains indices for lights 0 - 3
-                // Lights1 contains indices for lights 4 - 7
-                uint32_t lightNum = numLights;
-                uint32_t& lightIndexInt = (lightNum >= 4) ? outData.mLights1 : outData.mLights0;
-                uint32_t shiftedIdx = 0;
-
-                if (lightNum >= 4)
-                {
-                    shiftedIdx = i << (8 * (lightNum - 4));
-                }
-                else
-                {
-                    shiftedIdx = i << (8 * lightNum);
-                }
+                // Global light always overlaps and always wins.
+                score = -1.0f;
+            }
 
-                lightIndexInt |= shiftedIdx;
+            if (numLights == MAX_LIGHTS_PER_DRAW &&
+                score >= lightScores[MAX_LIGHTS_PER_DRAW - 1])
+            {
+                continue;
+            }
 
-                ++numLights;
+            uint32_t slot = (numLights < MAX_LIGHTS_PER_DRAW) ? numLights++ : (MAX_LIGHTS_PER_DRAW - 1);
 
-                if (numLights >= MAX_LIGHTS_PER_DRAW)
-                {
-                    break;
-                }
+            while (slot > 0 && lightScores[slot - 1] > score)
+            {
+                lightScores[slot] = lightScores[slot - 1];
+                lightIndices[slot] = lightIndices[slot - 1];
+                --slot;
             }
+
+            lightScores[slot] = score;
+            lightIndices[slot] = i;
+        }
+
+        // Light indices are packed as bytes into 32-bit uints.
+        // Lights0 contains indices for lights 0 - 3
+        // Lights1 contains indices for lights 4 - 7
+        for (uint32_t lightNum = 0; lightNum < numLights; ++lightNum)
+        {
+            uint32_t& lightIndexInt = (lightNum >= 4) ? outData.mLights1 : outData.mLights0;
+            uint32_t shift = (lightNum >= 4) ? (8 * (lightNum - 4)) : (8 * lightNum);
+            lightIndexInt |= (lightIndices[lightNum] << shift);
         }
     }
 
@@ -3,7 +3,10 @@
 
 int AssetManager_Lua::RefSweep(lua_State* L)
 {
-    AssetManager::Get()->RefSweep();
+    bool immediate = false;
+    if (!lua_isnone(L, 1)) { immediate = CHECK_BOOLEAN(L, 1); }
+
+    AssetManager::Get()->RefSweep(immediate);
     return 0;
 }
 
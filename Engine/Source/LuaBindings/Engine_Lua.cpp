@@ -3,6 +3,7 @@
 #include "Engine.h"
 #include "Clock.h"
 #include "Utilities.h"
+#include "Profiler.h"
 
 #include "System/System.h"
 
@@ -207,6 +208,51 @@ int Engine_Lua::GarbageCollect(lua_State* L)
     return 0;
 }
 
+int Engine_Lua::GetFrameStat(lua_State* L)
+{
+    const char* name = CHECK_STRING(L, 1);
+
+    float time = 0.0f;
+    float smoothedTime = 0.0f;
+
+    Profiler* profiler = GetProfiler();
+    CpuStat* stat = profiler ? profiler->FindCpuStat(name, false) : nullptr;
+
+    if (stat != nullptr)
+    {
+        time = stat->mTime;
+        smoothedTime = stat->mSmoothedTime;
+    }
+
+    lua_pushnumber(L, time);
+    lua_pushnumber(L, smoothedTime);
+    return 2;
+}
+
+int Engine_Lua::EnableProfileTrace(lua_State* L)
+{
+    bool enable = CHECK_BOOLEAN(L, 1);
+
+    Profiler* profiler = GetProfiler();
+    if (profiler != nullptr)
+    {
+        profiler->EnableTrace(enable);
+    }
+
+    return 0;
+}
+
+int Engine_Lua::WriteProfileTrace(lua_State* L)
+{
+    const char* path = CHECK_STRING(L, 1);
+
+    Profiler* profiler = GetProfiler();
+    bool ret = profiler ? profiler->WriteTrace(path) : false;
+
+    lua_pushboolean(L, ret);
+    return 1;
+}
+
 void Engine_Lua::Bind()
 {
     lua_State* L = GetLua();
@@ -260,6 +306,12 @@ void Engine_Lua::Bind()
 
     REGISTER_TABLE_FUNC(L, tableIdx, GarbageCollect);
 
+    REGISTER_TABLE_FUNC(L, tableIdx, GetFrameStat);
+
+    REGISTER_TABLE_FUNC(L, tableIdx, EnableProfileTrace);
+
+    REGISTER_TABLE_FUNC(L, tableIdx, WriteProfileTrace);
+
     lua_setglobal(L, "Engine");
 
     OCT_ASSERT(lua_gettop(L) == 0);
@@ -29,6 +29,9 @@ struct Engine_Lua
     static int SetTimeDilation(lua_State* L);
     static int GetTimeDilation(lua_State* L);
     static int GarbageCollect(lua_State* L);
+    static int GetFrameStat(lua_State* L);
+    static int EnableProfileTrace(lua_State* L);
+    static int WriteProfileTrace(lua_State* L);
 
     static void Bind();
 };
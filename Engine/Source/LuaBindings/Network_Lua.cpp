@@ -354,6 +354,32 @@ int Network_Lua::EnableReliableReplication(lua_State* L)
     return 0;
 }
 
+int Network_Lua::EnableTransformQuantization(lua_State* L)
+{
+    bool value = CHECK_BOOLEAN(L, 1);
+
+    NetworkManager::Get()->EnableTransformQuantization(value);
+
+    return 0;
+}
+
+int Network_Lua::SetBandwidthBudget(lua_State* L)
+{
+    int32_t value = CHECK_INTEGER(L, 1);
+
+    NetworkManager::Get()->SetBandwidthBudget((uint32_t)glm::max(value, 0));
+
+    return 0;
+}
+
+int Network_Lua::GetBandwidthBudget(lua_State* L)
+{
+    int32_t ret = (int32_t)NetworkManager::Get()->GetBandwidthBudget();
+
+    lua_pushinteger(L, ret);
+    return 1;
+}
+
 int Network_Lua::GetBytesSent(lua_State* L)
 {
     int32_t ret = NetworkManager::Get()->GetBytesSent();
@@ -560,6 +586,12 @@ void Network_Lua::Bind()
 
     REGISTER_TABLE_FUNC(L, tableIdx, EnableReliableReplication);
 
+    REGISTER_TABLE_FUNC(L, tableIdx, EnableTransformQuantization);
+
+    REGISTER_TABLE_FUNC(L, tableIdx, SetBandwidthBudget);
+
+    REGISTER_TABLE_FUNC(L, tableIdx, GetBandwidthBudget);
+
     REGISTER_TABLE_FUNC(L, tableIdx, GetBytesSent);
 
     REGISTER_TABLE_FUNC(L, tableIdx, GetBytesReceived);
@@ -34,6 +34,9 @@ struct Network_Lua
     static int GetNetStatus(lua_State* L);
     static int EnableIncrementalReplication(lua_State* L);
     static int EnableReliableReplication(lua_State* L);
+    static int EnableTransformQuantization(lua_State* L);
+    static int SetBandwidthBudget(lua_State* L);
+    static int GetBandwidthBudget(lua_State* L);
     static int GetBytesSent(lua_State* L);
     static int GetBytesReceived(lua_State* L);
     static int GetUploadRate(lua_State* L);
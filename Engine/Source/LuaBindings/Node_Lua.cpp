@@ -795,26 +795,57 @@ int Node_Lua::GetNodeId(lua_State* L)
     return 1;
 }
 
+// Signals can be passed by the id returned from Node.GetSignalId() so that scripts emitting
+// every frame don't need to look up the name each time.
+static SignalId CheckSignalId(lua_State* L, int arg, bool intern)
+{
+    if (lua_type(L, arg) == LUA_TNUMBER)
+    {
+        return (SignalId)CHECK_INTEGER(L, arg);
+    }
+
+    const char* signalName = CHECK_STRING(L, arg);
+    return intern ? InternSignal(signalName) : FindSignal(signalName);
+}
+
+int Node_Lua::GetSignalId(lua_State* L)
+{
+    const char* signalName = CHECK_STRING(L, 1);
+
+    lua_pushinteger(L, (lua_Integer)InternSignal(signalName));
+    return 1;
+}
+
 int Node_Lua::EmitSignal(lua_State* L)
 {
     Node* node = CHECK_NODE(L, 1);
-    const char* signalName = CHECK_STRING(L, 2);
-
-    std::vector<Datum> args;
-    // How many args is this emit sending? exclude node and signalName args
-    int numArgs = lua_gettop(L) - 2;
+    SignalId signalId = CheckSignalId(L, 2, false);
 
-    if (numArgs > 0)
+    // Don't bother converting the args if nothing is connected.
+    if (node->HasSignalConnections(signalId))
     {
-        args.reserve(numArgs);
-    }
+        // How many args is this emit sending? exclude node and signalName args
+        int numArgs = lua_gettop(L) - 2;
 
-    for (int32_t i = 3; i <= 2 + numArgs; ++i)
-    {
-        args.push_back(LuaObjectToDatum(L, i));
-    }
+        // Keep the common case on the stack.
+        const int32_t kMaxStackArgs = 8;
+        Datum stackArgs[kMaxStackArgs];
+        std::vector<Datum> heapArgs;
+        Datum* args = stackArgs;
 
-    node->EmitSignal(signalName, args);
+        if (numArgs > kMaxStackArgs)
+        {
+            heapArgs.resize(numArgs);
+            args = heapArgs.data();
+        }
+
+        for (int32_t i = 0; i < numArgs; ++i)
+        {
+            LuaObjectToDatum(L, 3 + i, args[i]);
+        }
+
+        node->EmitSignal(signalId, args, (uint32_t)numArgs);
+    }
 
     return 0;
 }
@@ -822,12 +853,12 @@ int Node_Lua::EmitSignal(lua_State* L)
 int Node_Lua::ConnectSignal(lua_State* L)
 {
     Node* node = CHECK_NODE(L, 1);
-    const char* signalName = CHECK_STRING(L, 2);
+    SignalId signalId = CheckSignalId(L, 2, true);
     Node* listener = CHECK_NODE(L, 3);
     CHECK_FUNCTION(L, 4);
     ScriptFunc listenerFunc(L, 4);
 
-    node->ConnectSignal(signalName, listener, listenerFunc);
+    node->ConnectSignal(signalId, listener, listenerFunc);
 
     return 0;
 }
@@ -835,10 +866,10 @@ int Node_Lua::ConnectSignal(lua_State* L)
 int Node_Lua::DisconnectSignal(lua_State* L)
 {
     Node* node = CHECK_NODE(L, 1);
-    const char* signalName = CHECK_STRING(L, 2);
+    SignalId signalId = CheckSignalId(L, 2, false);
     Node* listener = CHECK_NODE(L, 3);
 
-    node->DisconnectSignal(signalName, listener);
+    node->DisconnectSignal(signalId, listener);
 
     return 0;
 }
@@ -1075,6 +1106,26 @@ int Node_Lua::SetAlwaysRelevant(lua_State* L)
     return 0;
 }
 
+int Node_Lua::GetNetPriority(lua_State* L)
+{
+    Node* node = CHECK_NODE(L, 1);
+
+    float ret = node->GetNetPriority();
+
+    lua_pushnumber(L, ret);
+    return 1;
+}
+
+int Node_Lua::SetNetPriority(lua_State* L)
+{
+    Node* node = CHECK_NODE(L, 1);
+    float value = CHECK_NUMBER(L, 2);
+
+    node->SetNetPriority(value);
+
+    return 0;
+}
+
 int Node_Lua::InvokeNetFunc(lua_State* L)
 {
     Node* node = CHECK_NODE(L, 1);
@@ -1225,6 +1276,8 @@ void Node_Lua::Bind()
 
     REGISTER_TABLE_FUNC(L, mtIndex, GetNodeId);
 
+    REGISTER_TABLE_FUNC(L, mtIndex, GetSignalId);
+
     REGISTER_TABLE_FUNC(L, mtIndex, EmitSignal);
 
     REGISTER_TABLE_FUNC(L, mtIndex, ConnectSignal);
@@ -1280,6 +1333,10 @@ void Node_Lua::Bind()
 
     REGISTER_TABLE_FUNC(L, mtIndex, SetAlwaysRelevant);
 
+    REGISTER_TABLE_FUNC(L, mtIndex, GetNetPriority);
+
+    REGISTER_TABLE_FUNC(L, mtIndex, SetNetPriority);
+
     REGISTER_TABLE_FUNC(L, mtIndex, InvokeNetFunc);
 
     REGISTER_TABLE_FUNC(L, mtIndex, CheckType);
@@ -71,6 +71,7 @@ struct Node_Lua
     static int HasStarted(lua_State* L);
 
     static int GetNodeId(lua_State* L);
+    static int GetSignalId(lua_State* L);
     static int EmitSignal(lua_State* L);
     static int ConnectSignal(lua_State* L);
     static int DisconnectSignal(lua_State* L);
@@ -105,6 +106,8 @@ struct Node_Lua
 
     static int IsAlwaysRelevant(lua_State* L);
     static int SetAlwaysRelevant(lua_State* L);
+    static int GetNetPriority(lua_State* L);
+    static int SetNetPriority(lua_State* L);
 
     static int InvokeNetFunc(lua_State* L);
 
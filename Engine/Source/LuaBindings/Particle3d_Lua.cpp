@@ -199,7 +199,7 @@ int Particle3D_Lua::GetParticleData(lua_State* L)
 
     if (index >= 0 && index < int32_t(comp->GetNumParticles()))
     {
-        const Particle& particleData = comp->GetParticles()[index];
+        Particle particleData = comp->GetParticles().Get(uint32_t(index));
         Datum dataTable;
         dataTable.SetColorField("position", (glm::vec4(particleData.mPosition, 0)));
         dataTable.SetColorField("velocity", (glm::vec4(particleData.mVelocity, 0)));
@@ -227,7 +227,7 @@ int Particle3D_Lua::SetParticleData(lua_State* L)
     int32_t startIdx = (index == -1) ? 0 : index;
     int32_t endIdx = (index == -1) ? int32_t(comp->GetNumParticles()) : index;
     const int32_t numParticles = int32_t(comp->GetNumParticles());
-    std::vector<Particle>& particles = comp->GetParticles();
+    ParticleArrays& particles = comp->GetParticles();
 
     bool setPosition = dataTable.HasField("position");
     glm::vec3 position = setPosition ? dataTable.GetColorField("position") : glm::vec3();
@@ -252,28 +252,26 @@ int Particle3D_Lua::SetParticleData(lua_State* L)
 
     for (int32_t i = 0; i < numParticles; ++i)
     {
-        Particle& particleData = particles[i];
-
         if (setPosition)
-            particleData.mPosition = position;
+            particles.mPositions[i] = position;
 
         if (setVelocity)
-            particleData.mVelocity = velocity;
+            particles.mVelocities[i] = velocity;
 
         if (setSize)
-            particleData.mSize = size;
+            particles.mSizes[i] = size;
         
         if (setElapsedTime)
-            particleData.mElapsedTime = elapsedTime;
+            particles.mElapsedTimes[i] = elapsedTime;
 
         if (setLifeTime)
-            particleData.mLifetime = lifeTime;
+            particles.mLifetimes[i] = lifeTime;
 
         if (setRotationSpeed)
-            particleData.mRotationSpeed = rotationSpeed;
+            particles.mRotationSpeeds[i] = rotationSpeed;
 
         if (setRotation)
-            particleData.mRotation = rotation;
+            particles.mRotations[i] = rotation;
     }
 
     return 0;
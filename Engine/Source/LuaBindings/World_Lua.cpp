@@ -161,16 +161,16 @@ int World_Lua::FindNodesWithTag(lua_State* L)
     World* world = CHECK_WORLD(L, 1);
     const char* tag = CHECK_STRING(L, 2);
 
-    std::vector<Node*> nodes = world->FindNodesWithTag(tag);
+    std::vector<Node*> nodes;
+    world->FindNodesWithTag(tag, nodes);
 
-    lua_newtable(L);
+    lua_createtable(L, (int)nodes.size(), 0);
     int arrayIdx = lua_gettop(L);
 
     for (uint32_t i = 0; i < nodes.size(); ++i)
     {
-        lua_pushinteger(L, (int)i + 1);
         Node_Lua::Create(L, nodes[i]);
-        lua_settable(L, arrayIdx);
+        lua_rawseti(L, arrayIdx, (int)i + 1);
     }
 
     return 1;
@@ -181,16 +181,16 @@ int World_Lua::FindNodesWithName(lua_State* L)
     World* world = CHECK_WORLD(L, 1);
     const char* name = CHECK_STRING(L, 2);
 
-    std::vector<Node*> nodes = world->FindNodesWithName(name);
+    std::vector<Node*> nodes;
+    world->FindNodesWithName(name, nodes);
 
-    lua_newtable(L);
+    lua_createtable(L, (int)nodes.size(), 0);
     int arrayIdx = lua_gettop(L);
 
     for (uint32_t i = 0; i < nodes.size(); ++i)
     {
-        lua_pushinteger(L, (int)i + 1);
         Node_Lua::Create(L, nodes[i]);
-        lua_settable(L, arrayIdx);
+        lua_rawseti(L, arrayIdx, (int)i + 1);
     }
 
     return 1;
@@ -178,6 +178,25 @@ void SYS_ReleaseFileData(char* data)
     }
 }
 
+bool SYS_MapFile(const char* path, bool isAsset, MappedFile& outFile)
+{
+    // No memory mapping here, so the "mapping" is just the whole file in memory.
+    outFile = MappedFile();
+
+    uint32_t size = 0;
+    SYS_AcquireFileData(path, isAsset, 0, outFile.mBuffer, size);
+
+    outFile.mData = outFile.mBuffer;
+    outFile.mSize = size;
+    return (outFile.mData != nullptr);
+}
+
+void SYS_UnmapFile(MappedFile& file)
+{
+    SYS_ReleaseFileData(file.mBuffer);
+    file = MappedFile();
+}
+
 std::string SYS_GetCurrentDirectoryPath()
 {
     char path[MAX_PATH_SIZE] = {};
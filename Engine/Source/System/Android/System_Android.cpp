@@ -14,6 +14,10 @@
 #include <string>
 #include <assert.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <android/input.h>
 #include <android/window.h>
@@ -518,6 +522,79 @@ void SYS_ReleaseFileData(char* data)
     }
 }
 
+bool SYS_MapFile(const char* path, bool isAsset, MappedFile& outFile)
+{
+    outFile = MappedFile();
+
+    if (isAsset)
+    {
+        // Uncompressed APK assets are memory mapped by the asset manager, so the buffer is a direct view.
+        AAssetManager* assetManager = GetEngineState()->mSystem.mState->activity->assetManager;
+        outFile.mAsset = AAssetManager_open(assetManager, path, AASSET_MODE_BUFFER);
+
+        if (outFile.mAsset != nullptr)
+        {
+            outFile.mData = (const char*)AAsset_getBuffer(outFile.mAsset);
+            outFile.mSize = uint32_t(AAsset_getLength(outFile.mAsset));
+
+            if (outFile.mData == nullptr)
+            {
+                AAsset_close(outFile.mAsset);
+                outFile.mAsset = nullptr;
+            }
+        }
+
+        if (outFile.mData == nullptr)
+        {
+            LogError("Could not map asset: %s", path);
+        }
+
+        return (outFile.mData != nullptr);
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        LogError("Failed to open file: %s", path);
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 &&
+        fileStat.st_size > 0)
+    {
+        void* data = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data != MAP_FAILED)
+        {
+            outFile.mData = (const char*)data;
+            outFile.mSize = uint32_t(fileStat.st_size);
+        }
+        else
+        {
+            LogError("Failed to map file: %s", path);
+        }
+    }
+
+    close(fd);
+
+    return (outFile.mData != nullptr);
+}
+
+void SYS_UnmapFile(MappedFile& file)
+{
+    if (file.mAsset != nullptr)
+    {
+        AAsset_close(file.mAsset);
+    }
+    else if (file.mData != nullptr)
+    {
+        munmap((void*)file.mData, file.mSize);
+    }
+
+    file = MappedFile();
+}
+
 std::string SYS_GetCurrentDirectoryPath()
 {
     char path[MAX_PATH_SIZE] = {};
@@ -19,6 +19,9 @@
 #include <signal.h>
 #include <limits.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #if EDITOR
 #include "imgui.h"
@@ -582,6 +585,50 @@ void SYS_ReleaseFileData(char* data)
     }
 }
 
+bool SYS_MapFile(const char* path, bool isAsset, MappedFile& outFile)
+{
+    outFile = MappedFile();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        LogError("Failed to open file: %s", path);
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 &&
+        fileStat.st_size > 0)
+    {
+        void* data = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data != MAP_FAILED)
+        {
+            outFile.mData = (const char*)data;
+            outFile.mSize = uint32_t(fileStat.st_size);
+        }
+        else
+        {
+            LogError("Failed to map file: %s", path);
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+
+    return (outFile.mData != nullptr);
+}
+
+void SYS_UnmapFile(MappedFile& file)
+{
+    if (file.mData != nullptr)
+    {
+        munmap((void*)file.mData, file.mSize);
+    }
+
+    file = MappedFile();
+}
+
 std::string SYS_GetOctavePath()
 {
     std::string octaveDirectory = SYS_GetCurrentDirectoryPath();
@@ -16,6 +16,8 @@ void SYS_Update();
 bool SYS_DoesFileExist(const char* path, bool isAsset);
 void SYS_AcquireFileData(const char* path, bool isAsset, int32_t maxSize, char*& outData, uint32_t& outSize);
 void SYS_ReleaseFileData(char* data);
+bool SYS_MapFile(const char* path, bool isAsset, MappedFile& outFile);
+void SYS_UnmapFile(MappedFile& file);
 std::string SYS_GetExecutablePath();
 std::string SYS_GetOctavePath();
 std::string SYS_GetCurrentDirectoryPath();
@@ -90,6 +90,20 @@ struct DirEntry
 #endif
 };
 
+// A read-only view of a whole file. Where the platform supports it the view is a
+// memory mapping, otherwise the file contents are read into a heap buffer.
+struct MappedFile
+{
+    const char* mData = nullptr;
+    uint32_t mSize = 0;
+
+#if PLATFORM_ANDROID
+    AAsset* mAsset = nullptr;
+#elif (PLATFORM_DOLPHIN || PLATFORM_3DS)
+    char* mBuffer = nullptr;
+#endif
+};
+
 struct SystemState
 {
 #if PLATFORM_WINDOWS
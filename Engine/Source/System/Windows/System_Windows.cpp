@@ -424,6 +424,55 @@ void SYS_ReleaseFileData(char* data)
         free(data);
     }
 }
+
+bool SYS_MapFile(const char* path, bool isAsset, MappedFile& outFile)
+{
+    outFile = MappedFile();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogError("Failed to open file: %s", path);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (GetFileSizeEx(file, &fileSize) &&
+        fileSize.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping != nullptr)
+        {
+            outFile.mData = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            outFile.mSize = uint32_t(fileSize.QuadPart);
+
+            // The view keeps the mapping alive, so neither handle is needed after this.
+            CloseHandle(mapping);
+        }
+
+        if (outFile.mData == nullptr)
+        {
+            outFile.mSize = 0;
+            LogError("Failed to map file: %s", path);
+        }
+    }
+
+    CloseHandle(file);
+
+    return (outFile.mData != nullptr);
+}
+
+void SYS_UnmapFile(MappedFile& file)
+{
+    if (file.mData != nullptr)
+    {
+        UnmapViewOfFile(file.mData);
+    }
+
+    file = MappedFile();
+}
+
 std::string SYS_GetOctavePath()
 {
     std::string octaveDirectory = SYS_GetCurrentDirectoryPath();